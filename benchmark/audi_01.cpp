@@ -6,12 +6,14 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstdlib>
+#include <exception>
 #include <iostream>
 
 #include <obake/polynomials/packed_monomial.hpp>
 #include <obake/polynomials/polynomial.hpp>
 
-#include "simple_timer.hpp"
+#include "harness.hpp"
 
 using namespace obake;
 using namespace obake_benchmark;
@@ -40,28 +42,33 @@ auto truncated_pow(const T &x, unsigned n, unsigned limit)
     return retval;
 }
 
-int main()
+int main(int argc, char **argv)
 {
-    using p_type = polynomial<packed_monomial<unsigned long long>, double>;
+    try {
+        harness h("audi_01", parse_harness_options(argc, argv));
 
-    auto polys = make_polynomials<p_type>("x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10");
+        using p_type = polynomial<packed_monomial<unsigned long long>, double>;
 
-    for (auto &p : polys) {
-        p += 1;
-    }
+        auto polys = make_polynomials<p_type>("x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10");
 
-    const auto &[a1, a2, a3, a4, a5, a6, a7, a8, a9, a10] = polys;
+        for (auto &p : polys) {
+            p += 1;
+        }
 
-    auto f = truncated_pow(1 + a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9 + a10, 10, 10);
-    auto g = truncated_pow(1 - a1 - a2 - a3 - a4 - a5 - a6 - a7 - a8 - a9 - a10, 10, 10);
+        const auto &[a1, a2, a3, a4, a5, a6, a7, a8, a9, a10] = polys;
 
-    p_type h;
-    {
-        simple_timer t;
-        h = truncated_mul(f, g, 10);
-    }
+        auto f = truncated_pow(1 + a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9 + a10, 10, 10);
+        auto g = truncated_pow(1 - a1 - a2 - a3 - a4 - a5 - a6 - a7 - a8 - a9 - a10, 10, 10);
+
+        const auto ret = h.run("truncated_mul", [&f, &g]() { return truncated_mul(f, g, 10); });
 
-    std::cout << h.table_stats() << '\n';
+        h.info(ret.table_stats());
+
+        h.report();
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
 
-    return 0;
+    return EXIT_SUCCESS;
 }
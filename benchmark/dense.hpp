@@ -9,17 +9,15 @@
 #ifndef OBAKE_BENCHMARK_DENSE_HPP
 #define OBAKE_BENCHMARK_DENSE_HPP
 
-#include <iostream>
-
 #include <obake/polynomials/polynomial.hpp>
 
-#include "simple_timer.hpp"
+#include "harness.hpp"
 
 namespace obake_benchmark
 {
 
 template <typename M, typename C>
-inline auto dense_benchmark_4_vars(int n)
+inline auto dense_benchmark_4_vars(harness &h, int n)
 {
     using namespace obake;
 
@@ -32,19 +30,15 @@ inline auto dense_benchmark_4_vars(int n)
     }
     auto g = f + 1;
 
-    polynomial<M, C> ret;
-    {
-        simple_timer t;
-        ret = f * g;
-    }
+    auto ret = h.run("mul", [&f, &g]() { return f * g; });
 
-    std::cout << ret.table_stats() << '\n';
+    h.info(ret.table_stats());
 
     return ret;
 }
 
 template <typename M, typename C>
-inline auto dense_benchmark_5_vars(int n)
+inline auto dense_benchmark_5_vars(harness &h, int n)
 {
     using namespace obake;
 
@@ -57,13 +51,9 @@ inline auto dense_benchmark_5_vars(int n)
     }
     auto g = f + 1;
 
-    polynomial<M, C> ret;
-    {
-        simple_timer t;
-        ret = f * g;
-    }
+    auto ret = h.run("mul", [&f, &g]() { return f * g; });
 
-    std::cout << ret.table_stats() << '\n';
+    h.info(ret.table_stats());
 
     return ret;
 }
@@ -6,16 +6,32 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+
 #include <obake/polynomials/packed_monomial.hpp>
 
 #include <mp++/integer.hpp>
 
 #include "dense.hpp"
+#include "harness.hpp"
 
 using namespace obake;
 using namespace obake_benchmark;
 
-int main()
+int main(int argc, char **argv)
 {
-    dense_benchmark_5_vars<packed_monomial<unsigned long>, mppp::integer<1>>(14);
+    try {
+        harness h("dense_02", parse_harness_options(argc, argv, 14));
+
+        dense_benchmark_5_vars<packed_monomial<unsigned long>, mppp::integer<1>>(h, h.power());
+
+        h.report();
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
 }
@@ -10,16 +10,13 @@
 #include <cstdlib>
 #include <exception>
 #include <iostream>
-#include <optional>
-
-#include <tbb/global_control.h>
 
 #include <obake/polynomials/packed_monomial.hpp>
 
 #include <mp++/integer.hpp>
 
 #include "dense.hpp"
-#include "sparse_dense_options.hpp"
+#include "harness.hpp"
 
 using namespace obake;
 using namespace obake_benchmark;
@@ -30,14 +27,11 @@ using namespace obake_benchmark;
 int main(int argc, char **argv)
 {
     try {
-        const auto [nthreads, power] = sparse_dense_options(argc, argv, 30);
+        harness h("dense_4_vars", parse_harness_options(argc, argv, 30));
 
-        std::optional<tbb::global_control> c;
-        if (nthreads > 0) {
-            c.emplace(tbb::global_control::max_allowed_parallelism, nthreads);
-        }
+        dense_benchmark_4_vars<packed_monomial<std::uint64_t>, mppp::integer<2>>(h, h.power());
 
-        dense_benchmark_4_vars<packed_monomial<std::uint64_t>, mppp::integer<2>>(power);
+        h.report();
     } catch (const std::exception &e) {
         std::cerr << "Error: " << e.what() << '\n';
         return EXIT_FAILURE;
@@ -0,0 +1,335 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <locale>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#if __has_include(<tbb/version.h>)
+#include <tbb/version.h>
+#else
+#include <tbb/tbb_stddef.h>
+#endif
+
+#include <obake/config.hpp>
+
+#include "harness.hpp"
+
+namespace po = boost::program_options;
+
+namespace obake_benchmark
+{
+
+harness_options parse_harness_options(int argc, char **argv, std::optional<int> default_power)
+{
+    harness_options retval;
+
+    po::options_description desc("Allowed options");
+
+    desc.add_options()("help", "produce help message")(
+        "nthreads", po::value<std::vector<int>>(&retval.nthreads)->multitoken()->default_value({0}, "0"),
+        "number of threads (0 will use all cores), multiple values will run a sweep")(
+        "warmup", po::value<unsigned>(&retval.warmup)->default_value(1u), "number of untimed warm-up runs")(
+        "reps", po::value<unsigned>(&retval.reps)->default_value(5u), "number of timed repetitions")(
+        "format", po::value<std::string>(&retval.format)->default_value("text"),
+        "output format (text, json or csv)")("output", po::value<std::string>(&retval.output),
+                                             "output file (the standard output will be used if not provided)");
+    if (default_power) {
+        desc.add_options()("power", po::value<int>(&retval.power)->default_value(*default_power),
+                           "power of the exponentiation");
+    }
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << "\n";
+        std::exit(EXIT_SUCCESS);
+    }
+
+    for (auto nt : retval.nthreads) {
+        if (nt < 0) {
+            throw std::invalid_argument("The number of threads must be non-negative, but it is "
+                                        + std::to_string(nt) + " instead");
+        }
+    }
+
+    if (retval.power < 0) {
+        throw std::invalid_argument("The exponent must be non-negative, but it is " + std::to_string(retval.power)
+                                    + " instead");
+    }
+
+    if (retval.reps == 0u) {
+        throw std::invalid_argument("The number of repetitions must be positive");
+    }
+
+    if (retval.format != "text" && retval.format != "json" && retval.format != "csv") {
+        throw std::invalid_argument("The output format must be one of 'text', 'json' or 'csv', but it is '"
+                                    + retval.format + "' instead");
+    }
+
+    return retval;
+}
+
+void harness_compute_stats(harness_result &r)
+{
+    if (r.times.empty()) {
+        return;
+    }
+
+    auto sorted = r.times;
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto n = sorted.size();
+    r.min = sorted.front();
+    r.max = sorted.back();
+    r.median = n % 2u == 1u ? sorted[n / 2u] : (sorted[n / 2u - 1u] + sorted[n / 2u]) / 2;
+    r.mean = std::accumulate(sorted.begin(), sorted.end(), 0.) / static_cast<double>(n);
+
+    // NOTE: sample standard deviation.
+    double acc = 0;
+    for (auto t : sorted) {
+        acc += (t - r.mean) * (t - r.mean);
+    }
+    r.stddev = n > 1u ? std::sqrt(acc / static_cast<double>(n - 1u)) : 0.;
+}
+
+namespace
+{
+
+// The metadata of a run.
+struct harness_metadata {
+    std::string date;
+    std::string obake_version;
+    std::string tbb_version;
+    std::string build_type;
+    std::string compiler;
+    std::string cpu;
+    unsigned hardware_threads;
+};
+
+harness_metadata get_metadata()
+{
+    harness_metadata retval;
+
+    // Date and time, UTC.
+    const auto now = std::time(nullptr);
+    char buffer[64];
+    if (const auto tm = std::gmtime(&now);
+        tm != nullptr && std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", tm) != 0u) {
+        retval.date = buffer;
+    }
+
+    retval.obake_version = OBAKE_VERSION_STRING;
+    retval.tbb_version = std::to_string(TBB_VERSION_MAJOR) + "." + std::to_string(TBB_VERSION_MINOR);
+
+#if defined(OBAKE_BENCHMARK_BUILD_TYPE)
+    retval.build_type = OBAKE_BENCHMARK_BUILD_TYPE;
+#endif
+    if (retval.build_type.empty()) {
+#if defined(NDEBUG)
+        retval.build_type = "NDEBUG";
+#else
+        retval.build_type = "Debug";
+#endif
+    }
+
+#if defined(__clang__)
+    retval.compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    retval.compiler = std::string("GCC ") + __VERSION__;
+#elif defined(_MSC_VER)
+    retval.compiler = "MSVC " + std::to_string(_MSC_VER);
+#else
+    retval.compiler = "unknown";
+#endif
+
+    // NOTE: the CPU model is currently detected only on Linux.
+    retval.cpu = "unknown";
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    for (std::string line; std::getline(cpuinfo, line);) {
+        if (line.rfind("model name", 0) == 0u) {
+            const auto pos = line.find(':');
+            if (pos != std::string::npos && pos + 2u <= line.size()) {
+                retval.cpu = line.substr(pos + 2u);
+            }
+            break;
+        }
+    }
+
+    retval.hardware_threads = std::thread::hardware_concurrency();
+
+    return retval;
+}
+
+// Escape s for output as a JSON string.
+std::string json_escape(const std::string &s)
+{
+    std::string retval;
+
+    for (auto c : s) {
+        switch (c) {
+            case '"':
+                retval += "\\\"";
+                break;
+            case '\\':
+                retval += "\\\\";
+                break;
+            case '\n':
+                retval += "\\n";
+                break;
+            default:
+                retval += c;
+        }
+    }
+
+    return retval;
+}
+
+// Quote s for output as a CSV field.
+std::string csv_quote(const std::string &s)
+{
+    std::string retval = "\"";
+
+    for (auto c : s) {
+        if (c == '"') {
+            retval += '"';
+        }
+        retval += c;
+    }
+
+    return retval + '"';
+}
+
+} // namespace
+
+harness::harness(std::string name, harness_options opts) : m_name(std::move(name)), m_opts(std::move(opts))
+{
+    if (m_opts.nthreads.empty()) {
+        m_opts.nthreads.push_back(0);
+    }
+}
+
+void harness::add_result(harness_result &&r)
+{
+    harness_compute_stats(r);
+
+    if (m_opts.format == "text") {
+        // In text mode, print the results as they become available.
+        std::cout << r.name << " [" << r.nthreads << " thread(s)]: median " << r.median << "ms, min " << r.min
+                  << "ms, stddev " << r.stddev << "ms\n";
+    }
+
+    m_results.push_back(std::move(r));
+}
+
+void harness::info(const std::string &s) const
+{
+    if (m_opts.format == "text") {
+        std::cout << s << '\n';
+    }
+}
+
+void harness::report() const
+{
+    std::ofstream ofile;
+    if (!m_opts.output.empty()) {
+        ofile.open(m_opts.output);
+        if (!ofile.is_open()) {
+            throw std::runtime_error("Cannot open the file '" + m_opts.output + "' for writing");
+        }
+    }
+    std::ostream &os = m_opts.output.empty() ? std::cout : ofile;
+
+    std::ostringstream oss;
+    oss.imbue(std::locale::classic());
+
+    const auto md = get_metadata();
+
+    if (m_opts.format == "json") {
+        oss.precision(std::numeric_limits<double>::max_digits10);
+
+        oss << "{\n  \"benchmark\": \"" << json_escape(m_name) << "\",\n";
+        oss << "  \"metadata\": {\"date\": \"" << md.date << "\", \"obake_version\": \""
+            << json_escape(md.obake_version) << "\", \"tbb_version\": \"" << md.tbb_version
+            << "\", \"build_type\": \"" << json_escape(md.build_type) << "\", \"compiler\": \""
+            << json_escape(md.compiler) << "\", \"cpu\": \"" << json_escape(md.cpu)
+            << "\", \"hardware_threads\": " << md.hardware_threads << ", \"warmup\": " << m_opts.warmup
+            << ", \"reps\": " << m_opts.reps << "},\n";
+        oss << "  \"results\": [";
+        for (decltype(m_results.size()) i = 0; i < m_results.size(); ++i) {
+            const auto &r = m_results[i];
+            oss << (i == 0u ? "\n" : ",\n") << "    {\"case\": \"" << json_escape(r.name)
+                << "\", \"nthreads\": " << r.nthreads << ", \"min_ms\": " << r.min << ", \"median_ms\": " << r.median
+                << ", \"mean_ms\": " << r.mean << ", \"max_ms\": " << r.max << ", \"stddev_ms\": " << r.stddev
+                << ", \"times_ms\": [";
+            for (decltype(r.times.size()) j = 0; j < r.times.size(); ++j) {
+                oss << (j == 0u ? "" : ", ") << r.times[j];
+            }
+            oss << "]}";
+        }
+        oss << "\n  ]\n}\n";
+    } else if (m_opts.format == "csv") {
+        oss.precision(std::numeric_limits<double>::max_digits10);
+
+        oss << "benchmark,case,nthreads,reps,min_ms,median_ms,mean_ms,max_ms,stddev_ms,date,obake_version,"
+               "tbb_version,build_type,compiler,cpu,hardware_threads\n";
+        for (const auto &r : m_results) {
+            oss << csv_quote(m_name) << ',' << csv_quote(r.name) << ',' << r.nthreads << ',' << r.times.size() << ','
+                << r.min << ',' << r.median << ',' << r.mean << ',' << r.max << ',' << r.stddev << ','
+                << csv_quote(md.date) << ',' << csv_quote(md.obake_version) << ',' << csv_quote(md.tbb_version)
+                << ',' << csv_quote(md.build_type) << ',' << csv_quote(md.compiler) << ',' << csv_quote(md.cpu)
+                << ',' << md.hardware_threads << '\n';
+        }
+    } else {
+        oss << std::fixed << std::setprecision(3);
+
+        oss << "\nBenchmark: " << m_name << '\n';
+        oss << "obake " << md.obake_version << ", TBB " << md.tbb_version << ", " << md.build_type << " build, "
+            << md.compiler << '\n';
+        oss << "CPU: " << md.cpu << " (" << md.hardware_threads << " hardware threads)\n";
+        oss << "Warm-up runs: " << m_opts.warmup << ", repetitions: " << m_opts.reps << "\n\n";
+
+        oss << std::left << std::setw(24) << "case" << std::right << std::setw(10) << "nthreads" << std::setw(14)
+            << "median (ms)" << std::setw(14) << "min (ms)" << std::setw(14) << "mean (ms)" << std::setw(14)
+            << "stddev (ms)" << '\n';
+        for (const auto &r : m_results) {
+            oss << std::left << std::setw(24) << r.name << std::right << std::setw(10) << r.nthreads << std::setw(14)
+                << r.median << std::setw(14) << r.min << std::setw(14) << r.mean << std::setw(14) << r.stddev
+                << '\n';
+        }
+    }
+
+    os << oss.str();
+    os.flush();
+
+    if (!os) {
+        throw std::runtime_error("An error occurred while writing the report of the benchmark '" + m_name + "'");
+    }
+}
+
+} // namespace obake_benchmark
@@ -0,0 +1,136 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OBAKE_BENCHMARK_HARNESS_HPP
+#define OBAKE_BENCHMARK_HARNESS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <tbb/global_control.h>
+
+namespace obake_benchmark
+{
+
+// The command-line options of a benchmark.
+struct harness_options {
+    // The thread counts to sweep over (0 will use all cores).
+    std::vector<int> nthreads;
+    // The power of the exponentiation, for the benchmarks
+    // which accept it.
+    int power = 0;
+    // Number of untimed warm-up runs and of timed repetitions.
+    unsigned warmup = 0;
+    unsigned reps = 0;
+    // Output format ("text", "json" or "csv") and output
+    // file (empty for the standard output).
+    std::string format;
+    std::string output;
+};
+
+// Parse the command-line options. If default_power is provided,
+// the benchmark will accept the --power option.
+harness_options parse_harness_options(int, char **, std::optional<int> = std::nullopt);
+
+// The timings of a benchmark case for a given number of threads.
+// All times are in milliseconds.
+struct harness_result {
+    std::string name;
+    int nthreads = 0;
+    std::vector<double> times;
+    double min = 0;
+    double median = 0;
+    double mean = 0;
+    double max = 0;
+    double stddev = 0;
+};
+
+// Compute the statistics of the timings in r.
+void harness_compute_stats(harness_result &);
+
+// The benchmark harness. Each case is run, for every thread
+// count in the sweep, a number of untimed warm-up times followed
+// by a number of timed repetitions. The report is then
+// emitted in the requested format.
+class harness
+{
+public:
+    explicit harness(std::string, harness_options);
+
+    const harness_options &options() const
+    {
+        return m_opts;
+    }
+    int power() const
+    {
+        return m_opts.power;
+    }
+
+    // Run the case name, timing the invocations of f().
+    // The result of the last invocation is returned.
+    // NOTE: the results of the previous invocations are
+    // destroyed before the start of the next timing.
+    template <typename F>
+    auto run(const std::string &name, F &&f)
+    {
+        using ret_t = std::remove_cv_t<std::remove_reference_t<decltype(f())>>;
+
+        std::optional<ret_t> last;
+
+        for (auto nt : m_opts.nthreads) {
+            std::optional<tbb::global_control> c;
+            if (nt > 0) {
+                c.emplace(tbb::global_control::max_allowed_parallelism, static_cast<std::size_t>(nt));
+            }
+
+            harness_result res;
+            res.name = name;
+            res.nthreads = static_cast<int>(
+                tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
+
+            for (unsigned i = 0; i < m_opts.warmup + m_opts.reps; ++i) {
+                last.reset();
+
+                const auto start = std::chrono::steady_clock::now();
+                last.emplace(f());
+                const auto elapsed
+                    = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+                if (i >= m_opts.warmup) {
+                    res.times.push_back(elapsed);
+                }
+            }
+
+            add_result(std::move(res));
+        }
+
+        return std::move(*last);
+    }
+
+    // Print informative output (only in text format).
+    void info(const std::string &) const;
+
+    // Emit the report.
+    void report() const;
+
+private:
+    void add_result(harness_result &&);
+
+    std::string m_name;
+    harness_options m_opts;
+    std::vector<harness_result> m_results;
+};
+
+} // namespace obake_benchmark
+
+#endif
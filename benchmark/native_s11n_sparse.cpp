@@ -0,0 +1,100 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include <mp++/integer.hpp>
+
+#include <obake/native_s11n.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+
+#include "harness.hpp"
+#include "sparse.hpp"
+
+using namespace obake;
+using namespace obake_benchmark;
+
+// Compare size and speed of the Boost binary archive
+// and of the native serialisation format (plain and
+// compressed) on the result of the sparse benchmark.
+int main(int argc, char **argv)
+{
+    try {
+        harness h("native_s11n_sparse", parse_harness_options(argc, argv, 12));
+
+        using poly_t = polynomial<packed_monomial<std::uint64_t>, mppp::integer<2>>;
+
+        const auto p = sparse_benchmark<packed_monomial<std::uint64_t>, mppp::integer<2>>(h, h.power());
+
+        // NOTE: the load cases rewind the stream produced by the
+        // save cases, so that no copy of the data is timed.
+
+        // Boost binary archive.
+        {
+            auto ss = h.run("boost_save", [&p]() {
+                std::stringstream retval;
+                boost::archive::binary_oarchive oa(retval);
+                oa << p;
+                return retval;
+            });
+            h.info("Boost archive, size: " + std::to_string(ss.str().size()) + " bytes");
+
+            const auto tmp = h.run("boost_load", [&ss]() {
+                ss.clear();
+                ss.seekg(0);
+                poly_t retval;
+                boost::archive::binary_iarchive ia(ss);
+                ia >> retval;
+                return retval;
+            });
+            if (tmp != p) {
+                throw std::runtime_error("Boost archive round trip failed");
+            }
+        }
+
+        // Native format.
+        for (auto mode : {native_s11n_mode::plain, native_s11n_mode::compressed}) {
+            const std::string name = mode == native_s11n_mode::plain ? "native_plain" : "native_compressed";
+
+            auto ss = h.run(name + "_save", [&p, mode]() {
+                std::stringstream retval;
+                native_save(retval, p, mode);
+                return retval;
+            });
+            h.info(name + ", size: " + std::to_string(ss.str().size()) + " bytes");
+
+            const auto tmp = h.run(name + "_load", [&ss]() {
+                ss.clear();
+                ss.seekg(0);
+                poly_t retval;
+                native_load(ss, retval);
+                return retval;
+            });
+            if (tmp != p) {
+                throw std::runtime_error("Native round trip failed");
+            }
+        }
+
+        h.report();
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -6,12 +6,14 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstdlib>
+#include <exception>
 #include <iostream>
 
 #include <obake/polynomials/packed_monomial.hpp>
 #include <obake/polynomials/polynomial.hpp>
 
-#include "simple_timer.hpp"
+#include "harness.hpp"
 
 using namespace obake;
 using namespace obake_benchmark;
@@ -19,25 +21,34 @@ using namespace obake_benchmark;
 // Test taken from:
 // http://groups.google.com/group/sage-devel/browse_thread/thread/f5b976c979a3b784/1263afcc6f9d09da
 // Meant to test sparse multiplication where series have very different sizes.
-int main()
+int main(int argc, char **argv)
 {
-    using p_type = polynomial<packed_monomial<unsigned long long>, double>;
+    try {
+        harness h("rectangular_01", parse_harness_options(argc, argv));
 
-    auto [x, y, z] = make_polynomials<p_type>("x", "y", "z");
+        using p_type = polynomial<packed_monomial<unsigned long long>, double>;
 
-    auto f = x * y * y * y * z * z + x * x * y * y * z + x * y * y * y * z + x * y * y * z * z + y * y * y * z * z
-             + y * y * y * z + 2 * y * y * z * z + 2 * x * y * z + y * y * z + y * z * z + y * y + 2 * y * z + z;
+        auto [x, y, z] = make_polynomials<p_type>("x", "y", "z");
 
-    p_type curr(1);
+        auto f = x * y * y * y * z * z + x * x * y * y * z + x * y * y * y * z + x * y * y * z * z
+                 + y * y * y * z * z + y * y * y * z + 2 * y * y * z * z + 2 * x * y * z + y * y * z + y * z * z
+                 + y * y + 2 * y * z + z;
 
-    {
-        simple_timer t;
-        for (auto i = 1; i <= 70; ++i) {
-            curr *= f;
-        }
-    }
+        const auto curr = h.run("mul", [&f]() {
+            p_type retval(1);
+            for (auto i = 1; i <= 70; ++i) {
+                retval *= f;
+            }
+            return retval;
+        });
+
+        h.info(curr.table_stats());
 
-    std::cout << curr.table_stats() << '\n';
+        h.report();
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
 
-    return 0;
+    return EXIT_SUCCESS;
 }
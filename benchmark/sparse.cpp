@@ -10,16 +10,13 @@
 #include <cstdlib>
 #include <exception>
 #include <iostream>
-#include <optional>
-
-#include <tbb/global_control.h>
 
 #include <mp++/integer.hpp>
 
 #include <obake/polynomials/packed_monomial.hpp>
 
+#include "harness.hpp"
 #include "sparse.hpp"
-#include "sparse_dense_options.hpp"
 
 using namespace obake;
 using namespace obake_benchmark;
@@ -33,14 +30,11 @@ using namespace obake_benchmark;
 int main(int argc, char **argv)
 {
     try {
-        const auto [nthreads, power] = sparse_dense_options(argc, argv, 12);
+        harness h("sparse", parse_harness_options(argc, argv, 12));
 
-        std::optional<tbb::global_control> c;
-        if (nthreads > 0) {
-            c.emplace(tbb::global_control::max_allowed_parallelism, nthreads);
-        }
+        sparse_benchmark<packed_monomial<std::uint64_t>, mppp::integer<2>>(h, h.power());
 
-        sparse_benchmark<packed_monomial<std::uint64_t>, mppp::integer<2>>(power);
+        h.report();
     } catch (const std::exception &e) {
         std::cerr << "Error: " << e.what() << '\n';
         return EXIT_FAILURE;
@@ -9,17 +9,15 @@
 #ifndef OBAKE_BENCHMARK_SPARSE_HPP
 #define OBAKE_BENCHMARK_SPARSE_HPP
 
-#include <iostream>
-
 #include <obake/polynomials/polynomial.hpp>
 
-#include "simple_timer.hpp"
+#include "harness.hpp"
 
 namespace obake_benchmark
 {
 
 template <typename M, typename C>
-inline auto sparse_benchmark(int n)
+inline auto sparse_benchmark(harness &h, int n)
 {
     using namespace obake;
 
@@ -35,13 +33,9 @@ inline auto sparse_benchmark(int n)
         g *= tmp_g;
     }
 
-    polynomial<M, C> ret;
-    {
-        simple_timer t;
-        ret = f * g;
-    }
+    auto ret = h.run("mul", [&f, &g]() { return f * g; });
 
-    std::cout << ret.table_stats() << '\n';
+    h.info(ret.table_stats());
 
     return ret;
 }
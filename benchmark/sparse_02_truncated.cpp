@@ -7,6 +7,7 @@
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <cstdint>
+#include <cstdlib>
 #include <exception>
 #include <iostream>
 
@@ -15,38 +16,39 @@
 #include <obake/polynomials/packed_monomial.hpp>
 #include <obake/polynomials/polynomial.hpp>
 
-#include "simple_timer.hpp"
+#include "harness.hpp"
 
 using namespace obake;
 using namespace obake_benchmark;
 
-int main()
+int main(int argc, char **argv)
 {
-    using namespace obake;
-    const auto n = 16;
     try {
+        harness h("sparse_02_truncated", parse_harness_options(argc, argv, 16));
 
-        auto [x, y, z, t, u]
-            = make_polynomials<polynomial<packed_monomial<std::uint64_t>, mppp::integer<2>>>("x", "y", "z", "t", "u");
+        using poly_t = polynomial<packed_monomial<std::uint64_t>, mppp::integer<2>>;
+
+        auto [x, y, z, t, u] = make_polynomials<poly_t>("x", "y", "z", "t", "u");
 
         auto f = (x + y + z * z * 2 + t * t * t * 3 + u * u * u * u * u * 5 + 1);
         const auto tmp_f(f);
         auto g = (u + t + z * z * 2 + y * y * y * 3 + x * x * x * x * x * 5 + 1);
         const auto tmp_g(g);
 
-        for (int i = 1; i < n; ++i) {
+        for (int i = 1; i < h.power(); ++i) {
             f *= tmp_f;
             g *= tmp_g;
         }
 
-        polynomial<packed_monomial<std::uint64_t>, mppp::integer<2>> ret;
-        {
-            simple_timer t;
-            ret = truncated_mul(f, g, 300);
-        }
+        const auto ret = h.run("truncated_mul", [&f, &g]() { return truncated_mul(f, g, 300); });
 
-        std::cout << ret.table_stats() << '\n';
-    } catch (std::exception &e) {
-        std::cerr << e.what();
+        h.info(ret.table_stats());
+
+        h.report();
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
     }
+
+    return EXIT_SUCCESS;
 }
@@ -0,0 +1,65 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OBAKE_DETAIL_MMAP_FILE_HPP
+#define OBAKE_DETAIL_MMAP_FILE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <obake/detail/visibility.hpp>
+
+namespace obake::detail
+{
+
+#if defined(_MSC_VER)
+
+// NOTE: see the explanation in atomic_flag_array.hpp.
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
+#endif
+
+// Read-only memory mapping of a file.
+// The pages of the file are loaded on demand,
+// thus different threads can decode different
+// chunks of the file concurrently.
+class OBAKE_DLL_PUBLIC mmap_file
+{
+public:
+    using size_type = ::std::size_t;
+
+    explicit mmap_file(const ::std::string &);
+    ~mmap_file();
+    // Delete explicitly all other ctors/assignment operators.
+    mmap_file() = delete;
+    mmap_file(const mmap_file &) = delete;
+    mmap_file(mmap_file &&) = delete;
+    mmap_file &operator=(const mmap_file &) = delete;
+    mmap_file &operator=(mmap_file &&) = delete;
+
+    // NOTE: for an empty file, data() returns
+    // a null pointer.
+    const char *data() const;
+    size_type size() const;
+
+private:
+    struct impl;
+    ::std::unique_ptr<impl> m_impl;
+};
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
+
+} // namespace obake::detail
+
+#endif
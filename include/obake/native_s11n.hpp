@@ -0,0 +1,594 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OBAKE_NATIVE_S11N_HPP
+#define OBAKE_NATIVE_S11N_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/config.hpp>
+#include <obake/detail/to_string.hpp>
+#include <obake/exceptions.hpp>
+#include <obake/symbols.hpp>
+#include <obake/type_traits.hpp>
+
+namespace obake::detail
+{
+
+// Output buffer for obake's native binary
+// serialisation format.
+// NOTE: the native format stores the values
+// in the byte order of the host machine. It is meant
+// to be fast, rather than portable: the byte order
+// is checked when deserialising a series.
+class native_s11n_writer
+{
+public:
+    void write(const void *ptr, ::std::size_t n)
+    {
+        const auto p = static_cast<const char *>(ptr);
+        m_buffer.insert(m_buffer.end(), p, p + n);
+    }
+    template <typename T>
+    void write_value(const T &x)
+    {
+        static_assert(::std::is_trivially_copyable_v<T>);
+        write(&x, sizeof(T));
+    }
+    void write_string(const ::std::string &s)
+    {
+        write_value(static_cast<::std::uint64_t>(s.size()));
+        write(s.data(), s.size());
+    }
+    // Unsigned LEB128 encoding: 7 bits per byte, with the
+    // most significant bit signalling that more bytes follow.
+    void write_varint(::std::uint64_t n)
+    {
+        unsigned char buf[10];
+        ::std::size_t i = 0;
+        for (; n >= 0x80u; n >>= 7) {
+            buf[i++] = static_cast<unsigned char>(n | 0x80u);
+        }
+        buf[i++] = static_cast<unsigned char>(n);
+
+        write(buf, i);
+    }
+    void reserve(::std::size_t n)
+    {
+        m_buffer.reserve(n);
+    }
+    const ::std::vector<char> &buffer() const
+    {
+        return m_buffer;
+    }
+
+private:
+    ::std::vector<char> m_buffer;
+};
+
+// Input buffer for obake's native binary
+// serialisation format. It does not own
+// the data it reads from.
+class native_s11n_reader
+{
+public:
+    explicit native_s11n_reader(const char *begin, const char *end) : m_cur(begin), m_end(end) {}
+    ::std::size_t remaining() const
+    {
+        return static_cast<::std::size_t>(m_end - m_cur);
+    }
+    const char *current() const
+    {
+        return m_cur;
+    }
+    void read(void *ptr, ::std::size_t n)
+    {
+        if (obake_unlikely(n > remaining())) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the "
+                                                 "data ended unexpectedly");
+        }
+        // NOTE: avoid calling memcpy() with null pointers.
+        if (n != 0u) {
+            ::std::memcpy(ptr, m_cur, n);
+        }
+        m_cur += n;
+    }
+    template <typename T>
+    T read_value()
+    {
+        static_assert(::std::is_trivially_copyable_v<T> && ::std::is_default_constructible_v<T>);
+        T retval;
+        read(&retval, sizeof(T));
+        return retval;
+    }
+    ::std::string read_string()
+    {
+        const auto size = read_value<::std::uint64_t>();
+        if (obake_unlikely(size > remaining())) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the "
+                                                 "data ended unexpectedly");
+        }
+        ::std::string retval(m_cur, static_cast<::std::size_t>(size));
+        m_cur += size;
+        return retval;
+    }
+    ::std::uint64_t read_varint()
+    {
+        ::std::uint64_t retval = 0;
+        for (unsigned shift = 0; shift < 64u; shift += 7u) {
+            if (obake_unlikely(m_cur == m_end)) {
+                obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the "
+                                                     "data ended unexpectedly");
+            }
+
+            const auto byte = static_cast<unsigned char>(*m_cur++);
+            // NOTE: the tenth byte can contribute only
+            // the most significant bit.
+            if (obake_unlikely(shift == 63u && byte > 1u)) {
+                obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: a "
+                                                     "variable-length integer overflows 64 bits");
+            }
+
+            retval |= static_cast<::std::uint64_t>(byte & 0x7fu) << shift;
+            if ((byte & 0x80u) == 0u) {
+                return retval;
+            }
+        }
+
+        // LCOV_EXCL_START
+        assert(false);
+        return retval;
+        // LCOV_EXCL_STOP
+    }
+
+private:
+    const char *m_cur;
+    const char *m_end;
+};
+
+// Zigzag mapping of signed integers to unsigned
+// integers, so that small negative values are
+// also encoded in few bytes as varints.
+inline ::std::uint64_t native_s11n_zigzag(::std::int64_t n)
+{
+    const auto u = static_cast<::std::uint64_t>(n) << 1;
+    return n < 0 ? ~u : u;
+}
+
+inline ::std::int64_t native_s11n_unzigzag(::std::uint64_t u)
+{
+    // NOTE: u >> 1 is always representable by int64_t.
+    return (u & 1u) ? -static_cast<::std::int64_t>(u >> 1) - 1 : static_cast<::std::int64_t>(u >> 1);
+}
+
+// Native serialisation of a symbol set.
+inline void native_s11n_save_ss(native_s11n_writer &w, const symbol_set &ss)
+{
+    w.write_value(static_cast<::std::uint64_t>(ss.size()));
+    for (const auto &s : ss) {
+        w.write_string(s);
+    }
+}
+
+inline symbol_set native_s11n_load_ss(native_s11n_reader &r)
+{
+    const auto size = r.read_value<::std::uint64_t>();
+
+    symbol_set retval;
+    for (::std::uint64_t i = 0; i < size; ++i) {
+        auto s = r.read_string();
+
+        // NOTE: the symbols are stored in order, thus
+        // we can insert at the end of retval, after
+        // having checked the ordering.
+        if (obake_unlikely(!retval.empty() && !(*(retval.end() - 1) < s))) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the "
+                                                 "symbols of a symbol set are not stored in strictly ascending "
+                                                 "order");
+        }
+        retval.insert(retval.end(), ::std::move(s));
+    }
+
+    return retval;
+}
+
+// Read exactly n bytes from the input stream is, appending
+// them to buf. Returns false if the stream ended before n bytes
+// could be read.
+// NOTE: n may come from untrusted data, thus buf is grown
+// in chunks as the data is read, rather than upfront.
+inline bool native_s11n_read_exact(::std::istream &is, ::std::vector<char> &buf, ::std::uint64_t n)
+{
+    constexpr ::std::uint64_t chunk_size = 1ul << 20;
+
+    while (n != 0u) {
+        const auto cur = static_cast<::std::size_t>(::std::min(n, chunk_size));
+        const auto old_size = buf.size();
+        buf.resize(old_size + cur);
+        is.read(buf.data() + old_size, static_cast<::std::streamsize>(cur));
+
+        const auto n_read = static_cast<::std::size_t>(is.gcount());
+        if (n_read != cur) {
+            buf.resize(old_size + n_read);
+
+            if (obake_unlikely(is.bad())) {
+                obake_throw(::std::runtime_error, "An error occurred while reading data from an input stream");
+            }
+
+            return false;
+        }
+
+        n -= cur;
+    }
+
+    return true;
+}
+
+// Implementation of obake's native binary serialisation
+// format for the type T. Specialisations must provide
+// the static member functions:
+// - tag(), returning a string which identifies the encoding
+//   (it is stored in the serialised data and checked upon loading),
+// - save(native_s11n_writer &, const T &, const symbol_set &),
+// - load(native_s11n_reader &, T &, const symbol_set &).
+// The symbol set passed to save() and load() is the symbol
+// set of the series in which the object is stored.
+template <typename T, typename = void>
+struct native_s11n {
+};
+
+template <typename T>
+using native_s11n_tag_t = decltype(native_s11n<T>::tag());
+
+template <typename T>
+using native_s11n_save_t = decltype(native_s11n<T>::save(::std::declval<native_s11n_writer &>(),
+                                                         ::std::declval<const T &>(),
+                                                         ::std::declval<const symbol_set &>()));
+
+template <typename T>
+using native_s11n_load_t = decltype(native_s11n<T>::load(::std::declval<native_s11n_reader &>(),
+                                                         ::std::declval<T &>(), ::std::declval<const symbol_set &>()));
+
+template <typename T>
+using is_native_s11n
+    = ::std::conjunction<::std::is_same<detected_t<native_s11n_tag_t, T>, ::std::string>,
+                         is_detected<native_s11n_save_t, T>, is_detected<native_s11n_load_t, T>>;
+
+template <typename T>
+inline constexpr bool is_native_s11n_v = is_native_s11n<T>::value;
+
+// Arithmetic types are stored as they are
+// represented in memory.
+template <typename T>
+struct native_s11n<T, ::std::enable_if_t<is_arithmetic_v<T>>> {
+    static ::std::string tag()
+    {
+        const auto nbits = detail::to_string(sizeof(T) * CHAR_BIT);
+
+        if constexpr (::std::is_same_v<T, bool>) {
+            return "bool";
+        } else if constexpr (is_integral_v<T>) {
+            return (is_signed_v<T> ? "i" : "u") + nbits;
+        } else {
+            // NOTE: for floating-point types, include also
+            // the number of binary digits in the significand.
+            return "f" + nbits + "_" + detail::to_string(::std::numeric_limits<T>::digits);
+        }
+    }
+    static void save(native_s11n_writer &w, const T &x, const symbol_set &)
+    {
+        w.write_value(x);
+    }
+    static void load(native_s11n_reader &r, T &x, const symbol_set &)
+    {
+        x = r.read_value<T>();
+    }
+};
+
+// mppp::integer is stored as the signed number
+// of limbs (as a 64-bit integer), followed by
+// the limbs of the absolute value.
+template <::std::size_t SSize>
+struct native_s11n<::mppp::integer<SSize>> {
+    static ::std::string tag()
+    {
+        return "integer_l" + detail::to_string(sizeof(::mp_limb_t) * CHAR_BIT);
+    }
+    static void save(native_s11n_writer &w, const ::mppp::integer<SSize> &n, const symbol_set &)
+    {
+        // NOTE: the mpz view gives uniform access to the limbs
+        // of n, regardless of the storage type.
+        const auto v = n.get_mpz_view();
+        const auto ptr = v.get();
+
+        const auto size = static_cast<::std::int64_t>(ptr->_mp_size);
+        w.write_value(size);
+        w.write(ptr->_mp_d, static_cast<::std::size_t>(size < 0 ? -size : size) * sizeof(::mp_limb_t));
+    }
+    static void load(native_s11n_reader &r, ::mppp::integer<SSize> &n, const symbol_set &)
+    {
+        const auto size = r.read_value<::std::int64_t>();
+        if (size == 0) {
+            n = ::mppp::integer<SSize>{};
+            return;
+        }
+
+        // NOTE: compute the absolute value in the unsigned
+        // domain, so that we don't run into overflow.
+        load_limbs(r, n, size < 0 ? -static_cast<::std::uint64_t>(size) : static_cast<::std::uint64_t>(size),
+                   size < 0);
+    }
+    // Read nlimbs (nonzero) limbs into n.
+    static void load_limbs(native_s11n_reader &r, ::mppp::integer<SSize> &n, ::std::uint64_t nlimbs, bool neg)
+    {
+        assert(nlimbs > 0u);
+
+        if (obake_unlikely(nlimbs > r.remaining() / sizeof(::mp_limb_t))) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the "
+                                                 "data ended unexpectedly");
+        }
+
+        ::boost::container::small_vector<::mp_limb_t, 2> limbs(static_cast<::std::size_t>(nlimbs));
+        r.read(limbs.data(), static_cast<::std::size_t>(nlimbs) * sizeof(::mp_limb_t));
+        if (obake_unlikely(limbs.back() == 0u)) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the most "
+                                                 "significant limb of an integer is zero");
+        }
+
+        // NOTE: mpz_roinit_n() creates a read-only mpz_t
+        // on top of the limbs, without allocating.
+        ::mpz_t tmp;
+        const auto size = static_cast<::mp_size_t>(nlimbs);
+        ::mpz_roinit_n(tmp, limbs.data(), neg ? -size : size);
+        n = ::mppp::integer<SSize>(tmp);
+    }
+};
+
+// mppp::rational is stored as numerator
+// followed by denominator.
+template <::std::size_t SSize>
+struct native_s11n<::mppp::rational<SSize>> {
+    using int_s11n = native_s11n<::mppp::integer<SSize>>;
+
+    static ::std::string tag()
+    {
+        return "rational_l" + detail::to_string(sizeof(::mp_limb_t) * CHAR_BIT);
+    }
+    static void save(native_s11n_writer &w, const ::mppp::rational<SSize> &q, const symbol_set &ss)
+    {
+        int_s11n::save(w, q.get_num(), ss);
+        int_s11n::save(w, q.get_den(), ss);
+    }
+    static void load(native_s11n_reader &r, ::mppp::rational<SSize> &q, const symbol_set &ss)
+    {
+        ::mppp::integer<SSize> num, den;
+        int_s11n::load(r, num, ss);
+        int_s11n::load(r, den, ss);
+
+        if (obake_unlikely(den.sgn() <= 0)) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the "
+                                                 "denominator of a rational is not positive");
+        }
+
+        // NOTE: go through the canonicalising constructor,
+        // so that a non-canonical input cannot produce
+        // an invalid rational.
+        q = ::mppp::rational<SSize>(num, den);
+    }
+};
+
+// Compact encodings, used in the compressed mode of
+// the native serialisation format for series. Specialisations
+// must provide save() and load() static member functions with
+// the same signatures as in native_s11n. Types without a compact
+// encoding are stored with their plain encoding.
+template <typename T, typename = void>
+struct native_s11n_compact {
+};
+
+template <typename T>
+using native_s11n_compact_save_t = decltype(native_s11n_compact<T>::save(
+    ::std::declval<native_s11n_writer &>(), ::std::declval<const T &>(), ::std::declval<const symbol_set &>()));
+
+template <typename T>
+using native_s11n_compact_load_t = decltype(native_s11n_compact<T>::load(
+    ::std::declval<native_s11n_reader &>(), ::std::declval<T &>(), ::std::declval<const symbol_set &>()));
+
+template <typename T>
+inline constexpr bool is_native_s11n_compact_v
+    = ::std::conjunction_v<is_detected<native_s11n_compact_save_t, T>, is_detected<native_s11n_compact_load_t, T>>;
+
+template <typename T>
+inline void native_s11n_save_compact(native_s11n_writer &w, const T &x, const symbol_set &ss)
+{
+    if constexpr (is_native_s11n_compact_v<T>) {
+        native_s11n_compact<T>::save(w, x, ss);
+    } else {
+        native_s11n<T>::save(w, x, ss);
+    }
+}
+
+template <typename T>
+inline void native_s11n_load_compact(native_s11n_reader &r, T &x, const symbol_set &ss)
+{
+    if constexpr (is_native_s11n_compact_v<T>) {
+        native_s11n_compact<T>::load(r, x, ss);
+    } else {
+        native_s11n<T>::load(r, x, ss);
+    }
+}
+
+// Integral types up to 64 bits are stored as varints
+// (after zigzag mapping, for signed types).
+template <typename T>
+struct native_s11n_compact<T, ::std::enable_if_t<::std::conjunction_v<
+                                  is_integral<T>, ::std::negation<::std::is_same<T, bool>>,
+                                  ::std::bool_constant<(sizeof(T) <= sizeof(::std::uint64_t))>>>> {
+    static void save(native_s11n_writer &w, const T &x, const symbol_set &)
+    {
+        if constexpr (is_signed_v<T>) {
+            w.write_varint(detail::native_s11n_zigzag(static_cast<::std::int64_t>(x)));
+        } else {
+            w.write_varint(static_cast<::std::uint64_t>(x));
+        }
+    }
+    static void load(native_s11n_reader &r, T &x, const symbol_set &)
+    {
+        const auto u = r.read_varint();
+
+        if constexpr (is_signed_v<T>) {
+            const auto n = detail::native_s11n_unzigzag(u);
+            if (obake_unlikely(n < ::std::numeric_limits<T>::min() || n > ::std::numeric_limits<T>::max())) {
+                obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: an "
+                                                     "integral value is out of range");
+            }
+            x = static_cast<T>(n);
+        } else {
+            if (obake_unlikely(u > ::std::numeric_limits<T>::max())) {
+                obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: an "
+                                                     "integral value is out of range");
+            }
+            x = static_cast<T>(u);
+        }
+    }
+};
+
+// mppp::integer is encoded according to its magnitude:
+// - values whose absolute value is less than 2**62 are
+//   stored as the zigzag varint of the value shifted up by
+//   one bit (so that the least significant bit is zero),
+// - larger values are stored as the varint of
+//   (nlimbs << 2 | sign << 1 | 1), followed by the limbs.
+template <::std::size_t SSize>
+struct native_s11n_compact<::mppp::integer<SSize>> {
+    static void save(native_s11n_writer &w, const ::mppp::integer<SSize> &n, const symbol_set &)
+    {
+        const auto v = n.get_mpz_view();
+        const auto ptr = v.get();
+        const auto size = ptr->_mp_size;
+
+        if (size == 0) {
+            w.write_varint(0);
+            return;
+        }
+
+        if ((size == 1 || size == -1) && static_cast<::std::uint64_t>(ptr->_mp_d[0]) < (::std::uint64_t(1) << 62)) {
+            const auto abs_n = static_cast<::std::int64_t>(ptr->_mp_d[0]);
+            w.write_varint(detail::native_s11n_zigzag(size < 0 ? -abs_n : abs_n) << 1);
+            return;
+        }
+
+        const auto nlimbs = static_cast<::std::uint64_t>(size < 0 ? -static_cast<::std::int64_t>(size) : size);
+        w.write_varint((nlimbs << 2) | (static_cast<::std::uint64_t>(size < 0) << 1) | 1u);
+        w.write(ptr->_mp_d, static_cast<::std::size_t>(nlimbs) * sizeof(::mp_limb_t));
+    }
+    static void load(native_s11n_reader &r, ::mppp::integer<SSize> &n, const symbol_set &)
+    {
+        const auto u = r.read_varint();
+
+        if ((u & 1u) == 0u) {
+            n = ::mppp::integer<SSize>{detail::native_s11n_unzigzag(u >> 1)};
+            return;
+        }
+
+        const auto nlimbs = u >> 2;
+        if (obake_unlikely(nlimbs == 0u)) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: a "
+                                                 "large integer with no limbs was encountered");
+        }
+
+        native_s11n<::mppp::integer<SSize>>::load_limbs(r, n, nlimbs, (u & 2u) != 0u);
+    }
+};
+
+// mppp::rational: compact numerator and denominator.
+template <::std::size_t SSize>
+struct native_s11n_compact<::mppp::rational<SSize>> {
+    using int_s11n = native_s11n_compact<::mppp::integer<SSize>>;
+
+    static void save(native_s11n_writer &w, const ::mppp::rational<SSize> &q, const symbol_set &ss)
+    {
+        int_s11n::save(w, q.get_num(), ss);
+        int_s11n::save(w, q.get_den(), ss);
+    }
+    static void load(native_s11n_reader &r, ::mppp::rational<SSize> &q, const symbol_set &ss)
+    {
+        ::mppp::integer<SSize> num, den;
+        int_s11n::load(r, num, ss);
+        int_s11n::load(r, den, ss);
+
+        if (obake_unlikely(den.sgn() <= 0)) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the "
+                                                 "denominator of a rational is not positive");
+        }
+
+        q = ::mppp::rational<SSize>(num, den);
+    }
+};
+
+// Key types which can be mapped one-to-one onto 64-bit unsigned
+// integers. In the compressed mode of the native serialisation
+// format for series, such keys are sorted within each segment
+// and stored as varint-encoded deltas. Specialisations must provide
+// the static member functions:
+// - to_uint(const T &), returning an std::uint64_t,
+// - from_uint(T &, std::uint64_t), which must throw if the
+//   input value does not correspond to any key.
+template <typename T, typename = void>
+struct native_s11n_key_delta {
+};
+
+template <typename T>
+using native_s11n_key_delta_to_t = decltype(native_s11n_key_delta<T>::to_uint(::std::declval<const T &>()));
+
+template <typename T>
+using native_s11n_key_delta_from_t = decltype(
+    native_s11n_key_delta<T>::from_uint(::std::declval<T &>(), ::std::declval<const ::std::uint64_t &>()));
+
+template <typename T>
+inline constexpr bool is_native_s11n_key_delta_v
+    = ::std::conjunction_v<::std::is_same<detected_t<native_s11n_key_delta_to_t, T>, ::std::uint64_t>,
+                           is_detected<native_s11n_key_delta_from_t, T>>;
+
+} // namespace obake::detail
+
+namespace obake
+{
+
+// Encodings for the native serialisation format of series:
+// - plain: keys and coefficients are stored as they
+//   are represented in memory,
+// - compressed: keys are sorted and delta-encoded (when
+//   supported by the key type), and coefficients are stored
+//   in compact form according to their magnitude,
+// - indexed: like plain, but the terms of each segment are
+//   sorted by key hash and followed by an on-disk hash index,
+//   so that single terms can be located without decoding
+//   the whole segment (see series_view).
+enum class native_s11n_mode { plain, compressed, indexed };
+
+} // namespace obake
+
+#endif
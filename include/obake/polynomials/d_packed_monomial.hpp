@@ -17,6 +17,7 @@
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -43,6 +44,7 @@
 #include <obake/math/pow.hpp>
 #include <obake/math/safe_cast.hpp>
 #include <obake/math/safe_convert.hpp>
+#include <obake/native_s11n.hpp>
 #include <obake/polynomials/monomial_homomorphic_hash.hpp>
 #include <obake/ranges.hpp>
 #include <obake/s11n.hpp>
@@ -955,6 +957,29 @@ inline T key_p_degree(const d_packed_monomial<T, NBits> &d, const symbol_idx_set
     return static_cast<T>(retval);
 }
 
+// Write the exponents of d into the range beginning at out.
+// NOTE: this assumes that d is compatible with ss.
+template <typename T, unsigned NBits, typename It>
+inline void monomial_unpack(const d_packed_monomial<T, NBits> &d, const symbol_set &ss, It out)
+{
+    assert(polynomials::key_is_compatible(d, ss));
+
+    constexpr auto psize = d_packed_monomial<T, NBits>::psize;
+
+    const auto s_size = ss.size();
+
+    symbol_idx idx = 0;
+    T tmp;
+    for (const auto &n : d._container()) {
+        k_unpacker<T> ku(n, psize);
+
+        for (auto j = 0u; j < psize && idx < s_size; ++j, ++idx, ++out) {
+            ku >> tmp;
+            *out = tmp;
+        }
+    }
+}
+
 // Monomial exponentiation.
 // NOTE: this assumes that d is compatible with ss.
 template <typename T, unsigned NBits, typename U,
@@ -1401,6 +1426,39 @@ using d_packed_monomial = polynomials::d_packed_monomial<T, NBits>;
 template <typename T, unsigned NBits>
 inline constexpr bool monomial_hash_is_homomorphic<d_packed_monomial<T, NBits>> = true;
 
+namespace detail
+{
+
+// Native serialisation: the packed values are stored
+// contiguously, without size information (the size
+// is deduced from the symbol set).
+template <typename T, unsigned NBits>
+struct native_s11n<d_packed_monomial<T, NBits>> {
+    static ::std::string tag()
+    {
+        return "d_packed_monomial<" + native_s11n<T>::tag() + "," + detail::to_string(NBits) + ">";
+    }
+    static void save(native_s11n_writer &w, const d_packed_monomial<T, NBits> &d, const symbol_set &ss)
+    {
+        const auto &c = d._container();
+        assert((c.size() == polynomials::detail::dpm_nexpos_to_vsize<d_packed_monomial<T, NBits>>(ss.size())));
+        ::obake::detail::ignore(ss);
+
+        w.write(c.data(), c.size() * sizeof(T));
+    }
+    static void load(native_s11n_reader &r, d_packed_monomial<T, NBits> &d, const symbol_set &ss)
+    {
+        using size_type = typename d_packed_monomial<T, NBits>::container_t::size_type;
+
+        auto &c = d._container();
+        c.resize(::obake::safe_cast<size_type>(
+            polynomials::detail::dpm_nexpos_to_vsize<d_packed_monomial<T, NBits>>(ss.size())));
+        r.read(c.data(), c.size() * sizeof(T));
+    }
+};
+
+} // namespace detail
+
 } // namespace obake
 
 namespace boost::serialization
@@ -0,0 +1,261 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OBAKE_POLYNOMIALS_MUL_PROFILE_HPP
+#define OBAKE_POLYNOMIALS_MUL_PROFILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <obake/config.hpp>
+#include <obake/detail/visibility.hpp>
+
+#if defined(OBAKE_WITH_MUL_PROFILING)
+
+#include <cassert>
+#include <chrono>
+#include <utility>
+
+#include <tbb/task_arena.h>
+
+#endif
+
+namespace obake::polynomials
+{
+
+// The phases of a polynomial multiplication.
+enum class mul_phase : unsigned {
+    // Copy of the input terms.
+    copy,
+    // Monomial overflow checking.
+    overflow_check,
+    // Estimation of the size of the product.
+    estimate,
+    // Sorting of the input terms.
+    sort,
+    // Computation of the segmentation of the input terms.
+    segment,
+    // Term-by-term multiplications.
+    multiply,
+    // Removal of the terms with zero coefficients.
+    cleanup
+};
+
+inline constexpr ::std::size_t n_mul_phases = 7;
+
+// Return a string representation of the phase p.
+OBAKE_DLL_PUBLIC const char *mul_phase_name(mul_phase);
+
+// Statistics for a single segment of the product.
+struct mul_segment_profile {
+    // Number of term-by-term multiplications.
+    unsigned long long n_mults = 0;
+    // Number of terms inserted in the segment.
+    unsigned long long n_insertions = 0;
+    // Number of products accumulated into an existing term.
+    unsigned long long n_collisions = 0;
+    // Number of terms erased because of a zero coefficient.
+    unsigned long long n_erased = 0;
+    // Time spent in the multiply and cleanup phases.
+    double mult_time = 0;
+    double cleanup_time = 0;
+};
+
+// The profile of a polynomial multiplication. All times are in seconds.
+// NOTE: the multiply and cleanup phases are interleaved segment
+// by segment in the multi-threaded implementation, thus their times
+// are summed over all segments (i.e., over all threads). The other
+// phase times are wall times.
+struct mul_profile {
+    // The algorithm used ("simple" or "mt_hm").
+    ::std::string algorithm;
+    // The total wall time.
+    double total_time = 0;
+    // The time spent in each phase.
+    ::std::array<double, n_mul_phases> phase_times{};
+    // The per-segment statistics.
+    ::std::vector<mul_segment_profile> segments;
+    // The time spent computing segments by each thread,
+    // indexed by the TBB thread index.
+    ::std::vector<double> thread_busy_times;
+
+    double phase_time(mul_phase p) const
+    {
+        return phase_times[static_cast<::std::size_t>(p)];
+    }
+};
+
+// Flag signalling whether or not obake was built
+// with the multiplication profiling enabled.
+inline constexpr bool mul_profiling_enabled =
+#if defined(OBAKE_WITH_MUL_PROFILING)
+    true
+#else
+    false
+#endif
+    ;
+
+// Install a callback which will be invoked with the profile of every
+// profiled multiplication. An empty function uninstalls the callback.
+// NOTE: the callback may be invoked concurrently from multiple threads.
+using mul_profile_callback = ::std::function<void(const mul_profile &)>;
+
+OBAKE_DLL_PUBLIC void set_mul_profile_callback(mul_profile_callback);
+
+// Fetch the profile of the last profiled multiplication.
+// If profiling is disabled or no multiplication has been
+// profiled yet, an empty profile is returned.
+OBAKE_DLL_PUBLIC mul_profile get_last_mul_profile();
+
+namespace detail
+{
+
+// Store p as the last profile and invoke the user callback, if any.
+OBAKE_DLL_PUBLIC void mul_profile_deliver(mul_profile &&);
+
+#if defined(OBAKE_WITH_MUL_PROFILING)
+
+// The profiler used in the implementation of polynomial
+// multiplication. Phases are timed sequentially via
+// begin()/end(), the per-segment statistics and the per-thread
+// busy times are filled in from the parallel sections.
+class mul_profiler
+{
+    using clock_t = ::std::chrono::steady_clock;
+
+    static double elapsed(clock_t::time_point start)
+    {
+        return ::std::chrono::duration<double>(clock_t::now() - start).count();
+    }
+
+public:
+    explicit mul_profiler(const char *algo) : m_start(clock_t::now()), m_phase_start(m_start)
+    {
+        m_profile.algorithm = algo;
+        m_profile.thread_busy_times.resize(static_cast<::std::size_t>(::tbb::this_task_arena::max_concurrency()));
+    }
+
+    // Start timing the phase p, stopping the current phase (if any).
+    void begin(mul_phase p)
+    {
+        end();
+        m_cur_phase = static_cast<::std::size_t>(p);
+        m_phase_start = clock_t::now();
+    }
+    // Stop timing the current phase (if any).
+    void end()
+    {
+        if (m_cur_phase != n_mul_phases) {
+            m_profile.phase_times[m_cur_phase] += elapsed(m_phase_start);
+            m_cur_phase = n_mul_phases;
+        }
+    }
+    // Add t seconds to the phase p.
+    void add(mul_phase p, double t)
+    {
+        m_profile.phase_times[static_cast<::std::size_t>(p)] += t;
+    }
+
+    void set_n_segments(::std::size_t n)
+    {
+        m_profile.segments.resize(n);
+    }
+    // Record the statistics sp for the segment at index idx.
+    // NOTE: each segment is recorded by a single thread.
+    void record_segment(::std::size_t idx, const mul_segment_profile &sp)
+    {
+        assert(idx < m_profile.segments.size());
+        m_profile.segments[idx] = sp;
+    }
+
+    // Helper to time a section of a parallel computation.
+    class section
+    {
+    public:
+        section() : m_start(clock_t::now()) {}
+        // Return the time elapsed since the construction
+        // or the previous call to stop().
+        double stop()
+        {
+            const auto now = clock_t::now();
+            const auto retval = ::std::chrono::duration<double>(now - m_start).count();
+            m_start = now;
+            return retval;
+        }
+
+    private:
+        clock_t::time_point m_start;
+    };
+
+    // Add t seconds to the busy time of the current thread.
+    // NOTE: threads in an arena have distinct indices, hence no
+    // synchronisation is needed.
+    void add_busy_time(double t)
+    {
+        const auto idx = static_cast<::std::size_t>(::tbb::this_task_arena::current_thread_index());
+        if (idx < m_profile.thread_busy_times.size()) {
+            m_profile.thread_busy_times[idx] += t;
+        }
+    }
+
+    // Complete the profiling and deliver the profile.
+    void finish()
+    {
+        end();
+        m_profile.total_time = elapsed(m_start);
+        for (const auto &sp : m_profile.segments) {
+            add(mul_phase::multiply, sp.mult_time);
+            add(mul_phase::cleanup, sp.cleanup_time);
+        }
+        detail::mul_profile_deliver(::std::move(m_profile));
+    }
+
+private:
+    mul_profile m_profile;
+    clock_t::time_point m_start;
+    clock_t::time_point m_phase_start;
+    ::std::size_t m_cur_phase = n_mul_phases;
+};
+
+#else
+
+// No-op profiler, used when profiling is disabled.
+class mul_profiler
+{
+public:
+    explicit mul_profiler(const char *) {}
+
+    void begin(mul_phase) {}
+    void end() {}
+    void add(mul_phase, double) {}
+    void set_n_segments(::std::size_t) {}
+    void record_segment(::std::size_t, const mul_segment_profile &) {}
+
+    class section
+    {
+    public:
+        double stop()
+        {
+            return 0;
+        }
+    };
+
+    void add_busy_time(double) {}
+    void finish() {}
+};
+
+#endif
+
+} // namespace detail
+
+} // namespace obake::polynomials
+
+#endif
@@ -12,11 +12,14 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -40,6 +43,7 @@
 #include <obake/math/pow.hpp>
 #include <obake/math/safe_cast.hpp>
 #include <obake/math/safe_convert.hpp>
+#include <obake/native_s11n.hpp>
 #include <obake/polynomials/monomial_homomorphic_hash.hpp>
 #include <obake/ranges.hpp>
 #include <obake/s11n.hpp>
@@ -736,6 +740,24 @@ inline T key_p_degree(const packed_monomial<T> &p, const symbol_idx_set &si, con
     return retval;
 }
 
+// Write the exponents of p into the range beginning at out.
+// NOTE: this assumes that p is compatible with ss.
+template <typename T, typename It>
+inline void monomial_unpack(const packed_monomial<T> &p, const symbol_set &ss, It out)
+{
+    assert(polynomials::key_is_compatible(p, ss));
+
+    // NOTE: because we assume compatibility, the static cast is safe.
+    const auto s_size = static_cast<unsigned>(ss.size());
+
+    T tmp;
+    k_unpacker<T> ku(p.get_value(), s_size);
+    for (auto i = 0u; i < s_size; ++i, ++out) {
+        ku >> tmp;
+        *out = tmp;
+    }
+}
+
 // Monomial exponentiation.
 // NOTE: this assumes that p is compatible with ss.
 template <typename T, typename U,
@@ -1093,6 +1115,51 @@ using packed_monomial = polynomials::packed_monomial<T>;
 template <typename T>
 inline constexpr bool monomial_hash_is_homomorphic<packed_monomial<T>> = true;
 
+namespace detail
+{
+
+// Native serialisation: the packed value
+// is stored as it is.
+template <typename T>
+struct native_s11n<packed_monomial<T>> {
+    static ::std::string tag()
+    {
+        return "packed_monomial<" + native_s11n<T>::tag() + ">";
+    }
+    static void save(native_s11n_writer &w, const packed_monomial<T> &m, const symbol_set &)
+    {
+        w.write_value(m.get_value());
+    }
+    static void load(native_s11n_reader &r, packed_monomial<T> &m, const symbol_set &)
+    {
+        m._set_value(r.read_value<T>());
+    }
+};
+
+// Compressed native serialisation: the packed values are
+// reinterpreted as unsigned integers, so that they can
+// be sorted and delta-encoded.
+template <typename T>
+struct native_s11n_key_delta<packed_monomial<T>, ::std::enable_if_t<(sizeof(T) <= sizeof(::std::uint64_t))>> {
+    using uint_t = make_unsigned_t<T>;
+
+    static ::std::uint64_t to_uint(const packed_monomial<T> &m)
+    {
+        return static_cast<uint_t>(m.get_value());
+    }
+    static void from_uint(packed_monomial<T> &m, const ::std::uint64_t &n)
+    {
+        if (obake_unlikely(n > ::std::numeric_limits<uint_t>::max())) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: a packed "
+                                                 "value is out of range");
+        }
+
+        m._set_value(static_cast<T>(static_cast<uint_t>(n)));
+    }
+};
+
+} // namespace detail
+
 } // namespace obake
 
 namespace boost::serialization
@@ -16,8 +16,12 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <initializer_list>
 #include <numeric>
+#include <optional>
+#include <ostream>
 #include <random>
 #include <stdexcept>
 #include <string>
@@ -27,6 +31,7 @@
 #include <vector>
 
 #include <boost/container/container_fwd.hpp>
+#include <boost/container/flat_map.hpp>
 #include <boost/iterator/permutation_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/numeric/conversion/cast.hpp>
@@ -51,13 +56,17 @@
 #include <obake/detail/xoroshiro128_plus.hpp>
 #include <obake/exceptions.hpp>
 #include <obake/hash.hpp>
+#include <obake/key/key_degree.hpp>
 #include <obake/key/key_merge_symbols.hpp>
+#include <obake/key/key_p_degree.hpp>
+#include <obake/key/key_trim_identify.hpp>
 #include <obake/math/diff.hpp>
 #include <obake/math/fma3.hpp>
 #include <obake/math/is_zero.hpp>
 #include <obake/math/pow.hpp>
 #include <obake/math/safe_cast.hpp>
 #include <obake/math/subs.hpp>
+#include <obake/native_s11n.hpp>
 #include <obake/polynomials/monomial_diff.hpp>
 #include <obake/polynomials/monomial_homomorphic_hash.hpp>
 #include <obake/polynomials/monomial_integrate.hpp>
@@ -65,8 +74,10 @@
 #include <obake/polynomials/monomial_pow.hpp>
 #include <obake/polynomials/monomial_range_overflow_check.hpp>
 #include <obake/polynomials/monomial_subs.hpp>
+#include <obake/polynomials/mul_profile.hpp>
 #include <obake/ranges.hpp>
 #include <obake/series.hpp>
+#include <obake/series_view.hpp>
 #include <obake/symbols.hpp>
 #include <obake/type_traits.hpp>
 
@@ -313,6 +324,25 @@ struct poly_term_key_ref_extractor {
     }
 };
 
+// Small helper to fetch a const reference to a term,
+// given either the term itself or a pointer to it.
+template <typename P>
+constexpr const P &poly_term_ref(const P &p) noexcept
+{
+    return p;
+}
+
+template <typename P>
+constexpr const P &poly_term_ref(const P *p) noexcept
+{
+    return *p;
+}
+
+// The term type corresponding to the items of a vector of
+// terms or of a vector of pointers to terms.
+template <typename T>
+using poly_term_ref_t = remove_cvref_t<decltype(detail::poly_term_ref(::std::declval<const T &>()))>;
+
 // Meta-programming for selecting the algorithm and the return
 // type of polynomial multiplication.
 template <typename T, typename U>
@@ -386,14 +416,15 @@ template <typename T, typename U>
 using poly_mul_ret_t = typename decltype(poly_mul_algorithm<T, U>.second)::type;
 
 // Helper to estimate the average term size (in bytes) in a poly multiplication.
+// v1 and v2 contain either terms or pointers to terms.
 // NOTE: should this also be made proportional to the number
 // of estimated term-by-term multiplications?
 template <typename RetCf, typename T1, typename T2>
 inline ::std::size_t poly_mul_impl_estimate_average_term_size(const ::std::vector<T1> &v1, const ::std::vector<T2> &v2,
                                                               const symbol_set &ss)
 {
-    using ret_key_t = typename T1::first_type;
-    static_assert(::std::is_same_v<ret_key_t, typename T2::first_type>);
+    using ret_key_t = ::std::remove_const_t<typename poly_term_ref_t<T1>::first_type>;
+    static_assert(::std::is_same_v<ret_key_t, ::std::remove_const_t<typename poly_term_ref_t<T2>::first_type>>);
 
     // Compute the padding in the term class.
     constexpr auto pad_size = sizeof(series_term_t<polynomial<ret_key_t, RetCf>>) - (sizeof(RetCf) + sizeof(ret_key_t));
@@ -429,8 +460,10 @@ inline ::std::size_t poly_mul_impl_estimate_average_term_size(const ::std::vecto
         const auto idx2 = dist2(rng);
 
         // Multiply monomial and coefficient.
-        ::obake::monomial_mul(tmp_key, v1[idx1].first, v2[idx2].first, ss);
-        const auto tmp_cf = v1[idx1].second * v2[idx2].second;
+        const auto &t1 = detail::poly_term_ref(v1[idx1]);
+        const auto &t2 = detail::poly_term_ref(v2[idx2]);
+        ::obake::monomial_mul(tmp_key, t1.first, t2.first, ss);
+        const auto tmp_cf = t1.second * t2.second;
 
         // Accumulate the size of the produced term: size of monomial,
         // coefficient, and, if present, padding.
@@ -471,7 +504,7 @@ struct poly_mul_impl_pair_transform {
 //   (which could be different from the product of the sizes of the
 //   factors due to truncation).
 // S1 and S2 are the types of the polynomials, x and y the polynomials
-// represented as vectors of terms. The extra arguments represent
+// represented as vectors of terms (or of pointers to terms). The extra arguments represent
 // the truncation limits.
 // Requires x and y not empty, y not shorter than x. The returned
 // value is guaranteed to be nonzero.
@@ -491,12 +524,12 @@ inline auto poly_mul_estimate_product_size(const ::std::vector<T1> &x, const ::s
     static_assert(sizeof...(args) <= 2u);
 
     // Make sure that the input types are consistent.
-    using key_type = typename T1::first_type;
-    static_assert(::std::is_same_v<key_type, typename T2::first_type>);
+    using key_type = ::std::remove_const_t<typename poly_term_ref_t<T1>::first_type>;
+    static_assert(::std::is_same_v<key_type, ::std::remove_const_t<typename poly_term_ref_t<T2>::first_type>>);
     static_assert(::std::is_same_v<series_key_t<S1>, key_type>);
     static_assert(::std::is_same_v<series_key_t<S2>, key_type>);
-    static_assert(::std::is_same_v<series_cf_t<S1>, typename T1::second_type>);
-    static_assert(::std::is_same_v<series_cf_t<S2>, typename T2::second_type>);
+    static_assert(::std::is_same_v<series_cf_t<S1>, typename poly_term_ref_t<T1>::second_type>);
+    static_assert(::std::is_same_v<series_cf_t<S2>, typename poly_term_ref_t<T2>::second_type>);
 
     // Prepare the variable to hold the degree data.
     auto degree_data = detail::poly_mul_impl_prepare_degree_data<S1, S2>(x, y, ss, args...);
@@ -749,7 +782,8 @@ inline auto poly_mul_estimate_product_size(const ::std::vector<T1> &x, const ::s
                     const auto idx2 = vidx2[idist(rng, dist_param_type(0u, limit - 1u))];
 
                     // Try to do the multiplication.
-                    ::obake::monomial_mul(tmp_key, x[idx1].first, y[idx2].first, ss);
+                    ::obake::monomial_mul(tmp_key, detail::poly_term_ref(x[idx1]).first,
+                                          detail::poly_term_ref(y[idx2]).first, ss);
 
                     // Try the insertion into the local set.
                     const auto ret = ls.insert(tmp_key);
@@ -797,9 +831,66 @@ inline auto poly_mul_estimate_product_size(const ::std::vector<T1> &x, const ::s
     }
 }
 
-// The multi-threaded homomorphic implementation.
-template <typename Ret, typename T, typename U, typename... Args>
-inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args &... args)
+// Run the monomial overflow checking on the vectors of terms
+// v1 and v2, if supported.
+template <typename V1, typename V2>
+inline void poly_mul_impl_overflow_check(const V1 &v1, const V2 &v2, const symbol_set &ss)
+{
+    const auto r1
+        = ::obake::detail::make_range(::boost::make_transform_iterator(v1.cbegin(), poly_term_key_ref_extractor{}),
+                                      ::boost::make_transform_iterator(v1.cend(), poly_term_key_ref_extractor{}));
+    const auto r2
+        = ::obake::detail::make_range(::boost::make_transform_iterator(v2.cbegin(), poly_term_key_ref_extractor{}),
+                                      ::boost::make_transform_iterator(v2.cend(), poly_term_key_ref_extractor{}));
+    if constexpr (are_overflow_testable_monomial_ranges_v<decltype(r1) &, decltype(r2) &>) {
+        // The monomial overflow checking is supported, run it.
+        if (obake_unlikely(!::obake::monomial_range_overflow_check(r1, r2, ss))) {
+            obake_throw(::std::overflow_error, "An overflow in the monomial exponents was detected while "
+                                               "attempting to multiply two polynomials");
+        }
+    } else {
+        ::obake::detail::ignore(ss);
+    }
+}
+
+// Sink for the output of the multi-threaded homomorphic
+// multiplication which keeps the whole product in memory.
+// A sink is first prepared via the default number of segments
+// (in log2 units), the estimated size in bytes of the product
+// and the maximum number of segments, returning the number
+// of segments to be used. Then, it drives the computation of
+// the segments via the functor run, which computes the
+// segments in a half-open range.
+struct poly_mul_mem_sink {
+    unsigned prepare(unsigned l, const ::mppp::integer<1> &est_bytes, unsigned) const
+    {
+        // Fail early if the product is not
+        // going to fit in the memory budget.
+        const auto budget = ::obake::get_memory_budget();
+        if (obake_unlikely(budget != 0u && est_bytes > budget)) {
+            obake_throw(::std::length_error, "The estimated memory footprint of a polynomial multiplication ("
+                                                 + est_bytes.to_string()
+                                                 + " bytes) exceeds the memory budget ("
+                                                 + ::obake::detail::to_string(budget) + " bytes)");
+        }
+
+        return l;
+    }
+    template <typename Ret, typename F>
+    void operator()(Ret &, typename Ret::s_size_type nsegs, const ::mppp::integer<1> &, const F &run) const
+    {
+        run(0, nsegs);
+    }
+};
+
+// The multi-threaded homomorphic implementation, operating
+// on the vectors of terms v1 and v2 (which will be modified).
+// T and U are the types of the polynomials from which
+// the terms originate. The profile is delivered via prof
+// upon successful completion.
+template <typename T, typename U, typename Ret, typename V1, typename V2, typename Sink, typename... Args>
+inline void poly_mul_impl_mt_hm_terms(Ret &retval, V1 &v1, V2 &v2, const Sink &sink, mul_profiler &prof,
+                                      const Args &... args)
 {
     using cf1_t = series_cf_t<T>;
     using cf2_t = series_cf_t<U>;
@@ -809,59 +900,32 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
 
     // Preconditions.
     static_assert(sizeof...(args) <= 2u);
-    assert(!x.empty());
-    assert(!y.empty());
-    assert(x.size() <= y.size());
-    assert(retval.get_symbol_set() == x.get_symbol_set());
-    assert(retval.get_symbol_set() == y.get_symbol_set());
+    assert(!v1.empty());
+    assert(!v2.empty());
+    assert(v1.size() <= v2.size());
     assert(retval.empty());
     assert(retval._get_s_table().size() == 1u);
 
     // Cache the symbol set.
     const auto &ss = retval.get_symbol_set();
 
-    // Create vectors containing copies of
-    // the input terms.
-    // NOTE: in theory, it would be possible here
-    // to move the coefficients (in conjunction with
-    // rref_cleaner, as usual).
-    // NOTE: drop the const from the key type in order
-    // to allow mutability.
-    // NOTE: need to better assess the benefits of
-    // copying the input series.
-    ::std::vector<::std::pair<series_key_t<T>, cf1_t>> v1(
-        ::boost::make_transform_iterator(x.begin(), poly_mul_impl_pair_transform{}),
-        ::boost::make_transform_iterator(x.end(), poly_mul_impl_pair_transform{}));
-    ::std::vector<::std::pair<series_key_t<U>, cf2_t>> v2(
-        ::boost::make_transform_iterator(y.begin(), poly_mul_impl_pair_transform{}),
-        ::boost::make_transform_iterator(y.end(), poly_mul_impl_pair_transform{}));
-
     // Do the monomial overflow checking, if supported.
     // NOTE: we have to sequence the overflow checking before the product
     // size estimation and the average term size estimation, as those two
     // operations might generate overflows during monomial multiplication.
-    const auto r1
-        = ::obake::detail::make_range(::boost::make_transform_iterator(v1.cbegin(), poly_term_key_ref_extractor{}),
-                                      ::boost::make_transform_iterator(v1.cend(), poly_term_key_ref_extractor{}));
-    const auto r2
-        = ::obake::detail::make_range(::boost::make_transform_iterator(v2.cbegin(), poly_term_key_ref_extractor{}),
-                                      ::boost::make_transform_iterator(v2.cend(), poly_term_key_ref_extractor{}));
-    if constexpr (are_overflow_testable_monomial_ranges_v<decltype(r1) &, decltype(r2) &>) {
-        // The monomial overflow checking is supported, run it.
-        if (obake_unlikely(!::obake::monomial_range_overflow_check(r1, r2, ss))) {
-            obake_throw(::std::overflow_error, "An overflow in the monomial exponents was detected while "
-                                               "attempting to multiply two polynomials");
-        }
-    }
+    prof.begin(mul_phase::overflow_check);
+    detail::poly_mul_impl_overflow_check(v1, v2, ss);
 
     // Estimate the total number of terms, and compute the total number
     // of term-by-term multiplications.
     // NOTE: poly_mul_estimate_product_size() requires the shorter series first,
     // which is ensured by the preconditions of this function.
+    prof.begin(mul_phase::estimate);
     const auto [est_nterms, tot_n_mults] = detail::poly_mul_estimate_product_size<T, U>(v1, v2, ss, args...);
     // Exit early if the truncation limits
     // result in an empty output series.
     if (sizeof...(Args) > 0u && tot_n_mults.is_zero()) {
+        prof.finish();
         return;
     }
 
@@ -902,14 +966,19 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
 
     // Fetch the base-2 logarithm + 1 of est_nsegs, making sure it does not
     // overflow the max allowed value for the return polynomial type.
-    const auto log2_nsegs = ::std::min(::obake::safe_cast<unsigned>(est_nsegs.nbits()),
-                                       polynomial<ret_key_t, ret_cf_t>::get_max_s_size());
+    // The sink may then adjust it (or refuse to go on).
+    const auto max_log2_nsegs = polynomial<ret_key_t, ret_cf_t>::get_max_s_size();
+    const auto est_bytes = est_nterms * avg_term_size;
+    const auto log2_nsegs = sink.prepare(
+        ::std::min(::obake::safe_cast<unsigned>(est_nsegs.nbits()), max_log2_nsegs), est_bytes, max_log2_nsegs);
 
     // Setup the number of segments in retval.
     retval.set_n_segments(log2_nsegs);
 
     // Cache the actual number of segments.
     const auto nsegs = s_size_t(1) << log2_nsegs;
+    prof.end();
+    prof.set_n_segments(static_cast<::std::size_t>(nsegs));
 
     // Helper to sort the input terms according to the hash value modulo
     // 2**log2_nsegs. That is, sort them according to the bucket
@@ -1121,25 +1190,39 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
     // - compute the degrees of the terms and sort according
     //   to the degree within each segment (only for truncated
     //   multiplication).
+    // NOTE: the sorting/segmentation times are used only
+    // when profiling.
+    ::std::array<double, 2> sort_times{}, seg_times{};
     ::tbb::parallel_invoke(
-        [&v1, t_sorter, &vseg1, compute_vseg, &degree_data, seg_sorter]() {
+        [&v1, t_sorter, &vseg1, compute_vseg, &degree_data, seg_sorter, &sort_times, &seg_times]() {
+            mul_profiler::section sec;
             ::tbb::parallel_sort(v1.begin(), v1.end(), t_sorter);
+            sort_times[0] = sec.stop();
             vseg1 = compute_vseg(v1);
+            seg_times[0] = sec.stop();
             if constexpr (sizeof...(Args) > 0u) {
                 ::std::get<0>(degree_data) = seg_sorter(v1, ::obake::detail::type_c<T>{}, vseg1);
+                sort_times[0] += sec.stop();
             } else {
                 ::obake::detail::ignore(degree_data, seg_sorter);
             }
         },
-        [&v2, t_sorter, &vseg2, compute_vseg, &degree_data, seg_sorter]() {
+        [&v2, t_sorter, &vseg2, compute_vseg, &degree_data, seg_sorter, &sort_times, &seg_times]() {
+            mul_profiler::section sec;
             ::tbb::parallel_sort(v2.begin(), v2.end(), t_sorter);
+            sort_times[1] = sec.stop();
             vseg2 = compute_vseg(v2);
+            seg_times[1] = sec.stop();
             if constexpr (sizeof...(Args) > 0u) {
                 ::std::get<1>(degree_data) = seg_sorter(v2, ::obake::detail::type_c<U>{}, vseg2);
+                sort_times[1] += sec.stop();
             } else {
                 ::obake::detail::ignore(degree_data, seg_sorter);
             }
         });
+    // NOTE: x and y are processed concurrently, record the slowest.
+    prof.add(mul_phase::sort, ::std::max(sort_times[0], sort_times[1]));
+    prof.add(mul_phase::segment, ::std::max(seg_times[0], seg_times[1]));
 
 #if !defined(NDEBUG)
     {
@@ -1246,7 +1329,7 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
 
     // The parallel multiplication functor for the sparse case.
     auto sparse_par_functor
-        = [&v1, &v2, &vseg1, &vseg2, nsegs, &retval, &ss, mts = retval._get_max_table_size(), &compute_end_idx2
+        = [&v1, &v2, &vseg1, &vseg2, nsegs, &retval, &ss, mts = retval._get_max_table_size(), &compute_end_idx2, &prof
 #if !defined(NDEBUG)
            ,
            log2_nsegs, &n_mults
@@ -1264,10 +1347,17 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
               // Cache begin/end interators into vseg2.
               const auto vseg2_begin = vseg2.begin(), vseg2_end = vseg2.end();
 
+              mul_profiler::section busy;
+
               for (auto seg_idx = range.begin(); seg_idx != range.end(); ++seg_idx) {
                   // Get a reference to the current table in retval.
                   auto &table = retval._get_s_table()[seg_idx];
 
+                  // Statistics for the current segment (used only
+                  // when profiling).
+                  mul_segment_profile sp;
+                  mul_profiler::section sec;
+
                   // The iterator in vseg2 that we will use
                   // as the end point in the binary search below.
                   // Initially, it is just the end of vseg2
@@ -1378,6 +1468,10 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                               if (res.second) {
                                   // NOTE: coefficients are guaranteed to be move-assignable.
                                   res.first->second = c1 * c2;
+
+                                  if constexpr (mul_profiling_enabled) {
+                                      ++sp.n_insertions;
+                                  }
                               } else {
                                   // The insertion failed, a term with the same monomial
                                   // exists already. Accumulate c1*c2 into the
@@ -1388,6 +1482,10 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                                   } else {
                                       res.first->second += c1 * c2;
                                   }
+
+                                  if constexpr (mul_profiling_enabled) {
+                                      ++sp.n_collisions;
+                                  }
                               }
 
 #if !defined(NDEBUG)
@@ -1397,6 +1495,8 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                       }
                   }
 
+                  sp.mult_time = sec.stop();
+
                   // Locate and erase terms with zero coefficients
                   // in the current table.
                   const auto it_f = table.end();
@@ -1407,11 +1507,19 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                       // any other iterator apart from the one being erased.
                       if (obake_unlikely(::obake::is_zero(::std::as_const(it->second)))) {
                           table.erase(it++);
+
+                          if constexpr (mul_profiling_enabled) {
+                              ++sp.n_erased;
+                          }
                       } else {
                           ++it;
                       }
                   }
 
+                  sp.cleanup_time = sec.stop();
+                  sp.n_mults = sp.n_insertions + sp.n_collisions;
+                  prof.record_segment(static_cast<::std::size_t>(seg_idx), sp);
+
                   // LCOV_EXCL_START
                   // Check the table size against the max allowed size.
                   if (obake_unlikely(table.size() > mts)) {
@@ -1423,11 +1531,13 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                   }
                   // LCOV_EXCL_STOP
               }
+
+              prof.add_busy_time(busy.stop());
           };
 
     // The parallel multiplication functor for the dense case.
     auto dense_par_functor
-        = [&v1, &v2, &vseg1, &vseg2, nsegs, &retval, &ss, mts = retval._get_max_table_size(), &compute_end_idx2
+        = [&v1, &v2, &vseg1, &vseg2, nsegs, &retval, &ss, mts = retval._get_max_table_size(), &compute_end_idx2, &prof
 #if !defined(NDEBUG)
            ,
            log2_nsegs, &n_mults
@@ -1442,10 +1552,17 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
               // Temporary variable used in monomial multiplication.
               ret_key_t tmp_key(ss);
 
+              mul_profiler::section busy;
+
               for (auto seg_idx = range.begin(); seg_idx != range.end(); ++seg_idx) {
                   // Get a reference to the current table in retval.
                   auto &table = retval._get_s_table()[seg_idx];
 
+                  // Statistics for the current segment (used only
+                  // when profiling).
+                  mul_segment_profile sp;
+                  mul_profiler::section sec;
+
                   // The objective here is to perform all term-by-term multiplications
                   // whose results end up in the current table (i.e., the table in retval
                   // at index seg_idx). Due to homomorphic hashing, we know that,
@@ -1521,6 +1638,10 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                               if (res.second) {
                                   // NOTE: coefficients are guaranteed to be move-assignable.
                                   res.first->second = c1 * c2;
+
+                                  if constexpr (mul_profiling_enabled) {
+                                      ++sp.n_insertions;
+                                  }
                               } else {
                                   // The insertion failed, a term with the same monomial
                                   // exists already. Accumulate c1*c2 into the
@@ -1531,6 +1652,10 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                                   } else {
                                       res.first->second += c1 * c2;
                                   }
+
+                                  if constexpr (mul_profiling_enabled) {
+                                      ++sp.n_collisions;
+                                  }
                               }
 
 #if !defined(NDEBUG)
@@ -1540,6 +1665,8 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                       }
                   }
 
+                  sp.mult_time = sec.stop();
+
                   // Locate and erase terms with zero coefficients
                   // in the current table.
                   const auto it_f = table.end();
@@ -1550,11 +1677,19 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                       // any other iterator apart from the one being erased.
                       if (obake_unlikely(::obake::is_zero(::std::as_const(it->second)))) {
                           table.erase(it++);
+
+                          if constexpr (mul_profiling_enabled) {
+                              ++sp.n_erased;
+                          }
                       } else {
                           ++it;
                       }
                   }
 
+                  sp.cleanup_time = sec.stop();
+                  sp.n_mults = sp.n_insertions + sp.n_collisions;
+                  prof.record_segment(static_cast<::std::size_t>(seg_idx), sp);
+
                   // LCOV_EXCL_START
                   // Check the table size against the max allowed size.
                   if (obake_unlikely(table.size() > mts)) {
@@ -1566,25 +1701,33 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
                   }
                   // LCOV_EXCL_STOP
               }
+
+              prof.add_busy_time(busy.stop());
           };
 
-    try {
+    // Compute the segments of retval in the range [begin, end).
+    auto run = [&vseg1, &vseg2, nsegs, &dense_par_functor, &sparse_par_functor](s_size_t begin, s_size_t end) {
         if (vseg1.size() == nsegs && vseg2.size() == nsegs) {
             // Both vseg1 and vseg2 are represented in dense
             // form, run the dense functor.
-            ::tbb::parallel_for(::tbb::blocked_range<s_size_t>(0, nsegs), dense_par_functor);
+            ::tbb::parallel_for(::tbb::blocked_range<s_size_t>(begin, end), dense_par_functor);
         } else {
             // At least one of vseg1/vseg2 are represented
             // in sparse form, run the sparse functor.
-            ::tbb::parallel_for(::tbb::blocked_range<s_size_t>(0, nsegs), sparse_par_functor);
+            ::tbb::parallel_for(::tbb::blocked_range<s_size_t>(begin, end), sparse_par_functor);
         }
+    };
+
+    try {
+        sink(retval, nsegs, est_bytes, run);
+        prof.finish();
 
 #if !defined(NDEBUG)
         // Verify the number of term multiplications we performed,
         // but only if we are in non-truncated mode.
         if constexpr (sizeof...(args) == 0u) {
             assert(n_mults.load()
-                   == static_cast<unsigned long long>(x.size()) * static_cast<unsigned long long>(y.size()));
+                   == static_cast<unsigned long long>(v1.size()) * static_cast<unsigned long long>(v2.size()));
         }
 #endif
         // LCOV_EXCL_START
@@ -1603,6 +1746,39 @@ inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args
 
 #endif
 
+// The multi-threaded homomorphic implementation.
+template <typename Ret, typename T, typename U, typename... Args>
+inline void poly_mul_impl_mt_hm(Ret &retval, const T &x, const U &y, const Args &... args)
+{
+    // Preconditions.
+    assert(!x.empty());
+    assert(!y.empty());
+    assert(x.size() <= y.size());
+    assert(retval.get_symbol_set() == x.get_symbol_set());
+    assert(retval.get_symbol_set() == y.get_symbol_set());
+
+    mul_profiler prof("mt_hm");
+
+    // Create vectors containing copies of
+    // the input terms.
+    prof.begin(mul_phase::copy);
+    // NOTE: in theory, it would be possible here
+    // to move the coefficients (in conjunction with
+    // rref_cleaner, as usual).
+    // NOTE: drop the const from the key type in order
+    // to allow mutability.
+    // NOTE: need to better assess the benefits of
+    // copying the input series.
+    ::std::vector<::std::pair<series_key_t<T>, series_cf_t<T>>> v1(
+        ::boost::make_transform_iterator(x.begin(), poly_mul_impl_pair_transform{}),
+        ::boost::make_transform_iterator(x.end(), poly_mul_impl_pair_transform{}));
+    ::std::vector<::std::pair<series_key_t<U>, series_cf_t<U>>> v2(
+        ::boost::make_transform_iterator(y.begin(), poly_mul_impl_pair_transform{}),
+        ::boost::make_transform_iterator(y.end(), poly_mul_impl_pair_transform{}));
+
+    detail::poly_mul_impl_mt_hm_terms<T, U>(retval, v1, v2, poly_mul_mem_sink{}, prof, args...);
+}
+
 // Extract a pointer from a const reference.
 struct poly_mul_impl_ptr_extractor {
     template <typename T>
@@ -1636,7 +1812,10 @@ inline void poly_mul_impl_simple(Ret &retval, const T &x, const U &y, const Args
     // Cache the symbol set.
     const auto &ss = retval.get_symbol_set();
 
+    mul_profiler prof("simple");
+
     // Construct the vectors of pointer to the terms.
+    prof.begin(mul_phase::copy);
     ::std::vector<const series_term_t<T> *> v1(
         ::boost::make_transform_iterator(x.begin(), poly_mul_impl_ptr_extractor{}),
         ::boost::make_transform_iterator(x.end(), poly_mul_impl_ptr_extractor{}));
@@ -1645,20 +1824,12 @@ inline void poly_mul_impl_simple(Ret &retval, const T &x, const U &y, const Args
         ::boost::make_transform_iterator(y.end(), poly_mul_impl_ptr_extractor{}));
 
     // Do the monomial overflow checking, if possible.
-    const auto r1
-        = ::obake::detail::make_range(::boost::make_transform_iterator(v1.cbegin(), poly_term_key_ref_extractor{}),
-                                      ::boost::make_transform_iterator(v1.cend(), poly_term_key_ref_extractor{}));
-    const auto r2
-        = ::obake::detail::make_range(::boost::make_transform_iterator(v2.cbegin(), poly_term_key_ref_extractor{}),
-                                      ::boost::make_transform_iterator(v2.cend(), poly_term_key_ref_extractor{}));
-    if constexpr (are_overflow_testable_monomial_ranges_v<decltype(r1) &, decltype(r2) &>) {
-        // Do the monomial overflow checking.
-        if (obake_unlikely(!::obake::monomial_range_overflow_check(r1, r2, ss))) {
-            obake_throw(
-                ::std::overflow_error,
-                "An overflow in the monomial exponents was detected while attempting to multiply two polynomials");
-        }
-    }
+    prof.begin(mul_phase::overflow_check);
+    detail::poly_mul_impl_overflow_check(v1, v2, ss);
+
+    // NOTE: in the truncated case, the sorting
+    // of the terms happens in compute_j_end.
+    prof.begin(mul_phase::sort);
 
     // This functor will be used to compute the
     // upper limit of the j index (in the usual half-open
@@ -1802,12 +1973,19 @@ inline void poly_mul_impl_simple(Ret &retval, const T &x, const U &y, const Args
     }();
 
     // Proceed with the multiplication.
+    prof.end();
+    prof.set_n_segments(1);
     auto &tab = retval._get_s_table()[0];
 
     try {
         // Temporary variable used in monomial multiplication.
         ret_key_t tmp_key(ss);
 
+        // Statistics for the multiplication (used only
+        // when profiling).
+        mul_segment_profile sp;
+        mul_profiler::section sec;
+
         const auto v1_size = v1.size();
         for (decltype(v1.size()) i = 0; i < v1_size; ++i) {
             const auto &t1 = v1[i];
@@ -1840,6 +2018,10 @@ inline void poly_mul_impl_simple(Ret &retval, const T &x, const U &y, const Args
                 // NOTE: optimise with likely/unlikely here?
                 if (res.second) {
                     res.first->second = c1 * c2;
+
+                    if constexpr (mul_profiling_enabled) {
+                        ++sp.n_insertions;
+                    }
                 } else {
                     // The insertion failed, accumulate c1*c2 into the
                     // existing coefficient.
@@ -1849,10 +2031,16 @@ inline void poly_mul_impl_simple(Ret &retval, const T &x, const U &y, const Args
                     } else {
                         res.first->second += c1 * c2;
                     }
+
+                    if constexpr (mul_profiling_enabled) {
+                        ++sp.n_collisions;
+                    }
                 }
             }
         }
 
+        sp.mult_time = sec.stop();
+
         // Determine and remove the keys whose coefficients are zero
         // in the return value.
         const auto it_f = tab.end();
@@ -1863,11 +2051,21 @@ inline void poly_mul_impl_simple(Ret &retval, const T &x, const U &y, const Args
             // any other iterator apart from the one being erased.
             if (obake_unlikely(::obake::is_zero(::std::as_const(it->second)))) {
                 tab.erase(it++);
+
+                if constexpr (mul_profiling_enabled) {
+                    ++sp.n_erased;
+                }
             } else {
                 ++it;
             }
         }
 
+        sp.cleanup_time = sec.stop();
+        sp.n_mults = sp.n_insertions + sp.n_collisions;
+        prof.record_segment(0, sp);
+        prof.add_busy_time(sp.mult_time + sp.cleanup_time);
+        prof.finish();
+
         // NOTE: no need to check the table size, as retval
         // is not segmented.
         // LCOV_EXCL_START
@@ -2042,102 +2240,593 @@ inline detail::poly_mul_ret_t<T &&, U &&> series_mul(T &&x, U &&y)
 namespace detail
 {
 
-// Metaprogramming to establish if we can perform
-// truncated total/partial degree multiplication on the
-// polynomial operands T and U with degree limit of type V.
-// NOTE: at this time, truncated multiplication is implemented
-// only if only the key is with degree.
-template <typename T, typename U, typename V, bool Total>
-constexpr auto poly_mul_truncated_degree_algorithm_impl()
+// Helpers for the multiplication of polynomials in which
+// one or both operands are series views.
+template <typename T>
+inline auto poly_view_mul_term_vector(const T &x)
 {
-    // Check first if we can do the untruncated multiplication. If we cannot,
-    // truncated mult is not possible.
-    if constexpr (poly_mul_algo<T, U> == 0) {
-        return 0;
+    if constexpr (is_series_view_v<T>) {
+        return x.to_term_vector();
     } else {
-        // Check if we can compute the degree of the terms via the default
-        // implementation for series.
-        using d_impl = ::std::conditional_t<Total, customisation::internal::series_default_degree_impl,
-                                            customisation::internal::series_default_p_degree_impl>;
-        constexpr auto algo1 = d_impl::template algo<T>;
-        constexpr auto algo2 = d_impl::template algo<U>;
+        return ::std::vector<::std::pair<series_key_t<T>, series_cf_t<T>>>(
+            ::boost::make_transform_iterator(x.begin(), poly_mul_impl_pair_transform{}),
+            ::boost::make_transform_iterator(x.end(), poly_mul_impl_pair_transform{}));
+    }
+}
 
-        // NOTE: algo == 3 means that only the key is with degree.
-        if constexpr (algo1 == 3 && algo2 == 3) {
-            // Fetch the degree types.
-            using deg1_t = typename d_impl::template ret_t<T>;
-            using deg2_t = typename d_impl::template ret_t<U>;
+template <typename T>
+inline ::std::size_t poly_view_mul_byte_size(const T &x)
+{
+    if constexpr (is_series_view_v<T>) {
+        return x.file_size();
+    } else {
+        return ::obake::byte_size(x);
+    }
+}
 
-            // The degree types need to be:
-            // - copy/move ctible (need to handle vectors of them, note that
-            //   in the series default degree machinery we check for returnability,
-            //   but here we need explicitly both copy and move ctible),
-            // - addable via const lref,
-            // - V must be lt-comparable to the type of their sum via const lrefs.
-            using deg_add_t = detected_t<::obake::detail::add_t, const deg1_t &, const deg2_t &>;
+template <typename T>
+inline decltype(auto) poly_view_mul_materialise(const T &x)
+{
+    if constexpr (is_series_view_v<T>) {
+        return x.to_series();
+    } else {
+        return x;
+    }
+}
 
-            return static_cast<int>(::std::conjunction_v<
-                                    // NOTE: this will ensure that switching around
-                                    // the degree operands still works and produces the same
-                                    // type. This is necessary because in the poly moltiplication
-                                    // function we might end up swapping the operands.
-                                    // NOTE: this will also verify that deg_add_t is present.
-                                    is_addable<const deg1_t &, const deg2_t &>, ::std::is_copy_constructible<deg1_t>,
-                                    ::std::is_copy_constructible<deg2_t>, ::std::is_move_constructible<deg1_t>,
-                                    ::std::is_move_constructible<deg2_t>,
-                                    // NOTE: in the implementation functions, we always compare
-                                    // an lvalue ref to the limit V to an rvalue resulting
-                                    // from adding the degrees of one term from each series.
-                                    is_less_than_comparable<::std::add_lvalue_reference_t<const V>, deg_add_t>>);
-        } else {
-            return 0;
-        }
+// Load x into memory (if needed) as a polynomial whose
+// symbol set is merged_ss, with the insertion map ins_map.
+template <typename T, typename Map>
+inline auto poly_view_mul_extend(const T &x, const symbol_set &merged_ss, const Map &ins_map)
+{
+    remove_cvref_t<decltype(detail::poly_view_mul_materialise(x))> retval;
+    retval.set_symbol_set(merged_ss);
+    if (ins_map.empty()) {
+        retval = detail::poly_view_mul_materialise(x);
+    } else {
+        ::obake::detail::series_sym_extender(retval, detail::poly_view_mul_materialise(x), ins_map);
     }
+
+    return retval;
 }
 
-template <typename T, typename U, typename V>
-inline constexpr auto poly_mul_truncated_degree_algo
-    = detail::poly_mul_truncated_degree_algorithm_impl<T, U, V, true>();
+// Multiplication of the polynomials x and y, at least one of which
+// is a view. P1 and P2 are the corresponding polynomial types.
+template <typename P1, typename P2, typename T, typename U>
+inline poly_mul_ret_t<const P1 &, const P2 &> poly_view_mul_impl(const T &x, const U &y)
+{
+    using ret_t = poly_mul_ret_t<const P1 &, const P2 &>;
+    using ret_key_t = series_key_t<ret_t>;
 
-template <typename T, typename U, typename V>
-inline constexpr auto poly_mul_truncated_p_degree_algo
-    = detail::poly_mul_truncated_degree_algorithm_impl<T, U, V, false>();
+    if constexpr (::std::conjunction_v<is_homomorphically_hashable_monomial<ret_key_t>,
+                                       is_size_measurable<const P1 &>, is_size_measurable<const P2 &>,
+                                       is_size_measurable<const ret_key_t &>,
+                                       is_size_measurable<const series_cf_t<ret_t> &>>) {
+        // NOTE: same criteria as in poly_mul_impl_identical_ss(),
+        // with the size of the file standing in for the byte size
+        // of a view.
+        if (x.get_symbol_set() == y.get_symbol_set() && !x.empty() && !y.empty() && ::obake::detail::hc() != 1u
+            && !(x.size() == 1u && y.size() == 1u)
+            && ::std::max(detail::poly_view_mul_byte_size(x), detail::poly_view_mul_byte_size(y)) >= 30000ul) {
+            // Decode the terms of the views (in parallel) straight
+            // into the vectors used by the MT implementation, thus
+            // bypassing the construction of the hash tables.
+            ret_t retval;
+            retval.set_symbol_set(x.get_symbol_set());
+
+            mul_profiler prof("mt_hm");
+            prof.begin(mul_phase::copy);
+
+            auto v1 = detail::poly_view_mul_term_vector(x);
+            auto v2 = detail::poly_view_mul_term_vector(y);
+
+            if (v1.size() <= v2.size()) {
+                detail::poly_mul_impl_mt_hm_terms<P1, P2>(retval, v1, v2, poly_mul_mem_sink{}, prof);
+            } else {
+                detail::poly_mul_impl_mt_hm_terms<P2, P1>(retval, v2, v1, poly_mul_mem_sink{}, prof);
+            }
+
+            return retval;
+        }
+    }
+
+    // Otherwise, the operands are small, the symbol sets
+    // differ or homomorphic hashing is not available: load the
+    // views into memory and run the standard implementation.
+    return detail::poly_view_mul_materialise(x) * detail::poly_view_mul_materialise(y);
+}
+
+template <typename K, typename C1, typename C2>
+using poly_view_mul_enabler
+    = ::std::enable_if_t<poly_mul_algo<const polynomial<K, C1> &, const polynomial<K, C2> &> != 0, int>;
 
 } // namespace detail
 
-// Truncated multiplication.
-// NOTE: do we need the type traits/concepts as well?
-// NOTE: should these be function objects?
-template <typename T, typename U, typename V,
-          ::std::enable_if_t<detail::poly_mul_truncated_degree_algo<T &&, U &&, V> != 0, int> = 0>
-inline detail::poly_mul_ret_t<T &&, U &&> truncated_mul(T &&x, U &&y, const V &max_degree)
+// Multiplication with series views as operands.
+template <typename K, typename C1, typename C2, detail::poly_view_mul_enabler<K, C1, C2> = 0>
+inline detail::poly_mul_ret_t<const polynomial<K, C1> &, const polynomial<K, C2> &>
+operator*(const series_view<K, C1, tag> &x, const polynomial<K, C2> &y)
 {
-    return detail::poly_mul_impl_switch(::std::forward<T>(x), ::std::forward<U>(y), max_degree);
+    return detail::poly_view_mul_impl<polynomial<K, C1>, polynomial<K, C2>>(x, y);
 }
 
-template <typename T, typename U, typename V,
-          ::std::enable_if_t<detail::poly_mul_truncated_p_degree_algo<T &&, U &&, V> != 0, int> = 0>
-inline detail::poly_mul_ret_t<T &&, U &&> truncated_mul(T &&x, U &&y, const V &max_degree, const symbol_set &s)
+template <typename K, typename C1, typename C2, detail::poly_view_mul_enabler<K, C1, C2> = 0>
+inline detail::poly_mul_ret_t<const polynomial<K, C1> &, const polynomial<K, C2> &>
+operator*(const polynomial<K, C1> &x, const series_view<K, C2, tag> &y)
 {
-    return detail::poly_mul_impl_switch(::std::forward<T>(x), ::std::forward<U>(y), max_degree, s);
+    return detail::poly_view_mul_impl<polynomial<K, C1>, polynomial<K, C2>>(x, y);
+}
+
+template <typename K, typename C1, typename C2, detail::poly_view_mul_enabler<K, C1, C2> = 0>
+inline detail::poly_mul_ret_t<const polynomial<K, C1> &, const polynomial<K, C2> &>
+operator*(const series_view<K, C1, tag> &x, const series_view<K, C2, tag> &y)
+{
+    return detail::poly_view_mul_impl<polynomial<K, C1>, polynomial<K, C2>>(x, y);
 }
 
 namespace detail
 {
 
-// Machinery to enable the pow() specialisation for polynomials.
-template <typename T, typename U>
-constexpr auto poly_pow_algorithm_impl()
+// Sink for the multi-threaded homomorphic multiplication which
+// computes the product in groups of segments whose estimated size
+// fits in a memory budget. Each group of finished segments is
+// encoded in the native serialisation format, written to the
+// output stream and then freed, before moving to the next group.
+template <typename K, typename C>
+class poly_mul_spill_sink
 {
-    if constexpr (is_polynomial_v<remove_cvref_t<T>>) {
-        return customisation::internal::series_default_pow_impl::algo<T, U>;
-    } else {
-        return 0;
+public:
+    explicit poly_mul_spill_sink(::std::ostream &os, ::std::size_t mem_budget, native_s11n_mode mode)
+        : m_os(&os), m_mem_budget(mem_budget), m_mode(mode)
+    {
+        assert(mem_budget > 0u);
     }
-}
 
-template <typename T, typename U>
-inline constexpr auto poly_pow_algo = detail::poly_pow_algorithm_impl<T, U>();
+    // Increase the number of segments until the estimated
+    // size of a single segment fits in the budget.
+    unsigned prepare(unsigned l, const ::mppp::integer<1> &est_bytes, unsigned max_l) const
+    {
+        while (l < max_l && est_bytes > (::mppp::integer<1>{m_mem_budget} << l)) {
+            ++l;
+        }
+
+        return l;
+    }
+
+    template <typename Ret, typename F>
+    void operator()(Ret &retval, typename Ret::s_size_type nsegs, const ::mppp::integer<1> &est_bytes,
+                    const F &run) const
+    {
+        using s_size_t = typename Ret::s_size_type;
+
+        auto &s_table = retval._get_s_table();
+        const auto &ss = retval.get_symbol_set();
+        auto &os = *m_os;
+
+        // Number of segments in each group.
+        // NOTE: if est_bytes is not finite or the estimate
+        // is empty, process everything in a single group.
+        const auto seg_bytes = static_cast<double>(est_bytes) / static_cast<double>(nsegs);
+        const auto gsize = (!::std::isfinite(seg_bytes) || !(seg_bytes > 0))
+                               ? nsegs
+                               : static_cast<s_size_t>(::std::clamp(
+                                   ::std::floor(static_cast<double>(m_mem_budget) / seg_bytes), 1.,
+                                   static_cast<double>(nsegs)));
+
+        ::obake::detail::series_native_stream_writer<K, C> w(os, ss, retval.get_s_size(), m_mode);
+
+        for (s_size_t begin = 0; begin < nsegs;) {
+            const auto end = (nsegs - begin > gsize) ? (begin + gsize) : nsegs;
+
+            // Compute the segments in the group, then encode
+            // and write them out, releasing the memory of the
+            // tables as soon as possible.
+            run(begin, end);
+            w.template write_segments<true>(s_table, static_cast<::std::size_t>(begin),
+                                            static_cast<::std::size_t>(end));
+
+            begin = end;
+        }
+
+        w.finish();
+
+        if (obake_unlikely(!os)) {
+            obake_throw(::std::runtime_error,
+                        "An error occurred while writing the result of an out-of-core polynomial multiplication");
+        }
+    }
+
+private:
+    ::std::ostream *m_os;
+    ::std::size_t m_mem_budget;
+    native_s11n_mode m_mode;
+};
+
+// The polynomial type corresponding to an operand
+// of out_of_core_mul() (either a polynomial or a
+// polynomial view).
+template <typename T>
+struct poly_ooc_mul_operand {
+    using type = void;
+};
+
+template <typename K, typename C>
+struct poly_ooc_mul_operand<polynomial<K, C>> {
+    using type = polynomial<K, C>;
+};
+
+template <typename K, typename C>
+struct poly_ooc_mul_operand<series_view<K, C, tag>> {
+    using type = polynomial<K, C>;
+};
+
+template <typename T>
+using poly_ooc_mul_operand_t = typename poly_ooc_mul_operand<T>::type;
+
+// Metaprogramming for out_of_core_mul().
+template <typename T, typename U>
+constexpr auto poly_ooc_mul_algorithm_impl()
+{
+    [[maybe_unused]] constexpr auto failure = ::std::make_pair(0, ::obake::detail::type_c<void>{});
+
+    using p1_t = poly_ooc_mul_operand_t<T>;
+    using p2_t = poly_ooc_mul_operand_t<U>;
+
+    if constexpr (::std::disjunction_v<::std::is_same<p1_t, void>, ::std::is_same<p2_t, void>>) {
+        return failure;
+    } else if constexpr (poly_mul_algo<const p1_t &, const p2_t &> == 0) {
+        return failure;
+    } else {
+        using ret_t = poly_mul_ret_t<const p1_t &, const p2_t &>;
+
+        // The product is computed via the multi-threaded
+        // homomorphic implementation, and it must be
+        // serialisable in the native format.
+        if constexpr (::std::conjunction_v<is_homomorphically_hashable_monomial<series_key_t<ret_t>>,
+                                           ::obake::detail::is_native_s11n<ret_t>>) {
+            return ::std::make_pair(
+                1, ::obake::detail::type_c<series_view<series_key_t<ret_t>, series_cf_t<ret_t>, tag>>{});
+        } else {
+            return failure;
+        }
+    }
+}
+
+template <typename T, typename U>
+inline constexpr auto poly_ooc_mul_algorithm = detail::poly_ooc_mul_algorithm_impl<T, U>();
+
+template <typename T, typename U>
+inline constexpr int poly_ooc_mul_algo = poly_ooc_mul_algorithm<T, U>.first;
+
+template <typename T, typename U>
+using poly_ooc_mul_ret_t = typename decltype(poly_ooc_mul_algorithm<T, U>.second)::type;
+
+} // namespace detail
+
+// Out-of-core polynomial multiplication. The product of x and y
+// (each either a polynomial or a polynomial view) is computed in
+// groups of segments whose estimated size fits in mem_budget bytes.
+// The finished segments are written to filename in the native
+// serialisation format, and a view on the result is returned.
+// NOTE: the budget accounts only for the product, not for the
+// copies of the input terms.
+template <typename T, typename U, ::std::enable_if_t<detail::poly_ooc_mul_algo<T, U> != 0, int> = 0>
+inline detail::poly_ooc_mul_ret_t<T, U> out_of_core_mul(const T &x, const U &y, const ::std::string &filename,
+                                                        ::std::size_t mem_budget,
+                                                        native_s11n_mode mode = native_s11n_mode::plain)
+{
+    using p1_t = detail::poly_ooc_mul_operand_t<T>;
+    using p2_t = detail::poly_ooc_mul_operand_t<U>;
+    using ret_t = detail::poly_mul_ret_t<const p1_t &, const p2_t &>;
+
+    if (obake_unlikely(mem_budget == 0u)) {
+        obake_throw(::std::invalid_argument,
+                    "Cannot perform an out-of-core polynomial multiplication with a null memory budget");
+    }
+
+    if (x.get_symbol_set() != y.get_symbol_set()) {
+        // Extend the operands to the merged symbol set.
+        // NOTE: this requires loading views into memory.
+        const auto &[merged_ss, ins_map_x, ins_map_y]
+            = ::obake::detail::merge_symbol_sets(x.get_symbol_set(), y.get_symbol_set());
+
+        return polynomials::out_of_core_mul(detail::poly_view_mul_extend(x, merged_ss, ins_map_x),
+                                            detail::poly_view_mul_extend(y, merged_ss, ins_map_y), filename,
+                                            mem_budget, mode);
+    }
+
+    ret_t retval;
+    retval.set_symbol_set(x.get_symbol_set());
+
+    {
+        ::std::ofstream ofs(filename, ::std::ios::binary | ::std::ios::trunc);
+        if (obake_unlikely(!ofs.is_open())) {
+            obake_throw(::std::runtime_error, "Cannot open the file '" + filename + "' for writing");
+        }
+
+        try {
+            if (x.empty() || y.empty()) {
+                ::obake::detail::series_native_save_impl(ofs, retval, mode);
+            } else {
+                detail::mul_profiler prof("mt_hm");
+                prof.begin(mul_phase::copy);
+
+                auto v1 = detail::poly_view_mul_term_vector(x);
+                auto v2 = detail::poly_view_mul_term_vector(y);
+                const detail::poly_mul_spill_sink<series_key_t<ret_t>, series_cf_t<ret_t>> sink(ofs, mem_budget,
+                                                                                                 mode);
+
+                if (v1.size() <= v2.size()) {
+                    detail::poly_mul_impl_mt_hm_terms<p1_t, p2_t>(retval, v1, v2, sink, prof);
+                } else {
+                    detail::poly_mul_impl_mt_hm_terms<p2_t, p1_t>(retval, v2, v1, sink, prof);
+                }
+            }
+            // LCOV_EXCL_START
+        } catch (...) {
+            // Don't leave a partially-written file around.
+            ofs.close();
+            ::std::remove(filename.c_str());
+            throw;
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    return detail::poly_ooc_mul_ret_t<T, U>(filename);
+}
+
+namespace detail
+{
+
+// Metaprogramming to establish if we can perform
+// truncated total/partial degree multiplication on the
+// polynomial operands T and U with degree limit of type V.
+// NOTE: at this time, truncated multiplication is implemented
+// only if only the key is with degree.
+template <typename T, typename U, typename V, bool Total>
+constexpr auto poly_mul_truncated_degree_algorithm_impl()
+{
+    // Check first if we can do the untruncated multiplication. If we cannot,
+    // truncated mult is not possible.
+    if constexpr (poly_mul_algo<T, U> == 0) {
+        return 0;
+    } else {
+        // Check if we can compute the degree of the terms via the default
+        // implementation for series.
+        using d_impl = ::std::conditional_t<Total, customisation::internal::series_default_degree_impl,
+                                            customisation::internal::series_default_p_degree_impl>;
+        constexpr auto algo1 = d_impl::template algo<T>;
+        constexpr auto algo2 = d_impl::template algo<U>;
+
+        // NOTE: algo == 3 means that only the key is with degree.
+        if constexpr (algo1 == 3 && algo2 == 3) {
+            // Fetch the degree types.
+            using deg1_t = typename d_impl::template ret_t<T>;
+            using deg2_t = typename d_impl::template ret_t<U>;
+
+            // The degree types need to be:
+            // - copy/move ctible (need to handle vectors of them, note that
+            //   in the series default degree machinery we check for returnability,
+            //   but here we need explicitly both copy and move ctible),
+            // - addable via const lref,
+            // - V must be lt-comparable to the type of their sum via const lrefs.
+            using deg_add_t = detected_t<::obake::detail::add_t, const deg1_t &, const deg2_t &>;
+
+            return static_cast<int>(::std::conjunction_v<
+                                    // NOTE: this will ensure that switching around
+                                    // the degree operands still works and produces the same
+                                    // type. This is necessary because in the poly moltiplication
+                                    // function we might end up swapping the operands.
+                                    // NOTE: this will also verify that deg_add_t is present.
+                                    is_addable<const deg1_t &, const deg2_t &>, ::std::is_copy_constructible<deg1_t>,
+                                    ::std::is_copy_constructible<deg2_t>, ::std::is_move_constructible<deg1_t>,
+                                    ::std::is_move_constructible<deg2_t>,
+                                    // NOTE: in the implementation functions, we always compare
+                                    // an lvalue ref to the limit V to an rvalue resulting
+                                    // from adding the degrees of one term from each series.
+                                    is_less_than_comparable<::std::add_lvalue_reference_t<const V>, deg_add_t>>);
+        } else {
+            return 0;
+        }
+    }
+}
+
+template <typename T, typename U, typename V>
+inline constexpr auto poly_mul_truncated_degree_algo
+    = detail::poly_mul_truncated_degree_algorithm_impl<T, U, V, true>();
+
+template <typename T, typename U, typename V>
+inline constexpr auto poly_mul_truncated_p_degree_algo
+    = detail::poly_mul_truncated_degree_algorithm_impl<T, U, V, false>();
+
+} // namespace detail
+
+// Truncated multiplication.
+// NOTE: do we need the type traits/concepts as well?
+// NOTE: should these be function objects?
+template <typename T, typename U, typename V,
+          ::std::enable_if_t<detail::poly_mul_truncated_degree_algo<T &&, U &&, V> != 0, int> = 0>
+inline detail::poly_mul_ret_t<T &&, U &&> truncated_mul(T &&x, U &&y, const V &max_degree)
+{
+    return detail::poly_mul_impl_switch(::std::forward<T>(x), ::std::forward<U>(y), max_degree);
+}
+
+template <typename T, typename U, typename V,
+          ::std::enable_if_t<detail::poly_mul_truncated_p_degree_algo<T &&, U &&, V> != 0, int> = 0>
+inline detail::poly_mul_ret_t<T &&, U &&> truncated_mul(T &&x, U &&y, const V &max_degree, const symbol_set &s)
+{
+    return detail::poly_mul_impl_switch(::std::forward<T>(x), ::std::forward<U>(y), max_degree, s);
+}
+
+// Predicted figures for the product of two polynomials:
+// the estimated number of terms, the estimated memory
+// footprint in bytes and the number of term-by-term
+// multiplications.
+struct mul_estimate {
+    ::mppp::integer<1> n_terms;
+    ::mppp::integer<1> n_bytes;
+    ::mppp::integer<1> n_mults;
+};
+
+namespace detail
+{
+
+// Metaprogramming for estimate_mul(). Trunc selects the
+// untruncated (0), total degree (1) or partial degree (2)
+// truncation, V is the type of the degree limit.
+template <typename T, typename U, int Trunc, typename V = void>
+constexpr bool poly_estimate_mul_algorithm_impl()
+{
+    using p1_t = poly_ooc_mul_operand_t<T>;
+    using p2_t = poly_ooc_mul_operand_t<U>;
+
+    if constexpr (::std::disjunction_v<::std::is_same<p1_t, void>, ::std::is_same<p2_t, void>>) {
+        return false;
+    } else if constexpr (Trunc == 0 && poly_mul_algo<const p1_t &, const p2_t &> == 0) {
+        return false;
+    } else if constexpr (Trunc == 1 && poly_mul_truncated_degree_algo<const p1_t &, const p2_t &, V> == 0) {
+        return false;
+    } else if constexpr (Trunc == 2 && poly_mul_truncated_p_degree_algo<const p1_t &, const p2_t &, V> == 0) {
+        return false;
+    } else {
+        // NOTE: the estimation of the average term size
+        // requires measuring the size of the key/cf of the product.
+        using ret_t = poly_mul_ret_t<const p1_t &, const p2_t &>;
+
+        return ::std::conjunction_v<is_size_measurable<const series_key_t<ret_t> &>,
+                                    is_size_measurable<const series_cf_t<ret_t> &>>;
+    }
+}
+
+template <typename T, typename U>
+inline constexpr bool poly_estimate_mul_algo = detail::poly_estimate_mul_algorithm_impl<T, U, 0>();
+
+template <typename T, typename U, typename V>
+inline constexpr bool poly_estimate_truncated_mul_algo = detail::poly_estimate_mul_algorithm_impl<T, U, 1, V>();
+
+template <typename T, typename U, typename V>
+inline constexpr bool poly_estimate_truncated_p_mul_algo = detail::poly_estimate_mul_algorithm_impl<T, U, 2, V>();
+
+// Estimate the product of the vectors of terms (or of
+// pointers to terms) v1 and v2 (v1 not longer than v2). S1 and S2 are the types of the
+// polynomials from which the terms originate.
+template <typename RetCf, typename S1, typename S2, typename V1, typename V2, typename... Args>
+inline mul_estimate poly_estimate_mul_terms(const V1 &v1, const V2 &v2, const symbol_set &ss, const Args &... args)
+{
+    assert(!v1.empty());
+    assert(!v2.empty());
+    assert(v1.size() <= v2.size());
+
+    // NOTE: as in the multiplication, the overflow check
+    // must be sequenced before the estimation.
+    detail::poly_mul_impl_overflow_check(v1, v2, ss);
+
+    auto [n_terms, n_mults] = detail::poly_mul_estimate_product_size<S1, S2>(v1, v2, ss, args...);
+    if (sizeof...(Args) > 0u && n_mults.is_zero()) {
+        // The truncation limits result in an empty product.
+        return mul_estimate{};
+    }
+
+    const auto avg_term_size = detail::poly_mul_impl_estimate_average_term_size<RetCf>(v1, v2, ss);
+    auto n_bytes = n_terms * avg_term_size;
+
+    return mul_estimate{::std::move(n_terms), ::std::move(n_bytes), ::std::move(n_mults)};
+}
+
+// Helper to fetch the terms of x for the estimation
+// of a multiplication.
+template <typename T>
+inline auto poly_estimate_mul_term_vector(const T &x)
+{
+    if constexpr (is_series_view_v<T>) {
+        return x.to_term_vector();
+    } else {
+        return ::std::vector<const series_term_t<T> *>(
+            ::boost::make_transform_iterator(x.begin(), poly_mul_impl_ptr_extractor{}),
+            ::boost::make_transform_iterator(x.end(), poly_mul_impl_ptr_extractor{}));
+    }
+}
+
+// Implementation of estimate_mul(). P1 and P2 are the
+// polynomial types corresponding to x and y.
+template <typename P1, typename P2, typename T, typename U, typename... Args>
+inline mul_estimate poly_estimate_mul_impl(const T &x, const U &y, const Args &... args)
+{
+    using ret_cf_t = series_cf_t<poly_mul_ret_t<const P1 &, const P2 &>>;
+
+    if (x.get_symbol_set() != y.get_symbol_set()) {
+        const auto &[merged_ss, ins_map_x, ins_map_y]
+            = ::obake::detail::merge_symbol_sets(x.get_symbol_set(), y.get_symbol_set());
+
+        return detail::poly_estimate_mul_impl<P1, P2>(detail::poly_view_mul_extend(x, merged_ss, ins_map_x),
+                                                      detail::poly_view_mul_extend(y, merged_ss, ins_map_y),
+                                                      args...);
+    }
+
+    if (x.empty() || y.empty()) {
+        return mul_estimate{};
+    }
+
+    // NOTE: for polynomials, use vectors of pointers to the
+    // terms (as in poly_mul_impl_simple()), so that the operands
+    // are not copied. Series views are decoded into vectors of terms.
+    const auto v1 = detail::poly_estimate_mul_term_vector(x);
+    const auto v2 = detail::poly_estimate_mul_term_vector(y);
+    const auto &ss = x.get_symbol_set();
+
+    if (v1.size() <= v2.size()) {
+        return detail::poly_estimate_mul_terms<ret_cf_t, P1, P2>(v1, v2, ss, args...);
+    } else {
+        return detail::poly_estimate_mul_terms<ret_cf_t, P2, P1>(v2, v1, ss, args...);
+    }
+}
+
+} // namespace detail
+
+// Estimate the size of the product of x and y (each either a
+// polynomial or a polynomial view) without computing it, using
+// the same machinery employed by the multi-threaded multiplication
+// algorithm to size the output. The estimate is meant to be
+// used together with set_memory_budget().
+template <typename T, typename U, ::std::enable_if_t<detail::poly_estimate_mul_algo<T, U>, int> = 0>
+inline mul_estimate estimate_mul(const T &x, const U &y)
+{
+    return detail::poly_estimate_mul_impl<detail::poly_ooc_mul_operand_t<T>, detail::poly_ooc_mul_operand_t<U>>(x, y);
+}
+
+// Estimate of the truncated multiplication.
+template <typename T, typename U, typename V,
+          ::std::enable_if_t<detail::poly_estimate_truncated_mul_algo<T, U, V>, int> = 0>
+inline mul_estimate estimate_mul(const T &x, const U &y, const V &max_degree)
+{
+    return detail::poly_estimate_mul_impl<detail::poly_ooc_mul_operand_t<T>, detail::poly_ooc_mul_operand_t<U>>(
+        x, y, max_degree);
+}
+
+template <typename T, typename U, typename V,
+          ::std::enable_if_t<detail::poly_estimate_truncated_p_mul_algo<T, U, V>, int> = 0>
+inline mul_estimate estimate_mul(const T &x, const U &y, const V &max_degree, const symbol_set &s)
+{
+    return detail::poly_estimate_mul_impl<detail::poly_ooc_mul_operand_t<T>, detail::poly_ooc_mul_operand_t<U>>(
+        x, y, max_degree, s);
+}
+
+namespace detail
+{
+
+// Machinery to enable the pow() specialisation for polynomials.
+template <typename T, typename U>
+constexpr auto poly_pow_algorithm_impl()
+{
+    if constexpr (is_polynomial_v<remove_cvref_t<T>>) {
+        return customisation::internal::series_default_pow_impl::algo<T, U>;
+    } else {
+        return 0;
+    }
+}
+
+template <typename T, typename U>
+inline constexpr auto poly_pow_algo = detail::poly_pow_algorithm_impl<T, U>();
 
 } // namespace detail
 
@@ -2186,6 +2875,41 @@ inline customisation::internal::series_default_pow_impl::ret_t<T &&, U &&> pow(T
 namespace detail
 {
 
+// Detect the monomial_unpack() function, which writes
+// the exponents of the monomial K into a range of E
+// in a single pass.
+// NOTE: monomial_unpack() is found via ADL.
+template <typename K, typename E>
+using poly_monomial_unpack_t = decltype(monomial_unpack(::std::declval<const K &>(),
+                                                        ::std::declval<const symbol_set &>(), ::std::declval<E *>()));
+
+// Check if the cached polynomial substitution
+// algorithm can be used.
+template <typename K, typename U, typename KeySubs, typename SubsProd>
+constexpr bool poly_subs_cached_enabled()
+{
+    if constexpr (is_key_with_p_degree_v<const K &>) {
+        using exp_t = ::obake::detail::key_p_degree_t<const K &>;
+        using pow_ret_t = detected_t<::obake::detail::pow_t, const U &, const exp_t &>;
+
+        return ::std::conjunction_v<
+            // The exponents must be integral values which
+            // can be extracted from a monomial and
+            // used to build a monomial.
+            is_integral<exp_t>, is_semi_regular<exp_t>, is_detected<poly_monomial_unpack_t, K, exp_t>,
+            ::std::is_constructible<K, const exp_t *, const exp_t *>,
+            // The powers must be cacheable, and the result
+            // of the monomial substitution must be computable
+            // from them.
+            is_semi_regular<pow_ret_t>, ::std::is_constructible<KeySubs, int>,
+            is_in_place_multipliable<KeySubs &, const pow_ret_t &>,
+            // The grouped values must be accumulable.
+            is_semi_regular<SubsProd>, is_in_place_addable<SubsProd &, SubsProd>>;
+    } else {
+        return false;
+    }
+}
+
 // Meta-programming for the selection of the
 // polynomial substitution algorithm.
 // NOTE: currently this supports only the case
@@ -2226,7 +2950,15 @@ constexpr auto poly_subs_algorithm_impl()
                               is_detected<::obake::detail::mul_t, key_subs_t, cf_subs_t>,
                               is_in_place_addable<::std::add_lvalue_reference_t<ret_t>, ret_t>,
                               ::std::is_constructible<cf_t, int>>) {
-                return ::std::make_pair(1, ::obake::detail::type_c<ret_t>{});
+                // Check if we can use the cached implementation,
+                // in which the monomial substitutions are computed
+                // from the exponents via cached powers, and the terms
+                // are grouped by residual monomial.
+                if constexpr (poly_subs_cached_enabled<key_t, U, key_subs_t, subs_prod_t>()) {
+                    return ::std::make_pair(2, ::obake::detail::type_c<ret_t>{});
+                } else {
+                    return ::std::make_pair(1, ::obake::detail::type_c<ret_t>{});
+                }
             } else {
                 return failure;
             }
@@ -2245,61 +2977,484 @@ inline constexpr int poly_subs_algo = poly_subs_algorithm<T, U>.first;
 template <typename T, typename U>
 using poly_subs_ret_t = typename decltype(poly_subs_algorithm<T, U>.second)::type;
 
-} // namespace detail
-
-template <typename T, typename U, ::std::enable_if_t<detail::poly_subs_algo<T &&, U> != 0, int> = 0>
-inline detail::poly_subs_ret_t<T &&, U> subs(T &&x_, const symbol_map<U> &sm)
+// Cached implementation of polynomial substitution.
+// The exponents of each monomial are extracted, and the result
+// of the monomial substitution is computed by multiplying
+// together powers of the substituted values, which are cached
+// for each symbol. The products between the substituted coefficients
+// and the substituted monomials are then either inserted directly
+// into the return value (if Ret is a polynomial whose terms can
+// be constructed from the residual monomials and the products), or
+// grouped by residual monomial, so that a single multiplication by
+// a residual monomial is needed for each group.
+template <typename Ret, typename T, typename U>
+inline Ret poly_subs_cached_impl(const T &x, const symbol_map<U> &sm, const symbol_idx_map<U> &si)
 {
-    // Sanity check.
-    static_assert(detail::poly_subs_algo<T &&, U> == 1);
-
-    // Need only const access to x.
-    const auto &x = ::std::as_const(x_);
+    using key_t = series_key_t<T>;
+    using cf_t = series_cf_t<T>;
+    using exp_t = ::obake::detail::key_p_degree_t<const key_t &>;
+    using key_subs_t = typename ::obake::detail::monomial_subs_t<const key_t &, U>::first_type;
+    using cf_subs_t = ::obake::detail::subs_t<const cf_t &, U>;
+    using subs_prod_t = ::obake::detail::mul_t<key_subs_t, cf_subs_t>;
+    using pow_ret_t = ::obake::detail::pow_t<const U &, const exp_t &>;
+
+    // Can we insert the terms directly into the return value?
+    constexpr auto direct_ins = []() {
+        if constexpr (is_polynomial_v<Ret>) {
+            return ::std::conjunction_v<::std::is_same<series_key_t<Ret>, key_t>,
+                                        ::std::is_same<series_cf_t<Ret>, subs_prod_t>>;
+        } else {
+            return false;
+        }
+    }();
 
-    // Cache a reference to the symbol set.
     const auto &ss = x.get_symbol_set();
 
-    // Compute the intersection between sm and ss.
-    const auto si = ::obake::detail::sm_intersect_idx(sm, ss);
+    auto retval = ::obake::detail::series_table_reduce(
+        x,
+        [&ss, &sm, &si](const auto &tab) {
+            // The power caches for the symbols being
+            // substituted. The caches are local to each
+            // table, so that the tables can be processed
+            // in parallel.
+            ::std::vector<::boost::container::flat_map<exp_t, pow_ret_t>> p_caches(
+                static_cast<decltype(p_caches.size())>(si.size()));
+
+            // The exponents of the current monomial.
+            ::std::vector<exp_t> exps(static_cast<decltype(exps.size())>(ss.size()));
+
+            // Helper to perform the substitution in the monomial k.
+            // The return value is the result of the substitution,
+            // while the exponents of the residual monomial
+            // are written into exps.
+            auto k_subs = [&](const key_t &k) {
+                monomial_unpack(k, ss, exps.data());
+
+                // NOTE: as in monomial_subs(), multiply in the powers
+                // of all the substituted symbols, including those
+                // with zero exponent.
+                key_subs_t ret(1);
+                auto c_it = p_caches.begin();
+                for (const auto &p : si) {
+                    auto &e = exps[static_cast<decltype(exps.size())>(p.first)];
+
+                    auto it = c_it->find(e);
+                    if (it == c_it->end()) {
+                        it = c_it->emplace(e, ::obake::pow(p.second, ::std::as_const(e))).first;
+                    }
+                    ret *= ::std::as_const(it->second);
 
-    // Init a temp poly that we will use in the loop below.
-    remove_cvref_t<T> tmp_poly;
-    tmp_poly.set_symbol_set(ss);
+                    e = exp_t(0);
+                    ++c_it;
+                }
 
-    // The return value (this will default-construct
-    // an empty polynomial).
-    detail::poly_subs_ret_t<T &&, U> retval;
+                return ret;
+            };
 
-    // NOTE: parallelisation opportunities here
-    // for segmented tables.
-    for (const auto &t : x) {
-        const auto &k = t.first;
-        const auto &c = t.second;
-
-        // Do the monomial substitution.
-        auto k_sub(::obake::monomial_subs(k, si, ss));
-
-        // Clear up tmp_poly, add a term with unitary
-        // coefficient containing the monomial result of the
-        // substitution above.
-        tmp_poly.clear_terms();
-        tmp_poly.add_term(::std::move(k_sub.second), 1);
-
-        // Compute the product of the substitutions and accumulate
-        // it into the return value.
-        // NOTE: if the type of retval coincides with the type
-        // of the original poly, we could probably optimise this
-        // to do term insertions rather than going through with
-        // the multiplications. E.g., substitution with integral
-        // values in a polynomial with integral coefficients.
-        // NOTE: another optimisation is possible if
-        // the type of subs(c, sm) is the coefficient type of
-        // tmp_poly. In that case we can avoid one multiplication
-        // and call tmp_poly.add_term() above directly with
-        // subs(c, sm) as a coefficient instead of 1.
-        retval += ::std::move(k_sub.first) * ::obake::subs(c, sm) * ::std::as_const(tmp_poly);
+            if constexpr (direct_ins) {
+                Ret acc;
+                acc.set_symbol_set(ss);
+
+                for (const auto &t : tab) {
+                    auto k_sub = k_subs(t.first);
+
+                    // NOTE: the residual monomial is compatible with ss
+                    // by construction, and add_term() will take care
+                    // of accumulating the values for repeated monomials
+                    // and of removing the zero terms.
+                    ::obake::detail::series_add_term<true, ::obake::detail::sat_check_zero::on,
+                                                     ::obake::detail::sat_check_compat_key::off,
+                                                     ::obake::detail::sat_check_table_size::on,
+                                                     ::obake::detail::sat_assume_unique::off>(
+                        acc, key_t(exps.data(), exps.data() + exps.size()),
+                        ::std::move(k_sub) * ::obake::subs(t.second, sm));
+                }
+
+                return acc;
+            } else {
+                // Group the products by residual monomial.
+                ::absl::flat_hash_map<key_t, subs_prod_t, ::obake::detail::series_key_hasher,
+                                      ::obake::detail::series_key_comparer>
+                    groups;
+
+                for (const auto &t : tab) {
+                    auto k_sub = k_subs(t.first);
+                    auto v = ::std::move(k_sub) * ::obake::subs(t.second, sm);
+
+                    // NOTE: try_emplace() does not move from v
+                    // if the insertion does not take place.
+                    const auto res = groups.try_emplace(key_t(exps.data(), exps.data() + exps.size()), ::std::move(v));
+                    if (!res.second) {
+                        res.first->second += ::std::move(v);
+                    }
+                }
+
+                // Multiply each group by its residual monomial,
+                // and accumulate.
+                T tmp_poly;
+                tmp_poly.set_symbol_set(ss);
+
+                Ret acc;
+                for (auto &g : groups) {
+                    tmp_poly.clear_terms();
+                    tmp_poly.add_term(g.first, 1);
+
+                    acc += ::std::move(g.second) * ::std::as_const(tmp_poly);
+                }
+
+                return acc;
+            }
+        },
+        [](auto &acc, auto &&p) { acc += ::std::move(p); });
+
+    return retval ? ::std::move(*retval) : Ret{};
+}
+
+} // namespace detail
+
+template <typename T, typename U, ::std::enable_if_t<detail::poly_subs_algo<T &&, U> != 0, int> = 0>
+inline detail::poly_subs_ret_t<T &&, U> subs(T &&x_, const symbol_map<U> &sm)
+{
+    // Sanity check.
+    static_assert(detail::poly_subs_algo<T &&, U> == 1 || detail::poly_subs_algo<T &&, U> == 2);
+
+    // Need only const access to x.
+    const auto &x = ::std::as_const(x_);
+
+    // Cache a reference to the symbol set.
+    const auto &ss = x.get_symbol_set();
+
+    // Compute the intersection between sm and ss.
+    const auto si = ::obake::detail::sm_intersect_idx(sm, ss);
+
+    using ret_t = detail::poly_subs_ret_t<T &&, U>;
+
+    if constexpr (detail::poly_subs_algo<T &&, U> == 2) {
+        return detail::poly_subs_cached_impl<ret_t>(x, sm, si);
+    } else {
+        // Run the substitution on each table (in parallel,
+        // if x is segmented), and accumulate the partial results.
+        auto retval = ::obake::detail::series_table_reduce(
+            x,
+            [&ss, &si, &sm](const auto &tab) {
+                // Init a temp poly that we will use in the loop below.
+                remove_cvref_t<T> tmp_poly;
+                tmp_poly.set_symbol_set(ss);
+
+                // The partial result for the current table (this will
+                // default-construct an empty polynomial).
+                ret_t acc;
+
+                for (const auto &t : tab) {
+                    const auto &k = t.first;
+                    const auto &c = t.second;
+
+                    // Do the monomial substitution.
+                    auto k_sub(::obake::monomial_subs(k, si, ss));
+
+                    // Clear up tmp_poly, add a term with unitary
+                    // coefficient containing the monomial result of the
+                    // substitution above.
+                    tmp_poly.clear_terms();
+                    tmp_poly.add_term(::std::move(k_sub.second), 1);
+
+                    // Compute the product of the substitutions and accumulate
+                    // it into the return value.
+                    // NOTE: see poly_subs_cached_impl() for an
+                    // implementation avoiding most of these multiplications.
+                    acc += ::std::move(k_sub.first) * ::obake::subs(c, sm) * ::std::as_const(tmp_poly);
+                }
+
+                return acc;
+            },
+            [](auto &acc, auto &&p) { acc += ::std::move(p); });
+
+        return retval ? ::std::move(*retval) : ret_t{};
+    }
+}
+
+namespace detail
+{
+
+// Meta-programming for the selection of the
+// evaluate_batch() algorithm.
+// NOTE: at this time, we support only the batched evaluation
+// of polynomials with non-series coefficients and
+// integral exponents over C++ floating-point types.
+template <typename T, typename U>
+constexpr int poly_evaluate_batch_algorithm_impl()
+{
+    using rT = remove_cvref_t<T>;
+
+    if constexpr (!::std::conjunction_v<is_polynomial<rT>, ::std::is_floating_point<U>>) {
+        return 0;
+    } else {
+        using cf_t = series_cf_t<rT>;
+        using key_t = series_key_t<rT>;
+
+        if constexpr (::std::conjunction_v<::std::negation<is_cvr_series<cf_t>>,
+                                           ::std::is_constructible<U, const cf_t &>,
+                                           is_key_with_p_degree<const key_t &>>) {
+            // NOTE: the exponents are extracted via monomial_unpack(),
+            // and they are then fed to pow().
+            using exp_t = ::obake::detail::key_p_degree_t<const key_t &>;
+
+            return ::std::conjunction_v<is_integral<exp_t>, is_semi_regular<exp_t>,
+                                        is_detected<poly_monomial_unpack_t, key_t, exp_t>,
+                                        ::std::is_same<U, detected_t<::obake::detail::pow_t, const U &, const exp_t &>>>
+                       ? 1
+                       : 0;
+        } else {
+            return 0;
+        }
+    }
+}
+
+template <typename T, typename U>
+inline constexpr int poly_evaluate_batch_algo = detail::poly_evaluate_batch_algorithm_impl<T, U>();
+
+} // namespace detail
+
+// Batched evaluation of a polynomial.
+// The evaluation points are provided as a map
+// from symbols to columns of values (i.e., the
+// i-th element of each column contains the value of the
+// corresponding symbol in the i-th evaluation point).
+// The return value contains the values of x at each point.
+template <typename T, typename U, ::std::enable_if_t<detail::poly_evaluate_batch_algo<T &&, U> != 0, int> = 0>
+inline ::std::vector<U> evaluate_batch(T &&x_, const symbol_map<::std::vector<U>> &sm)
+{
+    // Sanity check.
+    static_assert(detail::poly_evaluate_batch_algo<T &&, U> == 1);
+
+    using rT = remove_cvref_t<T>;
+    using key_t = series_key_t<rT>;
+    using exp_t = ::obake::detail::key_p_degree_t<const key_t &>;
+    using col_size_t = typename ::std::vector<U>::size_type;
+
+    // Need only const access to x.
+    const auto &x = ::std::as_const(x_);
+
+    // Cache the symbol set.
+    const auto &ss = x.get_symbol_set();
+
+    // Determine the number of evaluation points, and check
+    // that all the columns have the same size.
+    const auto npoints = sm.empty() ? col_size_t(0) : sm.cbegin()->second.size();
+    for (const auto &p : sm) {
+        if (obake_unlikely(p.second.size() != npoints)) {
+            obake_throw(::std::invalid_argument,
+                        "Cannot evaluate a polynomial in batch mode: the column of values for the symbol '" + p.first
+                            + "' has a size of " + ::obake::detail::to_string(p.second.size())
+                            + ", but the expected size is " + ::obake::detail::to_string(npoints));
+        }
     }
 
+    // Fetch pointers to the columns, in the same order
+    // as the symbols in ss.
+    // NOTE: don't use sm_intersect_idx() here, as we don't
+    // want to copy the columns.
+    ::std::vector<const U *> cols;
+    cols.reserve(static_cast<decltype(cols.size())>(ss.size()));
+    for (const auto &s : ss) {
+        const auto it = sm.find(s);
+
+        if (obake_unlikely(it == sm.end())) {
+            obake_throw(::std::invalid_argument,
+                        "Cannot evaluate a polynomial in batch mode: the evaluation map does not contain the symbol '"
+                            + s + "', which appears in the polynomial's symbol set, "
+                            + ::obake::detail::to_string(ss));
+        }
+
+        cols.push_back(it->second.data());
+    }
+
+    // Prepare the return value.
+    ::std::vector<U> retval(npoints);
+
+    if (x.empty() || npoints == 0u) {
+        return retval;
+    }
+
+    // The total number of symbols.
+    const auto n_syms = ss.size();
+
+    // Flatten the polynomial. For each term we store the coefficient
+    // converted to U and the list of its nonzero exponents
+    // in a CSR-like format (i.e., the exponents of the i-th term
+    // are stored in the [t_ptr[i], t_ptr[i + 1]) range of t_exps and t_idx).
+    // NOTE: the flattening is done in parallel, table by table. The terms
+    // of each table are written at the offset given by the prefix sums
+    // of the table sizes, while their nonzero exponents are first
+    // collected in per-table buffers, which are then concatenated.
+    const auto &s_table = x._get_s_table();
+    using s_size_t = remove_cvref_t<decltype(s_table.size())>;
+    const auto n_tables = s_table.size();
+
+    ::std::vector<::std::size_t> tab_offsets(n_tables + 1u, 0);
+    for (s_size_t i = 0; i < n_tables; ++i) {
+        tab_offsets[i + 1u] = tab_offsets[i] + s_table[i].size();
+    }
+    const auto n_terms = tab_offsets.back();
+
+    ::std::vector<U> t_cfs(static_cast<typename ::std::vector<U>::size_type>(n_terms));
+    ::std::vector<::std::size_t> t_ptr(n_terms + 1u, 0);
+    ::std::vector<exp_t> t_exps;
+    ::std::vector<symbol_idx> t_idx;
+
+    {
+        ::std::vector<::std::vector<exp_t>> tab_exps(n_tables);
+        ::std::vector<::std::vector<symbol_idx>> tab_idx(n_tables);
+
+        ::tbb::parallel_for(::tbb::blocked_range<s_size_t>(0, n_tables), [&](const auto &range) {
+            // The exponents of the current monomial.
+            ::std::vector<exp_t> exps(static_cast<decltype(exps.size())>(n_syms));
+
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                auto &l_exps = tab_exps[i];
+                auto &l_idx = tab_idx[i];
+
+                auto idx = tab_offsets[i];
+                for (const auto &t : s_table[i]) {
+                    t_cfs[idx] = static_cast<U>(t.second);
+
+                    monomial_unpack(t.first, ss, exps.data());
+                    for (symbol_idx j = 0; j < n_syms; ++j) {
+                        if (exps[j] != exp_t(0)) {
+                            l_exps.push_back(exps[j]);
+                            l_idx.push_back(j);
+                        }
+                    }
+
+                    // NOTE: for now, the offset is relative
+                    // to the beginning of the table's buffers.
+                    t_ptr[++idx] = l_exps.size();
+                }
+            }
+        });
+
+        ::std::vector<::std::size_t> exp_offsets(n_tables + 1u, 0);
+        for (s_size_t i = 0; i < n_tables; ++i) {
+            exp_offsets[i + 1u] = exp_offsets[i] + tab_exps[i].size();
+        }
+
+        t_exps.resize(static_cast<decltype(t_exps.size())>(exp_offsets.back()));
+        t_idx.resize(static_cast<decltype(t_idx.size())>(exp_offsets.back()));
+
+        ::tbb::parallel_for(::tbb::blocked_range<s_size_t>(0, n_tables), [&](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                const auto base = exp_offsets[i];
+
+                ::std::move(tab_exps[i].begin(), tab_exps[i].end(),
+                            t_exps.begin() + static_cast<decltype(t_exps.size())>(base));
+                ::std::copy(tab_idx[i].begin(), tab_idx[i].end(),
+                            t_idx.begin() + static_cast<decltype(t_idx.size())>(base));
+
+                // Make the offsets absolute.
+                for (auto idx = tab_offsets[i] + 1u; idx <= tab_offsets[i + 1u]; ++idx) {
+                    t_ptr[idx] += base;
+                }
+            }
+        });
+    }
+
+    // For each symbol, determine the sorted list of distinct nonzero exponents
+    // appearing in the polynomial. The powers of the values of the symbol
+    // will be cached for each of these exponents. d_base[i] is the offset
+    // of the distinct exponents for the i-th symbol in d_exps.
+    ::std::vector<exp_t> d_exps;
+    ::std::vector<::std::size_t> d_base;
+    d_base.reserve(static_cast<decltype(d_base.size())>(n_syms + 1u));
+    {
+        ::std::vector<::std::vector<exp_t>> tmp_exps(static_cast<decltype(tmp_exps.size())>(n_syms));
+        for (decltype(t_exps.size()) i = 0; i < t_exps.size(); ++i) {
+            tmp_exps[static_cast<decltype(tmp_exps.size())>(t_idx[i])].push_back(t_exps[i]);
+        }
+
+        d_base.push_back(0);
+        for (auto &v : tmp_exps) {
+            ::std::sort(v.begin(), v.end());
+            v.erase(::std::unique(v.begin(), v.end()), v.end());
+
+            d_exps.insert(d_exps.end(), v.begin(), v.end());
+            d_base.push_back(d_exps.size());
+        }
+    }
+
+    // Replace the exponents of each term with the indices of
+    // the corresponding rows in the power cache.
+    ::std::vector<::std::size_t> t_rows;
+    t_rows.reserve(static_cast<decltype(t_rows.size())>(t_exps.size()));
+    for (decltype(t_exps.size()) i = 0; i < t_exps.size(); ++i) {
+        const auto b = d_exps.begin() + static_cast<decltype(d_exps.size())>(d_base[t_idx[i]]),
+                   e = d_exps.begin() + static_cast<decltype(d_exps.size())>(d_base[t_idx[i] + 1u]);
+        const auto it = ::std::lower_bound(b, e, t_exps[i]);
+        assert(it != e && *it == t_exps[i]);
+
+        t_rows.push_back(static_cast<::std::size_t>(it - d_exps.begin()));
+    }
+
+    // The number of points in a block. Each block
+    // has its own power cache, which is laid out
+    // in rows of block_size values.
+    constexpr ::std::size_t block_size = 256;
+
+    const auto n_blocks = static_cast<::std::size_t>(npoints / block_size + (npoints % block_size != 0u));
+    const auto n_rows = d_exps.size();
+
+    ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, n_blocks), [&](const auto &range) {
+        // The power cache and the buffer for the term
+        // evaluations, shared by all the blocks in range.
+        ::std::vector<U> p_cache(
+            ::obake::safe_cast<typename ::std::vector<U>::size_type>(::mppp::integer<1>(n_rows) * block_size));
+        ::std::vector<U> t_buffer(block_size);
+
+        for (auto bidx = range.begin(); bidx != range.end(); ++bidx) {
+            const auto p_begin = bidx * block_size;
+            const auto cur_size = ::std::min(block_size, static_cast<::std::size_t>(npoints) - p_begin);
+
+            // Fill in the power cache.
+            for (symbol_idx i = 0; i < n_syms; ++i) {
+                const auto col = cols[static_cast<decltype(cols.size())>(i)] + p_begin;
+
+                for (auto r = d_base[i]; r < d_base[i + 1u]; ++r) {
+                    const auto &e = d_exps[r];
+                    const auto row = p_cache.data() + r * block_size;
+
+                    for (::std::size_t j = 0; j < cur_size; ++j) {
+                        row[j] = ::obake::pow(col[j], e);
+                    }
+                }
+            }
+
+            // Accumulate the term evaluations into the output.
+            // NOTE: the inner loops are plain loops over
+            // contiguous arrays of FP values, which will be
+            // vectorised by the compiler.
+            const auto out = retval.data() + p_begin;
+            const auto buf = t_buffer.data();
+            for (::std::size_t t = 0; t < n_terms; ++t) {
+                const auto c = t_cfs[t];
+
+                for (::std::size_t j = 0; j < cur_size; ++j) {
+                    buf[j] = c;
+                }
+
+                for (auto k = t_ptr[t]; k < t_ptr[t + 1u]; ++k) {
+                    const auto row = p_cache.data() + t_rows[k] * block_size;
+
+                    for (::std::size_t j = 0; j < cur_size; ++j) {
+                        buf[j] *= row[j];
+                    }
+                }
+
+                for (::std::size_t j = 0; j < cur_size; ++j) {
+                    out[j] += buf[j];
+                }
+            }
+        }
+    });
+
     return retval;
 }
 
@@ -2340,101 +3495,503 @@ constexpr int poly_truncate_degree_algorithm_impl()
             return 0;
         }
     }
-}
+}
+
+template <typename T, typename U>
+inline constexpr int poly_truncate_degree_algo = detail::poly_truncate_degree_algorithm_impl<T, U>();
+
+} // namespace detail
+
+// NOTE: perhaps we can extend the implementation in the future
+// to accept mutable rvalue references as well.
+template <typename T, typename U, ::std::enable_if_t<detail::poly_truncate_degree_algo<T &, U &&> != 0, int> = 0>
+inline void truncate_degree(T &x, U &&y_)
+{
+    // Sanity checks.
+    static_assert(detail::poly_truncate_degree_algo<T &, U &&> == 1);
+
+    // Use the default functor for the extraction of the term degree.
+    using d_impl = customisation::internal::series_default_degree_impl;
+
+    // Implement on top of filter().
+    // NOTE: d_extractor will strip out the cvref
+    // from T, thus we can just pass in T as-is.
+    ::obake::filter(x, [deg_ext = d_impl::d_extractor<T>{&x.get_symbol_set()},
+                        &y = ::std::as_const(y_)](const auto &t) { return !(y < deg_ext(t)); });
+}
+
+namespace detail
+{
+
+// Meta-programming for the selection of the
+// truncate_p_degree() algorithm.
+// NOTE: at this time, we support only truncation
+// based on key filtering.
+template <typename T, typename U>
+constexpr int poly_truncate_p_degree_algorithm_impl()
+{
+    if constexpr (!is_polynomial_v<::std::remove_reference_t<T>>) {
+        // Not a mutable polynomial.
+        return 0;
+    } else {
+        // Check if we can compute the p_degree of the terms via the default
+        // implementation for series.
+        using d_impl = customisation::internal::series_default_p_degree_impl;
+        constexpr auto algo = d_impl::template algo<T>;
+
+        if constexpr (algo == 3) {
+            // The truncation will involve only key-based
+            // filtering. We need to be able to lt-compare U
+            // to the partial degree type of the key (const lvalue
+            // ref vs rvalue).
+            using deg_t = typename d_impl::template ret_t<T>;
+
+            return is_less_than_comparable_v<::std::add_lvalue_reference_t<const remove_cvref_t<U>>, deg_t> ? 1 : 0;
+        } else {
+            // The key partial degree computation is not possible, or it
+            // involves the coefficient in addition to the key.
+            // NOTE: the case in which the coefficient is partial degree
+            // truncatable and the key does not support partial degree computation
+            // may eventually be handled in a default series implementation
+            // of truncate_p_degree().
+            return 0;
+        }
+    }
+}
+
+template <typename T, typename U>
+inline constexpr int poly_truncate_p_degree_algo = detail::poly_truncate_p_degree_algorithm_impl<T, U>();
+
+} // namespace detail
+
+// NOTE: perhaps we can extend the implementation in the future
+// to accept mutable rvalue references as well.
+template <typename T, typename U, ::std::enable_if_t<detail::poly_truncate_p_degree_algo<T &, U &&> != 0, int> = 0>
+inline void truncate_p_degree(T &x, U &&y_, const symbol_set &s)
+{
+    // Sanity checks.
+    static_assert(detail::poly_truncate_p_degree_algo<T &, U &&> == 1);
+
+    // Use the default functor for the extraction of the term partial degree.
+    using d_impl = customisation::internal::series_default_p_degree_impl;
+
+    // Extract the symbol indices.
+    const auto &ss = x.get_symbol_set();
+    const auto si = ::obake::detail::ss_intersect_idx(s, ss);
+
+    // Implement on top of filter().
+    // NOTE: d_extractor will strip out the cvref
+    // from T, thus we can just pass in T as-is.
+    ::obake::filter(x, [deg_ext = d_impl::d_extractor<T>{&s, &si, &ss}, &y = ::std::as_const(y_)](const auto &t) {
+        return !(y < deg_ext(t));
+    });
+}
+
+namespace detail
+{
+
+// Meta-programming for the selection of the
+// compose() algorithm.
+// NOTE: at this time, we support only the composition
+// of polynomials with non-series coefficients, in which the
+// polynomials being substituted have the same key type
+// as the original polynomial.
+template <typename T, typename U>
+constexpr auto poly_compose_algorithm_impl()
+{
+    using rT = remove_cvref_t<T>;
+
+    // Shortcut for signalling that the compose() implementation
+    // is not well-defined.
+    [[maybe_unused]] constexpr auto failure = ::std::make_pair(0, ::obake::detail::type_c<void>{});
+
+    if constexpr (!::std::conjunction_v<is_polynomial<rT>, is_polynomial<U>>) {
+        return failure;
+    } else if constexpr (poly_subs_algo<T, U> == 0) {
+        // The composition must be expressible as a substitution.
+        return failure;
+    } else {
+        using cf_t = series_cf_t<rT>;
+        using key_t = series_key_t<rT>;
+        using ret_t = poly_subs_ret_t<T, U>;
+
+        if constexpr (::std::conjunction_v<::std::negation<is_cvr_series<cf_t>>, is_polynomial<ret_t>,
+                                           ::std::is_same<series_key_t<U>, key_t>,
+                                           ::std::is_same<series_key_t<ret_t>, key_t>,
+                                           is_key_with_p_degree<const key_t &>>) {
+            using exp_t = ::obake::detail::key_p_degree_t<const key_t &>;
+
+            // Requirements:
+            // - the exponents must be integral values which can be
+            //   extracted from the monomials and from which
+            //   the monomials can be rebuilt,
+            // - the original coefficients and the substituted
+            //   polynomials must be convertible to the return type,
+            // - ret_t must support multiplication and exponentiation
+            //   (both returning ret_t) and in-place addition.
+            if constexpr (::std::conjunction_v<
+                              is_integral<exp_t>, is_semi_regular<exp_t>,
+                              is_detected<poly_monomial_unpack_t, key_t, exp_t>,
+                              ::std::is_constructible<key_t, const exp_t *, const exp_t *>,
+                              ::std::is_constructible<series_cf_t<ret_t>, const cf_t &>,
+                              ::std::is_constructible<ret_t, const U &>,
+                              ::std::is_same<ret_t, detected_t<poly_mul_ret_t, const ret_t &, const ret_t &>>,
+                              ::std::is_same<ret_t, detected_t<::obake::detail::pow_t, const ret_t &, const exp_t &>>,
+                              is_in_place_addable<ret_t &, ret_t>>) {
+                return ::std::make_pair(1, ::obake::detail::type_c<ret_t>{});
+            } else {
+                return failure;
+            }
+        } else {
+            return failure;
+        }
+    }
+}
+
+template <typename T, typename U>
+inline constexpr auto poly_compose_algorithm = detail::poly_compose_algorithm_impl<T, U>();
+
+template <typename T, typename U>
+inline constexpr int poly_compose_algo = poly_compose_algorithm<T, U>.first;
+
+template <typename T, typename U>
+using poly_compose_ret_t = typename decltype(poly_compose_algorithm<T, U>.second)::type;
+
+// Truncated composition: in addition to the requirements
+// for the untruncated composition, we need truncated
+// multiplication and truncation for ret_t.
+template <typename T, typename U, typename V>
+constexpr int poly_compose_truncated_degree_algorithm_impl()
+{
+    if constexpr (poly_compose_algo<T, U> == 0) {
+        return 0;
+    } else {
+        using ret_t = poly_compose_ret_t<T, U>;
+
+        return poly_mul_truncated_degree_algo<const ret_t &, const ret_t &, V> != 0
+                       && poly_truncate_degree_algo<ret_t &, const V &> != 0
+                   ? 1
+                   : 0;
+    }
+}
+
+template <typename T, typename U, typename V>
+constexpr int poly_compose_truncated_p_degree_algorithm_impl()
+{
+    if constexpr (poly_compose_algo<T, U> == 0) {
+        return 0;
+    } else {
+        using ret_t = poly_compose_ret_t<T, U>;
+
+        return poly_mul_truncated_p_degree_algo<const ret_t &, const ret_t &, V> != 0
+                       && poly_truncate_p_degree_algo<ret_t &, const V &> != 0
+                   ? 1
+                   : 0;
+    }
+}
+
+template <typename T, typename U, typename V>
+inline constexpr int poly_compose_truncated_degree_algo
+    = detail::poly_compose_truncated_degree_algorithm_impl<T, U, V>();
+
+template <typename T, typename U, typename V>
+inline constexpr int poly_compose_truncated_p_degree_algo
+    = detail::poly_compose_truncated_p_degree_algorithm_impl<T, U, V>();
+
+// Implementation of polynomial composition.
+// The substituted symbols are eliminated one at a time,
+// following a multivariate Horner scheme: the terms of x
+// are grouped by the exponent of the current symbol, the
+// groups are composed recursively (in parallel) and the
+// results are then combined via Horner's rule. In the
+// untruncated case, the powers of the substituted polynomials
+// are computed via pow(), and thus they are shared via the
+// pow cache.
+// The optional arguments are the truncation limits
+// (total degree, or partial degree and the symbol set).
+template <typename Ret, typename T, typename U, typename... Args>
+inline Ret poly_compose_impl(const T &x, const symbol_map<U> &sm, const Args &... args)
+{
+    using key_t = series_key_t<T>;
+    using exp_t = ::obake::detail::key_p_degree_t<const key_t &>;
+
+    static_assert(sizeof...(args) <= 2u);
+
+    if (x.empty()) {
+        return Ret{};
+    }
+
+    const auto &ss = x.get_symbol_set();
+    const auto n_syms = ss.size();
+
+    // Determine the indices of the substituted symbols
+    // in ss, and the merged symbol set of the return value.
+    ::std::vector<symbol_idx> sub_idx;
+    ::std::vector<const U *> sub_polys;
+    auto merged_ss = ss;
+    for (symbol_idx i = 0; i < n_syms; ++i) {
+        const auto it = sm.find(*ss.nth(i));
+
+        if (it != sm.end()) {
+            sub_idx.push_back(i);
+            sub_polys.push_back(&it->second);
+
+            merged_ss = ::std::get<0>(::obake::detail::merge_symbol_sets(merged_ss, it->second.get_symbol_set()));
+        }
+    }
+
+    // Convert the substituted polynomials to Ret, with
+    // the merged symbol set, so that no symbol merging
+    // is necessary during the multiplications.
+    ::std::vector<Ret> qs;
+    qs.reserve(static_cast<decltype(qs.size())>(sub_polys.size()));
+    for (auto q : sub_polys) {
+        qs.push_back(::obake::add_symbols(Ret(*q), merged_ss));
+    }
+
+    // Flatten the exponents of x. The exponents of the i-th
+    // term are stored in the [i * n_syms, (i + 1) * n_syms) range of t_exps.
+    ::std::vector<exp_t> t_exps(
+        ::obake::safe_cast<typename ::std::vector<exp_t>::size_type>(::mppp::integer<1>(x.size()) * n_syms));
+    ::std::vector<const series_cf_t<T> *> t_cfs;
+    t_cfs.reserve(static_cast<decltype(t_cfs.size())>(x.size()));
+    for (const auto &t : x) {
+        monomial_unpack(t.first, ss, t_exps.data() + t_cfs.size() * n_syms);
+        t_cfs.push_back(&t.second);
+    }
+
+    if constexpr (sizeof...(args) > 0u && is_signed_v<exp_t>) {
+        // NOTE: the truncation of the intermediate results
+        // in the Horner scheme is correct only if the multiplications
+        // by the powers of the substituted polynomials cannot
+        // decrease the degree. Thus, we require non-negative
+        // exponents in the substituted polynomials (for the
+        // symbols involved in the truncation) and for the
+        // substituted symbols in x. With unsigned exponents,
+        // this is always the case.
+        for (const auto &i : sub_idx) {
+            for (decltype(t_cfs.size()) j = 0; j < t_cfs.size(); ++j) {
+                if (obake_unlikely(t_exps[j * n_syms + i] < exp_t(0))) {
+                    obake_throw(::std::invalid_argument,
+                                "Cannot compute a truncated polynomial composition if the exponents of the "
+                                "substituted symbols are negative");
+                }
+            }
+        }
+
+        const auto trunc_idx = [&]() {
+            if constexpr (sizeof...(args) == 1u) {
+                ::std::vector<symbol_idx> retval(merged_ss.size());
+                ::std::iota(retval.begin(), retval.end(), symbol_idx(0));
+                return retval;
+            } else {
+                const auto &s = ::std::get<1>(::std::forward_as_tuple(args...));
+                const auto si = ::obake::detail::ss_intersect_idx(s, merged_ss);
+                return ::std::vector<symbol_idx>(si.begin(), si.end());
+            }
+        }();
+        ::std::vector<exp_t> q_exps(static_cast<decltype(q_exps.size())>(merged_ss.size()));
+        for (const auto &q : qs) {
+            for (const auto &t : q) {
+                monomial_unpack(t.first, merged_ss, q_exps.data());
+
+                for (const auto &i : trunc_idx) {
+                    if (obake_unlikely(q_exps[static_cast<decltype(q_exps.size())>(i)] < exp_t(0))) {
+                        obake_throw(::std::invalid_argument,
+                                    "Cannot compute a truncated polynomial composition if the polynomials being "
+                                    "substituted contain negative exponents");
+                    }
+                }
+            }
+        }
+    }
 
-template <typename T, typename U>
-inline constexpr int poly_truncate_degree_algo = detail::poly_truncate_degree_algorithm_impl<T, U>();
+    // The positions of the symbols of ss in merged_ss.
+    ::std::vector<symbol_idx> m_pos;
+    m_pos.reserve(static_cast<decltype(m_pos.size())>(n_syms));
+    for (const auto &s : ss) {
+        m_pos.push_back(static_cast<symbol_idx>(merged_ss.index_of(merged_ss.find(s))));
+    }
 
-} // namespace detail
+    // Helpers for the (possibly truncated) multiplication
+    // and for the truncation of the leaves.
+    auto mul = [&args...](const Ret &a, const Ret &b) -> Ret {
+        if constexpr (sizeof...(args) == 0u) {
+            return a * b;
+        } else {
+            return polynomials::truncated_mul(a, b, args...);
+        }
+    };
+    auto trunc = [&args...](Ret &a) {
+        if constexpr (sizeof...(args) == 1u) {
+            polynomials::truncate_degree(a, args...);
+        } else if constexpr (sizeof...(args) == 2u) {
+            polynomials::truncate_p_degree(a, args...);
+        } else {
+            ::obake::detail::ignore(a);
+        }
+    };
+    // NOTE: in the truncated case, the powers are computed via
+    // repeated truncated multiplications (binary exponentiation),
+    // so that no untruncated intermediate power is ever built.
+    auto q_pow = [&](const Ret &q, const exp_t &d) -> Ret {
+        if constexpr (sizeof...(args) == 0u) {
+            return ::obake::pow(q, d);
+        } else {
+            assert(d > exp_t(0));
 
-// NOTE: perhaps we can extend the implementation in the future
-// to accept mutable rvalue references as well.
-template <typename T, typename U, ::std::enable_if_t<detail::poly_truncate_degree_algo<T &, U &&> != 0, int> = 0>
-inline void truncate_degree(T &x, U &&y_)
-{
-    // Sanity checks.
-    static_assert(detail::poly_truncate_degree_algo<T &, U &&> == 1);
+            ::std::optional<Ret> retval;
+            auto base = q;
+            for (auto n = d;;) {
+                if (n % exp_t(2) == exp_t(1)) {
+                    retval = retval ? mul(*retval, base) : base;
+                }
+                n /= exp_t(2);
+                if (n == exp_t(0)) {
+                    break;
+                }
+                base = mul(base, base);
+            }
 
-    // Use the default functor for the extraction of the term degree.
-    using d_impl = customisation::internal::series_default_degree_impl;
+            return ::std::move(*retval);
+        }
+    };
 
-    // Implement on top of filter().
-    // NOTE: d_extractor will strip out the cvref
-    // from T, thus we can just pass in T as-is.
-    ::obake::filter(x, [deg_ext = d_impl::d_extractor<T>{&x.get_symbol_set()},
-                        &y = ::std::as_const(y_)](const auto &t) { return !(y < deg_ext(t)); });
-}
+    // The recursive Horner scheme, operating on the
+    // [b, e) range of term indices, and starting from the
+    // substituted symbol at index j in sub_idx.
+    auto horner = [&](auto &self, ::std::size_t *b, ::std::size_t *e, ::std::size_t j) -> Ret {
+        assert(b != e);
+
+        if (j == sub_idx.size()) {
+            // All the substituted symbols have been eliminated:
+            // build the polynomial from the residual monomials
+            // of the terms in the range.
+            Ret leaf;
+            leaf.set_symbol_set(merged_ss);
+
+            ::std::vector<exp_t> m_exps(static_cast<decltype(m_exps.size())>(merged_ss.size()));
+            for (auto it = b; it != e; ++it) {
+                ::std::fill(m_exps.begin(), m_exps.end(), exp_t(0));
+                for (symbol_idx i = 0; i < n_syms; ++i) {
+                    m_exps[m_pos[i]] = t_exps[*it * n_syms + i];
+                }
+                for (const auto &i : sub_idx) {
+                    m_exps[m_pos[i]] = exp_t(0);
+                }
 
-namespace detail
-{
+                leaf.add_term(key_t(m_exps.data(), m_exps.data() + m_exps.size()), *t_cfs[*it]);
+            }
 
-// Meta-programming for the selection of the
-// truncate_p_degree() algorithm.
-// NOTE: at this time, we support only truncation
-// based on key filtering.
-template <typename T, typename U>
-constexpr int poly_truncate_p_degree_algorithm_impl()
-{
-    if constexpr (!is_polynomial_v<::std::remove_reference_t<T>>) {
-        // Not a mutable polynomial.
-        return 0;
-    } else {
-        // Check if we can compute the p_degree of the terms via the default
-        // implementation for series.
-        using d_impl = customisation::internal::series_default_p_degree_impl;
-        constexpr auto algo = d_impl::template algo<T>;
+            trunc(leaf);
 
-        if constexpr (algo == 3) {
-            // The truncation will involve only key-based
-            // filtering. We need to be able to lt-compare U
-            // to the partial degree type of the key (const lvalue
-            // ref vs rvalue).
-            using deg_t = typename d_impl::template ret_t<T>;
+            return leaf;
+        }
 
-            return is_less_than_comparable_v<::std::add_lvalue_reference_t<const remove_cvref_t<U>>, deg_t> ? 1 : 0;
-        } else {
-            // The key partial degree computation is not possible, or it
-            // involves the coefficient in addition to the key.
-            // NOTE: the case in which the coefficient is partial degree
-            // truncatable and the key does not support partial degree computation
-            // may eventually be handled in a default series implementation
-            // of truncate_p_degree().
-            return 0;
+        // Sort the terms in decreasing order
+        // of exponent for the current symbol.
+        const auto cur = sub_idx[j];
+        auto get_exp = [&](::std::size_t idx) -> const exp_t & { return t_exps[idx * n_syms + cur]; };
+        ::std::sort(b, e, [&get_exp](auto i1, auto i2) { return get_exp(i2) < get_exp(i1); });
+
+        // Determine the groups of terms with
+        // the same exponent.
+        ::std::vector<::std::size_t *> groups{b};
+        for (auto it = b + 1; it != e; ++it) {
+            if (get_exp(*it) != get_exp(*(it - 1))) {
+                groups.push_back(it);
+            }
         }
-    }
-}
+        groups.push_back(e);
+
+        // Compose the groups in parallel.
+        const auto n_groups = groups.size() - 1u;
+        ::std::vector<Ret> parts(n_groups);
+        ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, n_groups), [&](const auto &range) {
+            for (auto g = range.begin(); g != range.end(); ++g) {
+                parts[g] = self(self, groups[g], groups[g + 1u], j + 1u);
+            }
+        });
 
-template <typename T, typename U>
-inline constexpr int poly_truncate_p_degree_algo = detail::poly_truncate_p_degree_algorithm_impl<T, U>();
+        // Horner's rule.
+        const auto &q = qs[j];
+        auto acc = ::std::move(parts[0]);
+        for (::std::size_t g = 1; g < n_groups; ++g) {
+            const auto d = static_cast<exp_t>(get_exp(*groups[g - 1u]) - get_exp(*groups[g]));
+            acc = mul(acc, q_pow(q, d));
+            acc += ::std::move(parts[g]);
+        }
+        if (const auto &e_last = get_exp(*groups[n_groups - 1u]); e_last != exp_t(0)) {
+            acc = mul(acc, q_pow(q, e_last));
+        }
+
+        return acc;
+    };
+
+    ::std::vector<::std::size_t> t_idx(t_cfs.size());
+    ::std::iota(t_idx.begin(), t_idx.end(), ::std::size_t(0));
+
+    return horner(horner, t_idx.data(), t_idx.data() + t_idx.size(), 0);
+}
 
 } // namespace detail
 
-// NOTE: perhaps we can extend the implementation in the future
-// to accept mutable rvalue references as well.
-template <typename T, typename U, ::std::enable_if_t<detail::poly_truncate_p_degree_algo<T &, U &&> != 0, int> = 0>
-inline void truncate_p_degree(T &x, U &&y_, const symbol_set &s)
+// Polynomial composition: substitute the polynomials
+// in sm for the corresponding symbols in x.
+// The result is equal to subs(x, sm), but the computation
+// reuses the powers of the substituted polynomials and
+// minimises the number of multiplications.
+template <typename T, typename U, ::std::enable_if_t<detail::poly_compose_algo<T &&, U> != 0, int> = 0>
+inline detail::poly_compose_ret_t<T &&, U> compose(T &&x, const symbol_map<U> &sm)
 {
-    // Sanity checks.
-    static_assert(detail::poly_truncate_p_degree_algo<T &, U &&> == 1);
-
-    // Use the default functor for the extraction of the term partial degree.
-    using d_impl = customisation::internal::series_default_p_degree_impl;
+    return detail::poly_compose_impl<detail::poly_compose_ret_t<T &&, U>>(::std::as_const(x), sm);
+}
 
-    // Extract the symbol indices.
-    const auto &ss = x.get_symbol_set();
-    const auto si = ::obake::detail::ss_intersect_idx(s, ss);
+// Truncated composition: the result is equal to the
+// composition truncated to the total/partial degree max_degree.
+// NOTE: the truncated composition requires non-negative
+// exponents for the substituted symbols and in the
+// substituted polynomials.
+template <typename T, typename U, typename V,
+          ::std::enable_if_t<detail::poly_compose_truncated_degree_algo<T &&, U, V> != 0, int> = 0>
+inline detail::poly_compose_ret_t<T &&, U> compose(T &&x, const symbol_map<U> &sm, const V &max_degree)
+{
+    return detail::poly_compose_impl<detail::poly_compose_ret_t<T &&, U>>(::std::as_const(x), sm, max_degree);
+}
 
-    // Implement on top of filter().
-    // NOTE: d_extractor will strip out the cvref
-    // from T, thus we can just pass in T as-is.
-    ::obake::filter(x, [deg_ext = d_impl::d_extractor<T>{&s, &si, &ss}, &y = ::std::as_const(y_)](const auto &t) {
-        return !(y < deg_ext(t));
-    });
+template <typename T, typename U, typename V,
+          ::std::enable_if_t<detail::poly_compose_truncated_p_degree_algo<T &&, U, V> != 0, int> = 0>
+inline detail::poly_compose_ret_t<T &&, U> compose(T &&x, const symbol_map<U> &sm, const V &max_degree,
+                                                     const symbol_set &s)
+{
+    return detail::poly_compose_impl<detail::poly_compose_ret_t<T &&, U>>(::std::as_const(x), sm, max_degree, s);
 }
 
 namespace detail
 {
 
+// Helper to compute the difference between the hash of the
+// monomial with unitary exponent for the symbol at index idx
+// in ss (and zero exponents for all the other symbols) and the hash
+// of the monomial with all zero exponents. For monomials with
+// homomorphic hashing, this is the constant quantity that
+// is added to the hash of a monomial upon integration with respect
+// to the symbol at index idx (and subtracted upon differentiation).
+template <typename K>
+inline ::std::size_t poly_hh_unit_delta(const symbol_idx &idx, const symbol_set &ss)
+{
+    const K one(ss);
+
+    return static_cast<::std::size_t>(::obake::hash(::obake::monomial_integrate(one, idx, ss).second)
+                                      - ::obake::hash(one));
+}
+
+// Check if the segment-parallel implementation of diff()/integrate()
+// can be used on a polynomial with key type K.
+template <typename K>
+inline constexpr bool poly_diff_integrate_use_seg
+    = ::std::conjunction_v<is_homomorphically_hashable_monomial<K>, is_integrable_monomial<const K &>>;
+
 // Meta-programming for the selection of the
 // diff() algorithm.
 template <typename T>
@@ -2583,12 +4140,77 @@ inline detail::poly_diff_ret_t<T &&> diff(T &&x_, const ::std::string &s)
         // The return type must be the original poly type.
         static_assert(::std::is_same_v<ret_t, remove_cvref_t<T>>);
 
+        using key_t = series_key_t<ret_t>;
+
         // Init retval, using the same symbol set
-        // and segmentation from x, and reserving
-        // the same size as x.
+        // and segmentation from x.
         ret_t retval;
         retval.set_symbol_set(ss);
         retval.set_n_segments(x.get_s_size());
+
+        if constexpr (detail::poly_diff_integrate_use_seg<key_t>) {
+            if (x.get_s_size() > 0u) {
+                // Segmented layout with homomorphic hashing. The differentiation
+                // of the coefficient preserves the monomial, while the differentiation
+                // of the monomial subtracts a constant quantity from its hash.
+                // Thus, the terms in the i-th table of retval are generated
+                // from the terms of the i-th table of x and of the table whose
+                // index is shifted by the hash difference. We can then
+                // build the tables of retval in parallel.
+                const auto &in_tables = x._get_s_table();
+                auto &out_tables = retval._get_s_table();
+                const auto mask = in_tables.size() - 1u;
+                const auto delta = s_present ? detail::poly_hh_unit_delta<key_t>(idx, ss) : ::std::size_t(0);
+
+                ::tbb::parallel_for(
+                    ::tbb::blocked_range<decltype(out_tables.size())>(0, out_tables.size()), [&](const auto &range) {
+                        for (auto i = range.begin(); i != range.end(); ++i) {
+                            auto &table = out_tables[i];
+                            const auto &t_cf = in_tables[i];
+                            const auto &t_key = in_tables[static_cast<decltype(in_tables.size())>((i + delta) & mask)];
+
+                            table.reserve(t_cf.size() + (s_present ? t_key.size() : 0u));
+
+                            // NOTE: the monomials are compatible by construction, but
+                            // the other checks are still needed (see the comment
+                            // in the serial implementation below).
+                            for (const auto &[k, c] : t_cf) {
+                                ::obake::detail::series_add_term_table<true, ::obake::detail::sat_check_zero::on,
+                                                                       ::obake::detail::sat_check_compat_key::off,
+                                                                       ::obake::detail::sat_check_table_size::on,
+                                                                       ::obake::detail::sat_assume_unique::off>(
+                                    retval, table, k, ::obake::diff(c, s));
+                            }
+
+                            if (s_present) {
+                                for (const auto &[k, c] : t_key) {
+                                    auto key_diff(::obake::monomial_diff(k, idx, ss));
+
+                                    // NOTE: if the monomial did not change, the exponent
+                                    // of the symbol is zero and the term would vanish. Skip
+                                    // it, as the unchanged monomial does not belong
+                                    // to the current table (unless delta is zero modulo
+                                    // the number of tables).
+                                    if (key_diff.second == k) {
+                                        continue;
+                                    }
+
+                                    ::obake::detail::series_add_term_table<
+                                        true, ::obake::detail::sat_check_zero::on,
+                                        ::obake::detail::sat_check_compat_key::off,
+                                        ::obake::detail::sat_check_table_size::on,
+                                        ::obake::detail::sat_assume_unique::off>(
+                                        retval, table, ::std::move(key_diff.second), c * ::std::move(key_diff.first));
+                                }
+                            }
+                        }
+                    });
+
+                return retval;
+            }
+        }
+
+        // Reserve the same size as x.
         retval.reserve(x.size());
 
         for (const auto &t : x) {
@@ -2764,12 +4386,61 @@ inline detail::poly_integrate_ret_t<T &&> integrate(T &&x_, const ::std::string
             // The return type must be the original poly type.
             static_assert(::std::is_same_v<ret_t, rT>);
 
+            using key_t = series_key_t<ret_t>;
+
             // Init retval, using the same symbol set
-            // and segmentation from x, and reserving
-            // the same size as x.
+            // and segmentation from x.
             ret_t retval;
             retval.set_symbol_set(ss);
             retval.set_n_segments(x.get_s_size());
+
+            if constexpr (detail::poly_diff_integrate_use_seg<key_t>) {
+                if (x.get_s_size() > 0u) {
+                    // Segmented layout with homomorphic hashing. The integration
+                    // adds a constant quantity to the hash of each monomial, thus the
+                    // terms in the i-th table of retval are generated from a single
+                    // table of x, whose index is shifted by the hash difference.
+                    // We can then build the tables of retval in parallel.
+                    const auto &in_tables = x._get_s_table();
+                    auto &out_tables = retval._get_s_table();
+                    const auto mask = in_tables.size() - 1u;
+                    const auto delta = detail::poly_hh_unit_delta<key_t>(idx, ss);
+
+                    ::tbb::parallel_for(
+                        ::tbb::blocked_range<decltype(out_tables.size())>(0, out_tables.size()),
+                        [&](const auto &range) {
+                            for (auto i = range.begin(); i != range.end(); ++i) {
+                                auto &table = out_tables[i];
+                                const auto &t_in
+                                    = in_tables[static_cast<decltype(in_tables.size())>((i - delta) & mask)];
+
+                                table.reserve(t_in.size());
+
+                                for (const auto &[k, c] : t_in) {
+                                    if (obake_unlikely(!::obake::is_zero(::obake::diff(c, s)))) {
+                                        obake_throw(::std::invalid_argument, cf_diff_err_msg);
+                                    }
+
+                                    auto key_int(::obake::monomial_integrate(k, idx, ss));
+
+                                    // NOTE: the integrated monomials are unique and
+                                    // compatible by construction, but the
+                                    // division might produce a zero coefficient.
+                                    ::obake::detail::series_add_term_table<
+                                        true, ::obake::detail::sat_check_zero::on,
+                                        ::obake::detail::sat_check_compat_key::off,
+                                        ::obake::detail::sat_check_table_size::on,
+                                        ::obake::detail::sat_assume_unique::on>(
+                                        retval, table, ::std::move(key_int.second), c / ::std::move(key_int.first));
+                                }
+                            }
+                        });
+
+                    return retval;
+                }
+            }
+
+            // Reserve the same size as x.
             retval.reserve(x.size());
 
             for (const auto &t : x) {
@@ -2825,6 +4496,350 @@ inline detail::poly_integrate_ret_t<T &&> integrate(T &&x_, const ::std::string
     }
 }
 
+namespace detail
+{
+
+// Meta-programming for the selection of the
+// gradient() algorithm. If diff() can be implemented
+// via term insertions, and the nonzero exponents of the monomials
+// can be identified via key_trim_identify(), the gradient is computed
+// in a single pass over the terms of the polynomial. Otherwise,
+// diff() will be invoked separately for each symbol.
+template <typename T>
+constexpr int poly_gradient_algorithm_impl()
+{
+    if constexpr (poly_diff_algo<T> == 0) {
+        return 0;
+    } else {
+        using rT = remove_cvref_t<T>;
+
+        return poly_diff_algo<T> == 2
+                       && ::std::conjunction_v<is_trim_identifiable_key<const series_key_t<rT> &>,
+                                               is_zero_testable<const series_cf_t<rT> &>>
+                   ? 2
+                   : 1;
+    }
+}
+
+template <typename T>
+inline constexpr int poly_gradient_algo = detail::poly_gradient_algorithm_impl<T>();
+
+template <typename T, typename V>
+constexpr int poly_gradient_truncated_degree_algorithm_impl()
+{
+    if constexpr (poly_gradient_algo<T> == 0) {
+        return 0;
+    } else {
+        return poly_truncate_degree_algo<poly_diff_ret_t<T> &, const V &> != 0 ? poly_gradient_algo<T> : 0;
+    }
+}
+
+template <typename T, typename V>
+constexpr int poly_gradient_truncated_p_degree_algorithm_impl()
+{
+    if constexpr (poly_gradient_algo<T> == 0) {
+        return 0;
+    } else {
+        return poly_truncate_p_degree_algo<poly_diff_ret_t<T> &, const V &> != 0 ? poly_gradient_algo<T> : 0;
+    }
+}
+
+template <typename T, typename V>
+inline constexpr int poly_gradient_truncated_degree_algo
+    = detail::poly_gradient_truncated_degree_algorithm_impl<T, V>();
+
+template <typename T, typename V>
+inline constexpr int poly_gradient_truncated_p_degree_algo
+    = detail::poly_gradient_truncated_p_degree_algorithm_impl<T, V>();
+
+// Implementation of gradient(). T is the original type
+// of the polynomial (used for the algorithm selection), the
+// optional arguments are the truncation limits (total degree,
+// or partial degree and the symbol set).
+template <typename T, typename... Args>
+inline ::std::vector<poly_diff_ret_t<T>> poly_gradient_impl(const remove_cvref_t<T> &x, const Args &... args)
+{
+    using ret_t = poly_diff_ret_t<T>;
+    constexpr auto algo = poly_gradient_algo<T>;
+
+    static_assert(algo == 1 || algo == 2);
+    static_assert(sizeof...(args) <= 2u);
+
+    // Cache the symbol set.
+    const auto &ss = x.get_symbol_set();
+    const auto n_syms = ss.size();
+
+    ::std::vector<ret_t> retval(static_cast<decltype(retval.size())>(n_syms));
+
+    if constexpr (algo == 1) {
+        // Differentiate with respect to each symbol
+        // separately (in parallel), and truncate afterwards.
+        ::tbb::parallel_for(::tbb::blocked_range<symbol_idx>(0, n_syms), [&](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                retval[i] = polynomials::diff(x, *ss.nth(i));
+
+                if constexpr (sizeof...(args) == 1u) {
+                    polynomials::truncate_degree(retval[i], args...);
+                } else if constexpr (sizeof...(args) == 2u) {
+                    polynomials::truncate_p_degree(retval[i], args...);
+                }
+            }
+        });
+    } else {
+        using key_t = series_key_t<ret_t>;
+
+        static_assert(::std::is_same_v<ret_t, remove_cvref_t<T>>);
+
+        // Init the return values, using the same symbol
+        // set and segmentation as x.
+        for (auto &r : retval) {
+            r.set_symbol_set(ss);
+            r.set_n_segments(x.get_s_size());
+        }
+
+        // Helper to check if a term with key k must be
+        // kept in the output, according to the truncation limits.
+        [[maybe_unused]] const auto si = [&]() {
+            if constexpr (sizeof...(args) == 2u) {
+                return ::obake::detail::ss_intersect_idx(::std::get<1>(::std::forward_as_tuple(args...)), ss);
+            } else {
+                return symbol_idx_set{};
+            }
+        }();
+        auto keep = [&](const key_t &k) {
+            if constexpr (sizeof...(args) == 0u) {
+                ::obake::detail::ignore(k);
+
+                return true;
+            } else if constexpr (sizeof...(args) == 1u) {
+                return !(::std::get<0>(::std::forward_as_tuple(args...)) < ::obake::key_degree(k, ss));
+            } else {
+                return !(::std::get<0>(::std::forward_as_tuple(args...)) < ::obake::key_p_degree(k, si, ss));
+            }
+        };
+
+        // Process the term (k, c), emitting the contributions
+        // to all the derivatives. The contributions are passed to
+        // ins(), together with the index of the derivative and
+        // a flag signalling if the monomial was differentiated.
+        // NOTE: the nonzero exponents of the monomial are identified
+        // in a single pass via key_trim_identify(), so that only
+        // these exponents need to be differentiated.
+        auto proc_term = [&](::std::vector<int> &trim_v, const key_t &k, const auto &c, const auto &ins) {
+            ::std::fill(trim_v.begin(), trim_v.end(), 1);
+            ::obake::key_trim_identify(trim_v, k, ss);
+
+            const auto keep_k = keep(k);
+
+            for (symbol_idx i = 0; i < n_syms; ++i) {
+                if (keep_k) {
+                    auto cf_diff(::obake::diff(c, *ss.nth(i)));
+
+                    if (!::obake::is_zero(::std::as_const(cf_diff))) {
+                        ins(i, false, k, ::std::move(cf_diff));
+                    }
+                }
+
+                if (trim_v[i] == 0) {
+                    // The exponent of the i-th symbol
+                    // is not zero, differentiate the monomial.
+                    auto key_diff(::obake::monomial_diff(k, i, ss));
+
+                    if (keep(key_diff.second)) {
+                        ins(i, true, ::std::move(key_diff.second), c * ::std::move(key_diff.first));
+                    }
+                }
+            }
+        };
+
+        // The table insertion function.
+        auto add_to_table = [](ret_t &r, auto &table, auto &&key, auto &&cf) {
+            // NOTE: the monomials are compatible by construction, but
+            // cf and key derivatives may produce repeated monomials
+            // and zero coefficients.
+            ::obake::detail::series_add_term_table<
+                true, ::obake::detail::sat_check_zero::on, ::obake::detail::sat_check_compat_key::off,
+                ::obake::detail::sat_check_table_size::on, ::obake::detail::sat_assume_unique::off>(
+                r, table, ::std::forward<decltype(key)>(key), ::std::forward<decltype(cf)>(cf));
+        };
+
+        const auto &in_tables = x._get_s_table();
+
+        if constexpr (poly_diff_integrate_use_seg<key_t>) {
+            if (x.get_s_size() > 0u) {
+                // Segmented layout with homomorphic hashing. As explained
+                // in diff(), the differentiation of the monomials in the
+                // j-th table of x with respect to the i-th symbol produces
+                // monomials which all end up in the same table of the i-th
+                // derivative, whose index is j shifted by a constant. Thus, we can
+                // process the tables of x in parallel and insert the differentiated
+                // monomials without contention. The terms stemming from the
+                // differentiation of the coefficients instead end up in the j-th
+                // table of the derivatives: they are buffered, and inserted
+                // in a second parallel pass over the tables.
+                const auto mask = in_tables.size() - 1u;
+
+                ::std::vector<::std::size_t> deltas;
+                deltas.reserve(static_cast<decltype(deltas.size())>(n_syms));
+                for (symbol_idx i = 0; i < n_syms; ++i) {
+                    deltas.push_back(poly_hh_unit_delta<key_t>(i, ss));
+                }
+
+                ::std::vector<::std::vector<::std::tuple<symbol_idx, key_t, series_cf_t<ret_t>>>> cf_terms(
+                    in_tables.size());
+
+                ::tbb::parallel_for(
+                    ::tbb::blocked_range<decltype(in_tables.size())>(0, in_tables.size()), [&](const auto &range) {
+                        ::std::vector<int> trim_v(static_cast<::std::vector<int>::size_type>(n_syms));
+
+                        for (auto j = range.begin(); j != range.end(); ++j) {
+                            const auto &tab = in_tables[j];
+
+                            // Helper to fetch the table of the i-th derivative
+                            // into which the differentiated monomials
+                            // of tab are inserted.
+                            auto out_table = [&](symbol_idx i) -> auto & {
+                                return retval[i]._get_s_table()[static_cast<decltype(in_tables.size())>(
+                                    (j - deltas[i]) & mask)];
+                            };
+
+                            for (symbol_idx i = 0; i < n_syms; ++i) {
+                                out_table(i).reserve(tab.size());
+                            }
+
+                            for (const auto &[k, c] : tab) {
+                                proc_term(trim_v, k, c, [&](symbol_idx i, bool k_diff, auto &&key, auto &&cf) {
+                                    if (k_diff) {
+                                        add_to_table(retval[i], out_table(i), ::std::forward<decltype(key)>(key),
+                                                     ::std::forward<decltype(cf)>(cf));
+                                    } else {
+                                        cf_terms[j].emplace_back(i, ::std::forward<decltype(key)>(key),
+                                                                 ::std::forward<decltype(cf)>(cf));
+                                    }
+                                });
+                            }
+                        }
+                    });
+
+                ::tbb::parallel_for(
+                    ::tbb::blocked_range<decltype(in_tables.size())>(0, in_tables.size()), [&](const auto &range) {
+                        for (auto j = range.begin(); j != range.end(); ++j) {
+                            for (auto &[i, key, cf] : cf_terms[j]) {
+                                add_to_table(retval[i], retval[i]._get_s_table()[j], ::std::move(key), ::std::move(cf));
+                            }
+                        }
+                    });
+
+                return retval;
+            }
+        }
+
+        // Serial implementation.
+        for (auto &r : retval) {
+            r.reserve(x.size());
+        }
+
+        ::std::vector<int> trim_v(static_cast<::std::vector<int>::size_type>(n_syms));
+        for (const auto &[k, c] : x) {
+            proc_term(trim_v, k, c, [&](symbol_idx i, bool, auto &&key, auto &&cf) {
+                auto &r = retval[i];
+
+                if (r.get_s_size() == 0u) {
+                    add_to_table(r, r._get_s_table()[0], ::std::forward<decltype(key)>(key),
+                                 ::std::forward<decltype(cf)>(cf));
+                } else {
+                    ::obake::detail::series_add_term<true, ::obake::detail::sat_check_zero::on,
+                                                     ::obake::detail::sat_check_compat_key::off,
+                                                     ::obake::detail::sat_check_table_size::on,
+                                                     ::obake::detail::sat_assume_unique::off>(
+                        r, ::std::forward<decltype(key)>(key), ::std::forward<decltype(cf)>(cf));
+                }
+            });
+        }
+    }
+
+    return retval;
+}
+
+// Implementation of jacobian(): the polynomials are extended
+// to the union of their symbol sets, and their gradients are
+// computed in parallel.
+template <typename T, typename... Args>
+inline ::std::vector<::std::vector<poly_diff_ret_t<const T &>>> poly_jacobian_impl(const ::std::vector<T> &v,
+                                                                                  const Args &... args)
+{
+    symbol_set merged_ss;
+    for (const auto &p : v) {
+        merged_ss = ::std::get<0>(::obake::detail::merge_symbol_sets(merged_ss, p.get_symbol_set()));
+    }
+
+    ::std::vector<::std::vector<poly_diff_ret_t<const T &>>> retval(static_cast<decltype(retval.size())>(v.size()));
+
+    ::tbb::parallel_for(::tbb::blocked_range<decltype(v.size())>(0, v.size()), [&](const auto &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            if (v[i].get_symbol_set() == merged_ss) {
+                retval[i] = detail::poly_gradient_impl<const T &>(v[i], args...);
+            } else {
+                retval[i] = detail::poly_gradient_impl<const T &>(::obake::add_symbols(v[i], merged_ss), args...);
+            }
+        }
+    });
+
+    return retval;
+}
+
+} // namespace detail
+
+// Gradient of a polynomial: the return value contains
+// the derivatives of x with respect to all the symbols
+// in its symbol set (in the same order).
+template <typename T, ::std::enable_if_t<detail::poly_gradient_algo<T &&> != 0, int> = 0>
+inline ::std::vector<detail::poly_diff_ret_t<T &&>> gradient(T &&x)
+{
+    return detail::poly_gradient_impl<T &&>(x);
+}
+
+// Truncated gradient: the derivatives are truncated
+// to the total/partial degree max_degree.
+template <typename T, typename V,
+          ::std::enable_if_t<detail::poly_gradient_truncated_degree_algo<T &&, V> != 0, int> = 0>
+inline ::std::vector<detail::poly_diff_ret_t<T &&>> gradient(T &&x, const V &max_degree)
+{
+    return detail::poly_gradient_impl<T &&>(x, max_degree);
+}
+
+template <typename T, typename V,
+          ::std::enable_if_t<detail::poly_gradient_truncated_p_degree_algo<T &&, V> != 0, int> = 0>
+inline ::std::vector<detail::poly_diff_ret_t<T &&>> gradient(T &&x, const V &max_degree, const symbol_set &s)
+{
+    return detail::poly_gradient_impl<T &&>(x, max_degree, s);
+}
+
+// Jacobian of a vector of polynomials: the i-th element
+// of the return value is the gradient of v[i] with respect to
+// the union of the symbol sets of the polynomials in v.
+template <typename T, ::std::enable_if_t<detail::poly_gradient_algo<const T &> != 0, int> = 0>
+inline ::std::vector<::std::vector<detail::poly_diff_ret_t<const T &>>> jacobian(const ::std::vector<T> &v)
+{
+    return detail::poly_jacobian_impl(v);
+}
+
+template <typename T, typename V,
+          ::std::enable_if_t<detail::poly_gradient_truncated_degree_algo<const T &, V> != 0, int> = 0>
+inline ::std::vector<::std::vector<detail::poly_diff_ret_t<const T &>>> jacobian(const ::std::vector<T> &v,
+                                                                                const V &max_degree)
+{
+    return detail::poly_jacobian_impl(v, max_degree);
+}
+
+template <typename T, typename V,
+          ::std::enable_if_t<detail::poly_gradient_truncated_p_degree_algo<const T &, V> != 0, int> = 0>
+inline ::std::vector<::std::vector<detail::poly_diff_ret_t<const T &>>>
+jacobian(const ::std::vector<T> &v, const V &max_degree, const symbol_set &s)
+{
+    return detail::poly_jacobian_impl(v, max_degree, s);
+}
+
 } // namespace polynomials
 
 } // namespace obake
@@ -10,13 +10,21 @@
 #define OBAKE_SERIES_HPP
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <functional>
+#include <istream>
 #include <iterator>
+#include <limits>
 #include <mutex>
 #include <numeric>
+#include <optional>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
@@ -29,6 +37,10 @@
 #include <utility>
 #include <vector>
 
+// NOTE: internal abseil header used to compute
+// the probe lengths in series::get_table_stats().
+#include <absl/container/internal/hashtable_debug.h>
+
 #include <boost/any.hpp>
 #include <boost/container/container_fwd.hpp>
 #include <boost/container/small_vector.hpp>
@@ -41,6 +53,7 @@
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
 
 #include <mp++/integer.hpp>
 
@@ -50,8 +63,10 @@
 #include <obake/config.hpp>
 #include <obake/detail/abseil.hpp>
 #include <obake/detail/fcast.hpp>
+#include <obake/detail/hc.hpp>
 #include <obake/detail/ignore.hpp>
 #include <obake/detail/limits.hpp>
+#include <obake/detail/mmap_file.hpp>
 #include <obake/detail/not_implemented.hpp>
 #include <obake/detail/priority_tag.hpp>
 #include <obake/detail/safe_integral_arith.hpp>
@@ -74,6 +89,7 @@
 #include <obake/key/key_trim_identify.hpp>
 #include <obake/math/degree.hpp>
 #include <obake/math/evaluate.hpp>
+#include <obake/math/fma3.hpp>
 #include <obake/math/is_zero.hpp>
 #include <obake/math/negate.hpp>
 #include <obake/math/p_degree.hpp>
@@ -81,6 +97,8 @@
 #include <obake/math/safe_cast.hpp>
 #include <obake/math/safe_convert.hpp>
 #include <obake/math/trim.hpp>
+#include <obake/native_s11n.hpp>
+#include <obake/ranges.hpp>
 #include <obake/s11n.hpp>
 #include <obake/symbols.hpp>
 #include <obake/tex_stream_insert.hpp>
@@ -271,6 +289,30 @@ enum class sat_check_compat_key : bool { off, on };
 enum class sat_check_table_size : bool { off, on };
 enum class sat_assume_unique : bool { off, on };
 
+// Helper to check that a key is compatible with the
+// symbol set ss of a series. If the check fails, an
+// exception will be raised.
+template <typename K>
+inline void series_check_key_compat(const K &key, const symbol_set &ss)
+{
+    if (obake_unlikely(!::obake::key_is_compatible(key, ss))) {
+        // The key is not compatible with the symbol set.
+        if constexpr (is_stream_insertable_v<const K &>) {
+            // A slightly better error message if we can
+            // produce a string representation of the key.
+            ::std::ostringstream oss;
+            static_cast<::std::ostream &>(oss) << key;
+            obake_throw(::std::invalid_argument, "Cannot add a term to a series: the term's key, '" + oss.str()
+                                                     + "', is not compatible with the series' symbol set, "
+                                                     + detail::to_string(ss));
+        } else {
+            obake_throw(::std::invalid_argument, "Cannot add a term to a series: the term's key is not "
+                                                 "compatible with the series' symbol set, "
+                                                     + detail::to_string(ss));
+        }
+    }
+}
+
 // Helper for inserting a term into a series table.
 template <bool Sign, sat_check_zero CheckZero, sat_check_compat_key CheckCompatKey, sat_check_table_size CheckTableSize,
           sat_assume_unique AssumeUnique, typename S, typename Table, typename T, typename... Args>
@@ -299,22 +341,7 @@ inline void series_add_term_table(S &s, Table &t, T &&key, Args &&... args)
 
     if constexpr (CheckCompatKey == sat_check_compat_key::on) {
         // Check key for compatibility, if requested.
-        if (obake_unlikely(!::obake::key_is_compatible(::std::as_const(key), ss))) {
-            // The key is not compatible with the symbol set.
-            if constexpr (is_stream_insertable_v<const key_type &>) {
-                // A slightly better error message if we can
-                // produce a string representation of the key.
-                ::std::ostringstream oss;
-                static_cast<::std::ostream &>(oss) << ::std::as_const(key);
-                obake_throw(::std::invalid_argument, "Cannot add a term to a series: the term's key, '" + oss.str()
-                                                         + "', is not compatible with the series' symbol set, "
-                                                         + detail::to_string(ss));
-            } else {
-                obake_throw(::std::invalid_argument, "Cannot add a term to a series: the term's key is not "
-                                                     "compatible with the series' symbol set, "
-                                                         + detail::to_string(ss));
-            }
-        }
+        detail::series_check_key_compat(::std::as_const(key), ss);
     } else {
         // Otherwise, assert that the key is compatible.
         // There are no situations so far in which we may
@@ -581,6 +608,206 @@ struct series_rref_clearer {
     T &&m_ref;
 };
 
+// Plan for the parallel redistribution of n items among
+// n_dest destinations, where dest[i] is the destination of the
+// i-th item. The items are split into contiguous chunks, and the
+// items of each chunk are sorted (in parallel, via a counting sort)
+// according to their destinations. The items destined to each
+// destination can then be visited in their original order.
+// NOTE: the number of chunks is bounded by both the available
+// parallelism and n / n_dest. The per-chunk counters thus
+// require O(n + n_dest) memory, rather than O(n_dest**2)
+// as it would be with one chunk per destination.
+class series_scatter_plan
+{
+public:
+    template <typename Dest>
+    explicit series_scatter_plan(const Dest &dest, ::std::size_t n_dest)
+        : m_n_dest(n_dest),
+          m_n_chunks(::std::max(::std::size_t(1), ::std::min(static_cast<::std::size_t>(detail::hc()) * 4u,
+                                                              static_cast<::std::size_t>(dest.size()) / n_dest))),
+          m_offsets(m_n_chunks * (n_dest + 1u)), m_perm(static_cast<::std::size_t>(dest.size()))
+    {
+        assert(n_dest > 0u);
+
+        const auto n = m_perm.size();
+        const auto chunk_size = n / m_n_chunks + static_cast<::std::size_t>(n % m_n_chunks != 0u);
+
+        ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, m_n_chunks), [&](const auto &range) {
+            ::std::vector<::std::size_t> pos;
+
+            for (auto c = range.begin(); c != range.end(); ++c) {
+                const auto begin = ::std::min(c * chunk_size, n);
+                const auto end = ::std::min(begin + chunk_size, n);
+
+                // Count the number of items destined to each
+                // destination, and compute the (absolute) offsets.
+                const auto offsets = m_offsets.data() + c * (n_dest + 1u);
+                offsets[0] = begin;
+                for (auto j = begin; j < end; ++j) {
+                    ++offsets[static_cast<::std::size_t>(dest[j]) + 1u];
+                }
+                ::std::partial_sum(offsets, offsets + n_dest + 1u, offsets);
+
+                // Counting sort.
+                pos.assign(offsets, offsets + n_dest);
+                for (auto j = begin; j < end; ++j) {
+                    m_perm[pos[static_cast<::std::size_t>(dest[j])]++] = j;
+                }
+            }
+        });
+    }
+
+    // Number of items destined to d.
+    ::std::size_t count(::std::size_t d) const
+    {
+        assert(d < m_n_dest);
+
+        ::std::size_t retval = 0;
+        for (::std::size_t c = 0; c < m_n_chunks; ++c) {
+            const auto offsets = m_offsets.data() + c * (m_n_dest + 1u);
+            retval += offsets[d + 1u] - offsets[d];
+        }
+
+        return retval;
+    }
+
+    // Invoke f on the index of each item destined to d.
+    template <typename F>
+    void for_each(::std::size_t d, const F &f) const
+    {
+        assert(d < m_n_dest);
+
+        for (::std::size_t c = 0; c < m_n_chunks; ++c) {
+            const auto offsets = m_offsets.data() + c * (m_n_dest + 1u);
+            for (auto idx = offsets[d]; idx < offsets[d + 1u]; ++idx) {
+                f(m_perm[idx]);
+            }
+        }
+    }
+
+private:
+    ::std::size_t m_n_dest;
+    ::std::size_t m_n_chunks;
+    // The offsets of the ranges of items destined to each
+    // destination, for each chunk (n_dest + 1 entries per chunk).
+    ::std::vector<::std::size_t> m_offsets;
+    // The indices of the items, sorted by destination within each chunk.
+    ::std::vector<::std::size_t> m_perm;
+};
+
+// Helper to merge (via addition or subtraction, depending on Sign)
+// the terms of the series rhs into the series lhs. lhs and rhs must
+// have the same symbol set, and they must be distinct objects.
+// If lhs is segmented, the merge is performed in parallel over the
+// tables of lhs. If the segmentations of lhs and rhs match, table i
+// of rhs is merged directly into table i of lhs, otherwise the terms
+// of rhs are first bucketed in parallel according to the segmentation
+// of lhs.
+// NOTE: if rhs is a mutable rvalue, its coefficients will be moved
+// into lhs. It is up to the caller to clear out rhs afterwards.
+template <bool Sign, typename S1, typename S2>
+inline void series_merge_terms(S1 &lhs, S2 &&rhs)
+{
+    assert(lhs.get_symbol_set() == rhs.get_symbol_set());
+    assert(static_cast<const void *>(&lhs) != static_cast<const void *>(&rhs));
+
+    // Helper to merge the term of rhs into the table t of lhs.
+    // NOTE: turn on the zero check, as we might end up
+    // annihilating terms during insertion. Compatibility check
+    // is not needed.
+    auto merge_term = [&lhs](auto &t, auto &term, auto check_ts) {
+        constexpr auto cts = decltype(check_ts)::value;
+
+        if constexpr (is_mutable_rvalue_reference_v<S2 &&>) {
+            detail::series_add_term_table<Sign, sat_check_zero::on, sat_check_compat_key::off, cts,
+                                          sat_assume_unique::off>(lhs, t, term.first, ::std::move(term.second));
+        } else {
+            detail::series_add_term_table<Sign, sat_check_zero::on, sat_check_compat_key::off, cts,
+                                          sat_assume_unique::off>(lhs, t, term.first, ::std::as_const(term.second));
+        }
+    };
+
+    using ts_on_t = ::std::integral_constant<sat_check_table_size, sat_check_table_size::on>;
+    using ts_off_t = ::std::integral_constant<sat_check_table_size, sat_check_table_size::off>;
+
+    auto &l_tables = lhs._get_s_table();
+    auto &r_tables = rhs._get_s_table();
+    const auto n_tables = l_tables.size();
+
+    if (n_tables == 1u) {
+        // NOTE: disable the table size check, as we are
+        // sure we have a single table.
+        auto &t = l_tables[0];
+
+        for (auto &r_table : r_tables) {
+            for (auto &term : r_table) {
+                merge_term(t, term, ts_off_t{});
+            }
+        }
+
+        return;
+    }
+
+    if (lhs.get_s_size() == rhs.get_s_size()) {
+        // Same segmentation: the terms in table i
+        // of rhs can end up only in table i of lhs.
+        ::tbb::parallel_for(::tbb::blocked_range<decltype(l_tables.size())>(0, n_tables),
+                            [&l_tables, &r_tables, &merge_term](const auto &range) {
+                                for (auto i = range.begin(); i != range.end(); ++i) {
+                                    auto &t = l_tables[i];
+
+                                    for (auto &term : r_tables[i]) {
+                                        merge_term(t, term, ts_on_t{});
+                                    }
+                                }
+                            });
+
+        return;
+    }
+
+    // Different segmentations. In a first phase, we collect
+    // (in parallel) pointers to the terms of rhs, together with
+    // their destination tables in lhs, and we sort them according
+    // to their destinations. In a second phase, the terms are
+    // merged (in parallel) into the tables of lhs.
+    const auto mask = n_tables - 1u;
+    const auto n_r_tables = r_tables.size();
+
+    ::std::vector<::std::size_t> r_offsets(n_r_tables + 1u, 0);
+    for (decltype(r_tables.size()) i = 0; i < n_r_tables; ++i) {
+        r_offsets[i + 1u] = r_offsets[i] + r_tables[i].size();
+    }
+    const auto tot = r_offsets.back();
+
+    using term_ptr_t = decltype(&*r_tables[0].begin());
+    ::std::vector<term_ptr_t> r_ptrs(tot);
+    ::std::vector<::std::size_t> dest(tot);
+
+    ::tbb::parallel_for(::tbb::blocked_range<decltype(r_tables.size())>(0, n_r_tables),
+                        [&r_tables, &r_offsets, &r_ptrs, &dest, mask](const auto &range) {
+                            for (auto i = range.begin(); i != range.end(); ++i) {
+                                auto idx = r_offsets[i];
+                                for (auto &term : r_tables[i]) {
+                                    r_ptrs[idx] = &term;
+                                    dest[idx] = static_cast<::std::size_t>(::obake::hash(term.first) & mask);
+                                    ++idx;
+                                }
+                            }
+                        });
+
+    const series_scatter_plan plan(dest, n_tables);
+
+    ::tbb::parallel_for(::tbb::blocked_range<decltype(l_tables.size())>(0, n_tables),
+                        [&l_tables, &r_ptrs, &plan, &merge_term](const auto &range) {
+                            for (auto j = range.begin(); j != range.end(); ++j) {
+                                auto &t = l_tables[j];
+
+                                plan.for_each(j, [&](::std::size_t idx) { merge_term(t, *r_ptrs[idx], ts_on_t{}); });
+                            }
+                        });
+}
+
 // Helper to extend the keys of "from" with the symbol insertion map ins_map.
 // The new series will be written to "to". The coefficient type of "to"
 // may be different from the coefficient type of "from", in which case a coefficient
@@ -678,6 +905,272 @@ inline void series_sym_extender(To &to, From &&from, const symbol_idx_map<symbol
 
 } // namespace detail
 
+// Policy for the automatic re-segmentation of series.
+// When the policy is enabled, the number of segments of a series
+// is adjusted as the series grows (via add_term() and add/sub operations)
+// and shrinks (via add/sub operations and filtering), so that the
+// estimated memory footprint of each segment stays in the neighbourhood
+// of segment_bytes.
+struct series_segmentation_policy {
+    // Switch for the automatic re-segmentation.
+    bool enabled = false;
+    // Target size (in bytes) of a segment.
+    ::std::size_t segment_bytes = ::std::size_t(1) << 18;
+    // Maximum number of segments (in log2 units)
+    // that will be set by the automatic re-segmentation.
+    unsigned max_log2_size = 10;
+};
+
+namespace detail
+{
+
+// The global segmentation policy.
+OBAKE_DLL_PUBLIC extern ::std::atomic_bool series_seg_policy_enabled;
+OBAKE_DLL_PUBLIC extern ::std::atomic<::std::size_t> series_seg_policy_segment_bytes;
+OBAKE_DLL_PUBLIC extern ::std::atomic<unsigned> series_seg_policy_max_log2_size;
+
+} // namespace detail
+
+// Getter/setter for the global segmentation policy.
+// NOTE: the members of the policy are stored separately, thus
+// a get_series_segmentation_policy() running concurrently with
+// a set_series_segmentation_policy() may return a mix
+// of the old and new policies.
+inline series_segmentation_policy get_series_segmentation_policy()
+{
+    series_segmentation_policy retval;
+
+    retval.enabled = detail::series_seg_policy_enabled.load(::std::memory_order_relaxed);
+    retval.segment_bytes = detail::series_seg_policy_segment_bytes.load(::std::memory_order_relaxed);
+    retval.max_log2_size = detail::series_seg_policy_max_log2_size.load(::std::memory_order_relaxed);
+
+    return retval;
+}
+
+inline void set_series_segmentation_policy(const series_segmentation_policy &p)
+{
+    if (obake_unlikely(p.segment_bytes == 0u)) {
+        obake_throw(::std::invalid_argument,
+                    "The target segment size in a series segmentation policy must be nonzero");
+    }
+
+    detail::series_seg_policy_segment_bytes.store(p.segment_bytes, ::std::memory_order_relaxed);
+    detail::series_seg_policy_max_log2_size.store(p.max_log2_size, ::std::memory_order_relaxed);
+    detail::series_seg_policy_enabled.store(p.enabled, ::std::memory_order_relaxed);
+}
+
+namespace detail
+{
+
+// The global memory budget.
+OBAKE_DLL_PUBLIC extern ::std::atomic<::std::size_t> series_mem_budget;
+
+} // namespace detail
+
+// Getter/setter for the global memory budget (in bytes). Operations
+// which estimate their memory footprint in advance (currently, the
+// multi-threaded polynomial multiplication) fail early with an
+// std::length_error if the estimate exceeds the budget, rather
+// than attempting the allocation. A budget of zero (the default)
+// means no limit.
+inline ::std::size_t get_memory_budget()
+{
+    return detail::series_mem_budget.load(::std::memory_order_relaxed);
+}
+
+inline void set_memory_budget(::std::size_t b)
+{
+    detail::series_mem_budget.store(b, ::std::memory_order_relaxed);
+}
+
+// Helper to set the global memory budget within
+// a scope, restoring the previous value on exit.
+class memory_budget_guard
+{
+public:
+    explicit memory_budget_guard(::std::size_t b) : m_old(::obake::get_memory_budget())
+    {
+        ::obake::set_memory_budget(b);
+    }
+    ~memory_budget_guard()
+    {
+        ::obake::set_memory_budget(m_old);
+    }
+    memory_budget_guard(const memory_budget_guard &) = delete;
+    memory_budget_guard(memory_budget_guard &&) = delete;
+    memory_budget_guard &operator=(const memory_budget_guard &) = delete;
+    memory_budget_guard &operator=(memory_budget_guard &&) = delete;
+
+private:
+    ::std::size_t m_old;
+};
+
+// Statistics about the hash tables of a series,
+// as returned by series::get_table_stats().
+struct series_table_stats {
+    // Statistics for a single table.
+    struct table_info {
+        ::std::size_t size = 0;
+        ::std::size_t capacity = 0;
+        double load_factor = 0;
+        // Mean/max probe length for the terms in the table, in
+        // groups of slots (zero means found in the first group).
+        // NOTE: these are computed only if has_probe_lengths is true.
+        double mean_probe_length = 0;
+        ::std::size_t max_probe_length = 0;
+    };
+
+    ::std::size_t n_terms = 0;
+    ::std::size_t n_tables = 0;
+    ::std::size_t min_terms = 0;
+    ::std::size_t max_terms = 0;
+    double mean_terms = 0;
+    // Coefficient of variation of the number of terms
+    // per table (zero means perfect balance).
+    double imbalance = 0;
+    ::std::size_t total_capacity = 0;
+    double load_factor = 0;
+    // Whether or not the probe lengths were computed.
+    bool has_probe_lengths = false;
+    double mean_probe_length = 0;
+    ::std::size_t max_probe_length = 0;
+    // Number of bytes taken by the slots not holding any term.
+    ::std::size_t slack_bytes = 0;
+    ::std::size_t total_bytes = 0;
+    // Number of tables whose load factor falls in the
+    // intervals [0, 0.1), [0.1, 0.2), ..., [0.9, 1].
+    ::std::array<::std::size_t, 10> occupancy_histogram{};
+    ::std::vector<table_info> tables;
+
+    // Human-readable and JSON representations.
+    OBAKE_DLL_PUBLIC ::std::string to_string() const;
+    OBAKE_DLL_PUBLIC ::std::string to_json() const;
+};
+
+namespace detail
+{
+
+// The maximum number of terms in a segment according
+// to the policy p, given the estimated size in bytes
+// of a term.
+inline ::std::size_t series_seg_policy_max_n_terms(const series_segmentation_policy &p, ::std::size_t term_bytes)
+{
+    assert(term_bytes > 0u);
+
+    return ::std::max(::std::size_t(1), p.segment_bytes / term_bytes);
+}
+
+// Determine the number of segments (in log2 units) for a series
+// with n terms and 2**l segments, according to the policy p.
+// term_bytes is the estimated size in bytes of a term, max_l
+// the maximum number of segments allowed by the series type.
+// If no re-segmentation is needed, l will be returned.
+inline unsigned series_seg_policy_target(const series_segmentation_policy &p, unsigned l, ::std::size_t n,
+                                         ::std::size_t term_bytes, unsigned max_l)
+{
+    assert(l < static_cast<unsigned>(limits_digits<::std::size_t>));
+
+    max_l = ::std::min(max_l, p.max_log2_size);
+
+    const auto max_n = detail::series_seg_policy_max_n_terms(p, term_bytes);
+    // The average number of terms in a segment.
+    const auto avg_n = n >> l;
+
+    // NOTE: re-segment upwards only when the segments
+    // are full on average, and downwards only when they are
+    // mostly empty. In either case, the new number of segments
+    // is the smallest one for which the segments are filled at most
+    // up to half of their target size. This ensures that
+    // the series can grow and shrink to some extent before
+    // another re-segmentation is triggered.
+    if ((avg_n > max_n && l < max_l) || (l > 0u && avg_n < max_n / 8u)) {
+        unsigned retval = 0;
+        while (retval < max_l && (n >> retval) > max_n / 2u) {
+            ++retval;
+        }
+
+        return retval;
+    }
+
+    return l;
+}
+
+// Run the automatic re-segmentation of s,
+// if enabled in the global policy.
+template <typename S>
+inline void series_maybe_auto_segment(S &s)
+{
+    if (obake_unlikely(detail::series_seg_policy_enabled.load(::std::memory_order_relaxed))) {
+        s.auto_segment(::obake::get_series_segmentation_policy());
+    }
+}
+
+} // namespace detail
+
+// Uniqueness assumption for the bulk insertion
+// of terms via series::add_terms().
+// NOTE: with assume_unique, the keys of the terms being
+// inserted must be distinct from each other and from
+// the keys already present in the series.
+enum class add_terms_mode { checked, assume_unique };
+
+namespace detail
+{
+
+// The reference type of the range R.
+// NOTE: the range will be iterated over
+// as an lvalue.
+template <typename R>
+using series_add_terms_ref_t =
+    typename ::std::iterator_traits<detected_t<range_begin_t, ::std::add_lvalue_reference_t<R>>>::reference;
+
+// Types of the elements of the pair-like
+// elements of the range R.
+template <typename R>
+using series_add_terms_key_t = decltype(::std::get<0>(::std::declval<series_add_terms_ref_t<R>>()));
+
+template <typename R>
+using series_add_terms_cf_t = decltype(::std::get<1>(::std::declval<series_add_terms_ref_t<R>>()));
+
+// Check if the keys/cfs in the range R will be moved
+// during bulk insertion. This happens if R is a mutable
+// rvalue and its elements are mutable.
+template <typename R>
+inline constexpr bool series_add_terms_move
+    = ::std::conjunction_v<is_mutable_rvalue_reference<R>,
+                           ::std::negation<::std::is_const<::std::remove_reference_t<series_add_terms_ref_t<R>>>>>;
+
+// Check if the terms in the range R can be inserted
+// in bulk into a series with key K and coefficient C.
+template <typename R, typename K, typename C>
+constexpr bool series_add_terms_enabled_impl()
+{
+    // NOTE: the range must be a forward range yielding lvalue
+    // references, as we will be storing pointers to its elements
+    // (with a single-pass range, the references may all point
+    // to the same object).
+    if constexpr (::std::conjunction_v<is_forward_range<::std::add_lvalue_reference_t<R>>,
+                                       ::std::is_lvalue_reference<detected_t<series_add_terms_ref_t, R>>>) {
+        using key_t = detected_t<series_add_terms_key_t, R>;
+        using cf_t = detected_t<series_add_terms_cf_t, R>;
+
+        if constexpr (series_add_terms_move<R>) {
+            return ::std::conjunction_v<::std::is_same<remove_cvref_t<key_t>, K>,
+                                        ::std::is_constructible<C, ::std::remove_reference_t<cf_t> &&>>;
+        } else {
+            return ::std::conjunction_v<::std::is_same<remove_cvref_t<key_t>, K>,
+                                        ::std::is_constructible<C, const remove_cvref_t<cf_t> &>>;
+        }
+    } else {
+        return false;
+    }
+}
+
+template <typename R, typename K, typename C>
+inline constexpr bool series_add_terms_enabled = detail::series_add_terms_enabled_impl<R, K, C>();
+
+} // namespace detail
+
 // NOTE: document that moved-from series are destructible and assignable.
 #if defined(OBAKE_HAVE_CONCEPTS)
 template <Key K, Cf C, typename Tag>
@@ -703,6 +1196,13 @@ private:
     // this amount.
     static constexpr unsigned max_log2_size = static_cast<unsigned>(detail::limits_digits<s_size_type> - 1);
 
+    // Estimate of the memory footprint of a term
+    // in a table, used by the automatic re-segmentation.
+    // NOTE: abseil's flat_hash_map stores one control byte
+    // per slot, in addition to the slot itself. Memory
+    // dynamically allocated by the key/cf is not accounted for.
+    static constexpr ::std::size_t term_bytes = sizeof(typename table_type::value_type) + 1u;
+
 public:
     using size_type = typename table_type::size_type;
 
@@ -1273,6 +1773,17 @@ public:
         return iterator(&m_s_table, m_s_table.size());
     }
 
+    // Splittable range over the segments of the series,
+    // suitable for use with TBB's parallel algorithms. The
+    // elements of the range are the tables of the series,
+    // and the keys of the terms in the i-th table hash to i
+    // modulo the number of segments.
+    auto segments(s_size_type grainsize = 1) const
+    {
+        return ::tbb::blocked_range<typename s_table_type::const_iterator>(m_s_table.begin(), m_s_table.end(),
+                                                                            grainsize);
+    }
+
     const symbol_set &get_symbol_set() const
     {
         return m_symbol_set;
@@ -1320,128 +1831,645 @@ public:
 #endif
         void add_term(T &&key, Args &&... args)
     {
+        if (obake_unlikely(detail::series_seg_policy_enabled.load(::std::memory_order_relaxed))) {
+            // The automatic re-segmentation is enabled. Determine
+            // the destination table before the insertion, so that
+            // we can check its size afterwards.
+            auto &s_table = _get_s_table();
+            const auto idx = s_table.size() == 1u ? s_size_type(0)
+                                                  : static_cast<s_size_type>(::obake::hash(::std::as_const(key))
+                                                                             & (s_table.size() - 1u));
+
+            detail::series_add_term_table<Sign, detail::sat_check_zero::on, detail::sat_check_compat_key::on,
+                                          detail::sat_check_table_size::on, detail::sat_assume_unique::off>(
+                *this, s_table[idx], ::std::forward<T>(key), ::std::forward<Args>(args)...);
+
+            // NOTE: checking only the destination table keeps
+            // the cost of the check constant. The full check on the
+            // total size is run only if this table is full.
+            const auto p = ::obake::get_series_segmentation_policy();
+            if (s_table[idx].size() > detail::series_seg_policy_max_n_terms(p, term_bytes)) {
+                auto_segment(p);
+            }
+
+            return;
+        }
+
         // NOTE: all checks enabled, don't assume uniqueness.
         detail::series_add_term<Sign, detail::sat_check_zero::on, detail::sat_check_compat_key::on,
                                 detail::sat_check_table_size::on, detail::sat_assume_unique::off>(
             *this, ::std::forward<T>(key), ::std::forward<Args>(args)...);
     }
 
-    // Set the number of segments (in log2 units).
-    void set_n_segments(unsigned l)
+    // Bulk insertion of the terms in the range r, whose
+    // elements are pair-like (key, cf) objects.
+    // The keys are validated in parallel before any insertion
+    // takes place, and then the terms are sorted according to their
+    // destination table and inserted into the tables in parallel.
+    // If r is a mutable rvalue, the keys/cfs will be moved
+    // into the series.
+    // If an exception is thrown, the terms of the series are
+    // left unchanged (although its segmentation may have been
+    // adjusted, and the elements of r may have been moved from).
+    // NOTE: like add_term(), this method requires that the terms
+    // being inserted are not from this series.
+    template <bool Sign = true, typename R,
+              ::std::enable_if_t<detail::series_add_terms_enabled<R &&, K, C>, int> = 0>
+    void add_terms(R &&r, add_terms_mode mode = add_terms_mode::checked)
     {
-        if (obake_unlikely(l > max_log2_size)) {
-            obake_throw(::std::invalid_argument, "Cannot set the number of segments to 2**" + detail::to_string(l)
-                                                     + ", as this value exceeds the maximum allowed value (2**"
-                                                     + detail::to_string(max_log2_size) + ")");
-        }
+        using elem_t = ::std::remove_reference_t<detail::series_add_terms_ref_t<R &&>>;
 
-        // NOTE: construct + move assign for exception safety.
-        m_s_table = s_table_type(s_size_type(1) << l);
-        m_log2_size = l;
-    }
+        // Collect pointers to the elements of r.
+        ::std::vector<elem_t *> ptrs;
+        for (auto &e : r) {
+            ptrs.push_back(&e);
+        }
+        const auto n = ptrs.size();
 
-    // Remove all the terms in the series.
-    // The number of segments and the symbol set will be kept intact.
-    void clear_terms() noexcept
-    {
-        for (auto &t : m_s_table) {
-            t.clear();
+        if (n == 0u) {
+            return;
         }
-    }
 
-    // Clear the series.
-    // This will remove all the terms and symbols.
-    // The number of segments will be kept intact.
-    void clear() noexcept
-    {
-        clear_terms();
-        m_symbol_set.clear();
-    }
+        // If the automatic re-segmentation is enabled, adjust
+        // the segmentation in view of the final size of the series.
+        // NOTE: the final size is estimated assuming that
+        // all the new terms are unique.
+        if (detail::series_seg_policy_enabled.load(::std::memory_order_relaxed)) {
+            const auto l = detail::series_seg_policy_target(::obake::get_series_segmentation_policy(), m_log2_size,
+                                                            static_cast<::std::size_t>(size()) + n, term_bytes,
+                                                            max_log2_size);
+            if (l > m_log2_size) {
+                resegment(l);
+            }
+        }
 
-private:
-    // Implementation of find(), for both the const and mutable
-    // variants.
-    template <typename S>
-    static auto find_impl(S &s, const K &k)
-    {
-        // The return type will be iterator/const_iterator, depending on the
-        // constness of S.
-        using ret_it_t = ::std::conditional_t<::std::is_const_v<S>, const_iterator, iterator>;
+        auto &s_table = _get_s_table();
+        const auto n_tables = s_table.size();
+        const auto mask = n_tables - 1u;
 
-        // Helper to find k in a single table belonging
-        // to a segmented table st at index idx.
-        auto find_single_table = [&s, &k](auto &st, s_size_type idx) {
-            assert(idx < st.size());
+        // Validate the keys and compute their destination
+        // tables, in parallel.
+        ::std::vector<s_size_type> dest(n_tables > 1u ? n : 0u);
+        ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, n), [&](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                const auto &k = ::std::get<0>(::std::as_const(*ptrs[i]));
 
-            // Get out a reference to the table.
-            auto &t = st[idx];
+                detail::series_check_key_compat(k, m_symbol_set);
 
-            // Find k in the table.
-            const auto local_ret = t.find(k);
+                if (n_tables > 1u) {
+                    dest[i] = static_cast<s_size_type>(::obake::hash(k) & mask);
+                }
+            }
+        });
 
-            if (local_ret == t.end()) {
-                // k not found, return the end iterator of
-                // the series.
-                return s.end();
+        // Helper to insert the element e into the table t.
+        // NOTE: the compatibility check was already performed above.
+        // The zero check is needed, and the table size check too
+        // (unless we have a single table).
+        auto insert = [this, mode](table_type &t, elem_t &e, auto check_ts) {
+            constexpr auto cts = decltype(check_ts)::value;
+
+            auto &&k = ::std::get<0>(e);
+            auto &&c = ::std::get<1>(e);
+
+            if (mode == add_terms_mode::assume_unique) {
+                if constexpr (detail::series_add_terms_move<R &&>) {
+                    detail::series_add_term_table<Sign, detail::sat_check_zero::on, detail::sat_check_compat_key::off,
+                                                  cts, detail::sat_assume_unique::on>(*this, t, ::std::move(k),
+                                                                                      ::std::move(c));
+                } else {
+                    detail::series_add_term_table<Sign, detail::sat_check_zero::on, detail::sat_check_compat_key::off,
+                                                  cts, detail::sat_assume_unique::on>(*this, t, ::std::as_const(k),
+                                                                                      ::std::as_const(c));
+                }
             } else {
-                // k found, build the corresponding
-                // series iterator.
-                return ret_it_t(&st, idx, local_ret);
+                if constexpr (detail::series_add_terms_move<R &&>) {
+                    detail::series_add_term_table<Sign, detail::sat_check_zero::on, detail::sat_check_compat_key::off,
+                                                  cts, detail::sat_assume_unique::off>(*this, t, ::std::move(k),
+                                                                                       ::std::move(c));
+                } else {
+                    detail::series_add_term_table<Sign, detail::sat_check_zero::on, detail::sat_check_compat_key::off,
+                                                  cts, detail::sat_assume_unique::off>(*this, t, ::std::as_const(k),
+                                                                                       ::std::as_const(c));
+                }
             }
         };
 
-        const auto s_table_size = s.m_s_table.size();
-        if (s_table_size == 1u) {
-            // Single table case.
-            return find_single_table(s.m_s_table, 0);
-        } else {
-            // Segmented table case.
-            const auto k_hash = ::obake::hash(k);
-            const auto idx = static_cast<s_size_type>(k_hash & (s_table_size - 1u));
-            return find_single_table(s.m_s_table, idx);
-        }
-    }
-
-public:
-    // Lookup.
-    const_iterator find(const K &k) const
-    {
-        return series::find_impl(*this, k);
-    }
-    iterator find(const K &k)
-    {
-        return series::find_impl(*this, k);
-    }
+        // The log of the changes made to a table which was not empty
+        // before the insertion: for each inserted term, its key and
+        // (if the key was already present) its original coefficient.
+        using undo_log_t = ::std::vector<::std::pair<K, ::std::optional<C>>>;
+
+        // Helper to insert the element e into the table t, which was
+        // not empty before the insertion, recording the change in log.
+        // NOTE: unlike insert(), this helper never clears out t if
+        // an exception is thrown: the coefficient is converted before
+        // touching t, and the original coefficient of an existing term
+        // is saved before being modified. The mode is ignored, as we
+        // need to look up the key anyway.
+        auto insert_logged = [this](table_type &t, elem_t &e, undo_log_t &log) {
+            auto &&k = ::std::get<0>(e);
+            auto cf = [&c = ::std::get<1>(e)]() {
+                if constexpr (detail::series_add_terms_move<R &&>) {
+                    return C(::std::move(c));
+                } else {
+                    return C(::std::as_const(c));
+                }
+            }();
 
-    // Return a bunch of statistics
-    // about the hash table(s) in string
-    // format.
-    ::std::string table_stats() const
-    {
-        ::std::ostringstream oss;
+            if (const auto it = t.find(k); it != t.end()) {
+                log.emplace_back(it->first, it->second);
 
-        const auto s = size();
-        const auto ntables = m_s_table.size();
+                if constexpr (Sign) {
+                    it->second += ::std::move(cf);
+                } else {
+                    it->second -= ::std::move(cf);
+                }
 
-        oss << "Total number of terms             : " << s << '\n';
-        oss << "Total number of tables            : " << ntables << '\n';
+                if (obake_unlikely(::obake::is_zero(::std::as_const(it->second)))) {
+                    t.erase(it);
+                }
+            } else {
+                if constexpr (!Sign) {
+                    ::obake::negate(cf);
+                }
 
-        if (s != 0u) {
-            oss << "Average terms per table           : " << static_cast<double>(s) / static_cast<double>(ntables)
-                << '\n';
-            const auto [it_min, it_max] = ::std::minmax_element(
-                m_s_table.cbegin(), m_s_table.cend(),
-                [](const table_type &t1, const table_type &t2) { return t1.size() < t2.size(); });
-            oss << "Min/max terms per table           : " << it_min->size() << '/' << it_max->size() << '\n';
-        }
+                if (obake_unlikely(::obake::key_is_zero(k, m_symbol_set) || ::obake::is_zero(::std::as_const(cf)))) {
+                    return;
+                }
 
-        oss << "Total size in bytes               : " << ::obake::byte_size(*this) << '\n';
+                if (obake_unlikely(t.size() == _get_max_table_size())) {
+                    // LCOV_EXCL_START
+                    obake_throw(::std::overflow_error,
+                                "Cannot attempt the insertion of a new term into a series: the destination table "
+                                "already contains the maximum number of terms ("
+                                    + detail::to_string(_get_max_table_size()) + ")");
+                    // LCOV_EXCL_STOP
+                }
 
-        return oss.str();
-    }
+                log.emplace_back(k, ::std::nullopt);
 
-private:
-    // Serialisation.
+                if constexpr (detail::series_add_terms_move<R &&>) {
+                    t.try_emplace(::std::move(k), ::std::move(cf));
+                } else {
+                    t.try_emplace(k, ::std::move(cf));
+                }
+            }
+        };
+
+        // Record which tables were empty before the insertion:
+        // in case of errors, these can simply be cleared out, while
+        // the changes to the other tables are undone via their logs.
+        ::std::vector<char> was_empty(n_tables);
+        for (s_size_type i = 0; i < n_tables; ++i) {
+            was_empty[i] = s_table[i].empty();
+        }
+        ::std::vector<undo_log_t> logs(n_tables);
+
+        using ts_on_t = ::std::integral_constant<detail::sat_check_table_size, detail::sat_check_table_size::on>;
+        using ts_off_t = ::std::integral_constant<detail::sat_check_table_size, detail::sat_check_table_size::off>;
+
+        try {
+            if (n_tables == 1u) {
+                auto &t = s_table[0];
+                t.reserve(t.size() + n);
+
+                if (was_empty[0]) {
+                    for (auto *e : ptrs) {
+                        insert(t, *e, ts_off_t{});
+                    }
+                } else {
+                    for (auto *e : ptrs) {
+                        insert_logged(t, *e, logs[0]);
+                    }
+                }
+            } else {
+                // Sort (in parallel) the elements according
+                // to their destination tables.
+                const detail::series_scatter_plan plan(dest, n_tables);
+
+                // Reserve space and insert the terms,
+                // in parallel over the tables.
+                ::tbb::parallel_for(::tbb::blocked_range<s_size_type>(0, n_tables), [&](const auto &range) {
+                    for (auto i = range.begin(); i != range.end(); ++i) {
+                        auto &t = s_table[i];
+
+                        t.reserve(t.size() + plan.count(i));
+                        if (was_empty[i]) {
+                            plan.for_each(i, [&](::std::size_t idx) { insert(t, *ptrs[idx], ts_on_t{}); });
+                        } else {
+                            plan.for_each(i, [&](::std::size_t idx) { insert_logged(t, *ptrs[idx], logs[i]); });
+                        }
+                    }
+                });
+            }
+        } catch (...) {
+            // Restore the original terms before rethrowing, undoing
+            // the changes in reverse order.
+            for (s_size_type i = 0; i < n_tables; ++i) {
+                auto &t = s_table[i];
+
+                if (was_empty[i]) {
+                    t = table_type{};
+                } else {
+                    auto &log = logs[i];
+                    for (auto it = log.rbegin(); it != log.rend(); ++it) {
+                        if (it->second) {
+                            t.insert_or_assign(::std::move(it->first), ::std::move(*it->second));
+                        } else {
+                            t.erase(it->first);
+                        }
+                    }
+                }
+            }
+
+            throw;
+        }
+    }
+
+    // Set the number of segments (in log2 units).
+    void set_n_segments(unsigned l)
+    {
+        if (obake_unlikely(l > max_log2_size)) {
+            obake_throw(::std::invalid_argument, "Cannot set the number of segments to 2**" + detail::to_string(l)
+                                                     + ", as this value exceeds the maximum allowed value (2**"
+                                                     + detail::to_string(max_log2_size) + ")");
+        }
+
+        // NOTE: construct + move assign for exception safety.
+        m_s_table = s_table_type(s_size_type(1) << l);
+        m_log2_size = l;
+    }
+
+    // Change the number of segments (in log2 units),
+    // keeping the terms of the series. The terms are
+    // redistributed in parallel among the new segments.
+    void resegment(unsigned l)
+    {
+        if (obake_unlikely(l > max_log2_size)) {
+            obake_throw(::std::invalid_argument, "Cannot re-segment a series into 2**" + detail::to_string(l)
+                                                     + " segments, as this value exceeds the maximum allowed value "
+                                                       "(2**"
+                                                     + detail::to_string(max_log2_size) + ")");
+        }
+
+        if (l == m_log2_size) {
+            return;
+        }
+
+        using term_t = typename table_type::value_type;
+
+        s_table_type new_s_table(s_size_type(1) << l);
+        const auto n_new = new_s_table.size();
+
+        // NOTE: if the coefficients can be moved without throwing,
+        // they are moved into the new tables, and, in case of errors,
+        // they are moved back into the original tables. Otherwise,
+        // they are copied. In either case, the series is left
+        // untouched if an exception is thrown (this matters because
+        // re-segmentation may be triggered implicitly by the automatic
+        // segmentation policy).
+        constexpr bool move_cfs
+            = ::std::conjunction_v<::std::is_nothrow_move_constructible<C>, ::std::is_nothrow_move_assignable<C>>;
+
+        // Helper to move (or copy) the term t into the table table.
+        // NOTE: the insertion must be successful, as we
+        // are not changing the original keys.
+        auto move_term = [](table_type &table, term_t &t) {
+            if constexpr (move_cfs) {
+                [[maybe_unused]] const auto res = table.try_emplace(t.first, ::std::move(t.second));
+                assert(res.second);
+            } else {
+                [[maybe_unused]] const auto res = table.try_emplace(t.first, ::std::as_const(t.second));
+                assert(res.second);
+            }
+        };
+
+        try {
+            if (l < m_log2_size) {
+                // Fewer segments: the terms in the i-th table
+                // of the new segmented table are those contained
+                // in the tables with index i + k * n_new (for k = 0, 1, ...)
+                // of the current segmented table. No need
+                // to compute the hashes of the keys.
+                const auto n_old = m_s_table.size();
+
+                ::tbb::parallel_for(::tbb::blocked_range<s_size_type>(0, n_new), [&](const auto &range) {
+                    for (auto i = range.begin(); i != range.end(); ++i) {
+                        auto &table = new_s_table[i];
+
+                        size_type tot = 0;
+                        for (auto j = i; j < n_old; j += n_new) {
+                            tot += m_s_table[j].size();
+                        }
+                        table.reserve(tot);
+
+                        for (auto j = i; j < n_old; j += n_new) {
+                            for (auto &t : m_s_table[j]) {
+                                move_term(table, t);
+                            }
+                        }
+                    }
+                });
+            } else {
+                // More segments. Collect pointers to all the terms,
+                // together with their destination tables (in parallel,
+                // table by table), then sort them (in parallel) according
+                // to their destinations, and finally fill each new table
+                // (in parallel) with the terms destined to it.
+                // NOTE: this way we can parallelise also
+                // the common case in which the series has
+                // a single segment.
+                ::std::vector<::std::size_t> t_offsets(m_s_table.size() + 1u, 0);
+                for (s_size_type i = 0; i < m_s_table.size(); ++i) {
+                    t_offsets[i + 1u] = t_offsets[i] + m_s_table[i].size();
+                }
+                const auto tot = t_offsets.back();
+
+                const auto mask = n_new - 1u;
+                ::std::vector<term_t *> ptrs(tot);
+                ::std::vector<::std::size_t> dest(tot);
+                ::tbb::parallel_for(::tbb::blocked_range<s_size_type>(0, m_s_table.size()), [&](const auto &range) {
+                    for (auto i = range.begin(); i != range.end(); ++i) {
+                        auto idx = t_offsets[i];
+                        for (auto &t : m_s_table[i]) {
+                            ptrs[idx] = &t;
+                            dest[idx] = static_cast<::std::size_t>(::obake::hash(t.first) & mask);
+                            ++idx;
+                        }
+                    }
+                });
+
+                const detail::series_scatter_plan plan(dest, n_new);
+
+                ::tbb::parallel_for(::tbb::blocked_range<s_size_type>(0, n_new), [&](const auto &range) {
+                    for (auto i = range.begin(); i != range.end(); ++i) {
+                        auto &table = new_s_table[i];
+
+                        table.reserve(plan.count(i));
+                        plan.for_each(i, [&](::std::size_t idx) { move_term(table, *ptrs[idx]); });
+                    }
+                });
+            }
+        } catch (...) {
+            if constexpr (move_cfs) {
+                // NOTE: if something threw, we may have moved away
+                // some coefficients. Move them back into the original
+                // terms (which are still in the original tables)
+                // before rethrowing.
+                const auto old_mask = m_s_table.size() - 1u;
+
+                for (auto &table : new_s_table) {
+                    for (auto &t : table) {
+                        auto &old_table = m_s_table[static_cast<s_size_type>(::obake::hash(t.first) & old_mask)];
+                        const auto it = old_table.find(t.first);
+                        assert(it != old_table.end());
+                        it->second = ::std::move(t.second);
+                    }
+                }
+            }
+
+            throw;
+        }
+
+        m_s_table = ::std::move(new_s_table);
+        m_log2_size = l;
+    }
+
+    // Adjust the number of segments according
+    // to the segmentation policy p.
+    // NOTE: the 'enabled' flag of p is ignored.
+    void auto_segment(const series_segmentation_policy &p)
+    {
+        const auto l = detail::series_seg_policy_target(p, m_log2_size, static_cast<::std::size_t>(size()),
+                                                        term_bytes, max_log2_size);
+
+        if (l != m_log2_size) {
+            resegment(l);
+        }
+    }
+    void auto_segment()
+    {
+        auto_segment(::obake::get_series_segmentation_policy());
+    }
+
+    // Remove all the terms in the series.
+    // The number of segments and the symbol set will be kept intact.
+    void clear_terms() noexcept
+    {
+        for (auto &t : m_s_table) {
+            t.clear();
+        }
+    }
+
+    // Clear the series.
+    // This will remove all the terms and symbols.
+    // The number of segments will be kept intact.
+    void clear() noexcept
+    {
+        clear_terms();
+        m_symbol_set.clear();
+    }
+
+    // Release the memory allocated by the tables in excess
+    // of what is needed to store the current terms (e.g.,
+    // after a large number of deletions).
+    void shrink_to_fit()
+    {
+        for (auto &t : m_s_table) {
+            t.rehash(0);
+        }
+    }
+
+private:
+    // Implementation of find(), for both the const and mutable
+    // variants.
+    template <typename S>
+    static auto find_impl(S &s, const K &k)
+    {
+        // The return type will be iterator/const_iterator, depending on the
+        // constness of S.
+        using ret_it_t = ::std::conditional_t<::std::is_const_v<S>, const_iterator, iterator>;
+
+        // Helper to find k in a single table belonging
+        // to a segmented table st at index idx.
+        auto find_single_table = [&s, &k](auto &st, s_size_type idx) {
+            assert(idx < st.size());
+
+            // Get out a reference to the table.
+            auto &t = st[idx];
+
+            // Find k in the table.
+            const auto local_ret = t.find(k);
+
+            if (local_ret == t.end()) {
+                // k not found, return the end iterator of
+                // the series.
+                return s.end();
+            } else {
+                // k found, build the corresponding
+                // series iterator.
+                return ret_it_t(&st, idx, local_ret);
+            }
+        };
+
+        const auto s_table_size = s.m_s_table.size();
+        if (s_table_size == 1u) {
+            // Single table case.
+            return find_single_table(s.m_s_table, 0);
+        } else {
+            // Segmented table case.
+            const auto k_hash = ::obake::hash(k);
+            const auto idx = static_cast<s_size_type>(k_hash & (s_table_size - 1u));
+            return find_single_table(s.m_s_table, idx);
+        }
+    }
+
+public:
+    // Lookup.
+    const_iterator find(const K &k) const
+    {
+        return series::find_impl(*this, k);
+    }
+    iterator find(const K &k)
+    {
+        return series::find_impl(*this, k);
+    }
+
+    // Order-independent hash of the keys of the series.
+    // Identical series (i.e., series with the same symbol set
+    // and the same terms) have the same content hash. The hash
+    // is computed in parallel if the series is segmented.
+    // NOTE: the hash is not cached, because the tables can be
+    // mutated directly via _get_s_table() (e.g., by the
+    // multiplication routines), and thus a cached value could
+    // silently become stale.
+    ::std::size_t content_hash() const
+    {
+        // Helper to compute the hash of the keys in a table.
+        // NOTE: combine the hashes via addition, so that the
+        // order of the terms does not matter.
+        auto hash_table = [](const table_type &t) {
+            ::std::size_t retval = 0;
+
+            for (const auto &p : t) {
+                retval += detail::series_key_hasher{}(p.first);
+            }
+
+            return retval;
+        };
+
+        ::std::size_t retval;
+        if (m_s_table.size() == 1u) {
+            retval = hash_table(m_s_table[0]);
+        } else {
+            retval = ::tbb::parallel_reduce(
+                ::tbb::blocked_range<s_size_type>(0, m_s_table.size()), ::std::size_t(0),
+                [this, &hash_table](const auto &range, ::std::size_t cur) {
+                    for (auto i = range.begin(); i != range.end(); ++i) {
+                        cur += hash_table(m_s_table[i]);
+                    }
+                    return cur;
+                },
+                [](::std::size_t a, ::std::size_t b) { return a + b; });
+        }
+
+        return retval;
+    }
+
+    // Return a bunch of statistics
+    // about the hash table(s).
+    // NOTE: the probe lengths require looking up
+    // all the keys, thus they are computed only
+    // if probe_lengths is true.
+    series_table_stats get_table_stats(bool probe_lengths = false) const
+    {
+        series_table_stats retval;
+
+        const auto ntables = static_cast<::std::size_t>(m_s_table.size());
+        retval.n_tables = ntables;
+        retval.has_probe_lengths = probe_lengths;
+        retval.tables.resize(ntables);
+
+        // Compute the stats for the individual tables.
+        auto compute = [this, &retval, probe_lengths](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                const auto &tab = m_s_table[static_cast<s_size_type>(i)];
+                auto &ti = retval.tables[i];
+
+                ti.size = static_cast<::std::size_t>(tab.size());
+                ti.capacity = static_cast<::std::size_t>(tab.capacity());
+                ti.load_factor
+                    = ti.capacity == 0u ? 0. : static_cast<double>(ti.size) / static_cast<double>(ti.capacity);
+
+                if (probe_lengths) {
+                    ::std::size_t tot_probes = 0;
+                    for (const auto &t : tab) {
+                        const auto np = ::absl::container_internal::GetHashtableDebugNumProbes(tab, t.first);
+                        tot_probes += np;
+                        ti.max_probe_length = ::std::max(ti.max_probe_length, np);
+                    }
+                    ti.mean_probe_length
+                        = ti.size == 0u ? 0. : static_cast<double>(tot_probes) / static_cast<double>(ti.size);
+                }
+            }
+        };
+        // NOTE: the probe lengths require hashing all the keys,
+        // thus compute them in parallel for segmented series.
+        if (probe_lengths && ntables > 1u) {
+            ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, ntables), compute);
+        } else {
+            compute(::tbb::blocked_range<::std::size_t>(0, ntables));
+        }
+
+        // Aggregate.
+        retval.min_terms = ::std::numeric_limits<::std::size_t>::max();
+        double tot_probes = 0;
+        for (const auto &ti : retval.tables) {
+            retval.n_terms += ti.size;
+            retval.total_capacity += ti.capacity;
+            retval.min_terms = ::std::min(retval.min_terms, ti.size);
+            retval.max_terms = ::std::max(retval.max_terms, ti.size);
+            retval.max_probe_length = ::std::max(retval.max_probe_length, ti.max_probe_length);
+            tot_probes += ti.mean_probe_length * static_cast<double>(ti.size);
+
+            // NOTE: the load factor is at most 1,
+            // put it in the last bin in that case.
+            const auto bin = ::std::min(static_cast<::std::size_t>(ti.load_factor * 10), ::std::size_t(9));
+            ++retval.occupancy_histogram[bin];
+        }
+
+        retval.mean_terms = static_cast<double>(retval.n_terms) / static_cast<double>(ntables);
+        if (retval.n_terms != 0u) {
+            retval.mean_probe_length = tot_probes / static_cast<double>(retval.n_terms);
+
+            double acc = 0;
+            for (const auto &ti : retval.tables) {
+                const auto diff = static_cast<double>(ti.size) - retval.mean_terms;
+                acc += diff * diff;
+            }
+            retval.imbalance = ::std::sqrt(acc / static_cast<double>(ntables)) / retval.mean_terms;
+        }
+        if (retval.total_capacity != 0u) {
+            retval.load_factor = static_cast<double>(retval.n_terms) / static_cast<double>(retval.total_capacity);
+        }
+
+        retval.slack_bytes = (retval.total_capacity - retval.n_terms) * sizeof(typename table_type::value_type);
+        retval.total_bytes = ::obake::byte_size(*this);
+
+        return retval;
+    }
+
+    // Return a bunch of statistics
+    // about the hash table(s) in string
+    // format.
+    ::std::string table_stats() const
+    {
+        return get_table_stats().to_string();
+    }
+
+private:
+    // Serialisation.
     template <class Archive>
     void save(Archive &ar, unsigned) const
     {
@@ -1585,26 +2613,75 @@ inline bool series_cmp_identical_ss(const T &lhs, const U &rhs)
         return false;
     }
 
-    // Cache the end iterator of rhs.
-    const auto rhs_end = rhs.end();
-    // NOTE: this can be parallelised and
-    // improved performance-wise by having specialised
-    // codepaths for single table layout, same
-    // n segments, etc. Keep it in mind for
-    // future optimisations.
-    for (const auto &t : lhs) {
-        // NOTE: old clang does not like structured
-        // bindings in the for loop.
-        const auto &k = t.first;
-        const auto &c = t.second;
-
-        const auto it = rhs.find(k);
-        if (it == rhs_end || c != it->second) {
-            return false;
+    const auto &l_tables = lhs._get_s_table();
+    const auto &r_tables = rhs._get_s_table();
+
+    if (l_tables.size() == 1u) {
+        // Cache the end iterator of rhs.
+        const auto rhs_end = rhs.end();
+
+        for (const auto &t : l_tables[0]) {
+            // NOTE: old clang does not like structured
+            // bindings in the for loop.
+            const auto &k = t.first;
+            const auto &c = t.second;
+
+            const auto it = rhs.find(k);
+            if (it == rhs_end || c != it->second) {
+                return false;
+            }
         }
+
+        return true;
     }
 
-    return true;
+    // Segmented lhs: compare in parallel table by table,
+    // stopping early as soon as a mismatch is detected.
+    // If the segmentations of lhs and rhs match,
+    // the terms in the i-th table of lhs can be looked
+    // up directly in the i-th table of rhs.
+    const auto same_seg = lhs.get_s_size() == rhs.get_s_size();
+    ::std::atomic<bool> mismatch(false);
+
+    ::tbb::parallel_for(::tbb::blocked_range<decltype(l_tables.size())>(0, l_tables.size()),
+                        [&l_tables, &r_tables, &rhs, &mismatch, same_seg](const auto &range) {
+                            for (auto i = range.begin(); i != range.end(); ++i) {
+                                if (mismatch.load(::std::memory_order_relaxed)) {
+                                    return;
+                                }
+
+                                const auto &lt = l_tables[i];
+
+                                if (same_seg) {
+                                    const auto &rt = r_tables[i];
+
+                                    if (lt.size() != rt.size()) {
+                                        mismatch.store(true, ::std::memory_order_relaxed);
+                                        return;
+                                    }
+
+                                    const auto rt_end = rt.end();
+                                    for (const auto &t : lt) {
+                                        const auto it = rt.find(t.first);
+                                        if (it == rt_end || t.second != it->second) {
+                                            mismatch.store(true, ::std::memory_order_relaxed);
+                                            return;
+                                        }
+                                    }
+                                } else {
+                                    const auto rhs_end = rhs.end();
+                                    for (const auto &t : lt) {
+                                        const auto it = rhs.find(t.first);
+                                        if (it == rhs_end || t.second != it->second) {
+                                            mismatch.store(true, ::std::memory_order_relaxed);
+                                            return;
+                                        }
+                                    }
+                                }
+                            }
+                        });
+
+    return !mismatch.load();
 }
 
 // Helper to determine if two series of the same type are identical.
@@ -1658,20 +2735,8 @@ inline Base series_pow_from_cache(const Base &base, unsigned n)
     struct hasher {
         ::std::size_t operator()(const ::boost::any &x) const
         {
-            // Combine the hashes of all terms
-            // via addition, so that their order
-            // does not matter.
-            ::std::size_t retval = 0;
-
-            for (const auto &t : ::boost::any_cast<const Base &>(x)) {
-                // NOTE: use the same hasher used in the implementation
-                // of series.
-                // NOTE: parallelisation opportunities here for
-                // segmented tables.
-                retval += detail::series_key_hasher{}(t.first);
-            }
-
-            return retval;
+            // NOTE: the content hash is order-independent.
+            return ::boost::any_cast<const Base &>(x).content_hash();
         }
     };
 
@@ -1714,9 +2779,18 @@ inline Base series_pow_from_cache(const Base &base, unsigned n)
     }
 
     // Fill in the missing powers as needed.
-    while (v.size() <= n) {
-        v.emplace_back(::boost::any_cast<const Base &>(v.back()) * b);
-    }
+    // NOTE: the series multiplications might be parallelised
+    // internally, and this function might be invoked from within
+    // parallel algorithms (e.g., during the segment-parallel evaluation
+    // of a series). Run the multiplications in an isolated region, so
+    // that the current thread, while waiting for the completion of
+    // the multiplications, won't pick up unrelated tasks which
+    // could in turn try to acquire the (non-recursive) lock.
+    ::tbb::this_task_arena::isolate([&v, &b, n]() {
+        while (v.size() <= n) {
+            v.emplace_back(::boost::any_cast<const Base &>(v.back()) * b);
+        }
+    });
 
     // Return a copy of the desired power.
     // NOTE: returnability is guaranteed because
@@ -1841,36 +2915,181 @@ inline remove_cvref_t<T> operator+(T &&x)
 namespace detail
 {
 
-// Default implementation of obake::negate() for series.
-template <typename T>
-inline void series_default_negate_impl(T &&x)
+// Helper to compute a reduction over the items with indices
+// in the [0, n) range. f(i) returns an optional containing the
+// partial result for the i-th item, or an empty optional if the i-th
+// item does not contribute to the reduction. If n > 1, the partial
+// results are computed in parallel. They are then combined via
+// op(acc, partial), where acc is an lvalue and partial an rvalue.
+// The return value is an optional which is empty if no item contributes.
+// NOTE: the partial results are always combined serially in
+// index order, regardless of how the work was distributed
+// among the threads. This ensures that the result of the
+// reduction does not depend on the number of threads (which is
+// important, e.g., for the reproducibility of floating-point
+// computations).
+template <typename F, typename Op>
+inline auto ordered_reduce(::std::size_t n, const F &f, const Op &op)
 {
-    static_assert(is_cvr_series_v<T>);
-    for (auto &p : x) {
-        // NOTE: the runtime requirements
-        // of negate() ensure that the coefficient
-        // will never become zero after negation.
-        // NOTE: perhaps this can be improved
-        // performance-wise by taking advantage
-        // of the single-table layout, if possible.
-        // NOTE: this could be parallelised,
-        // in case of multiple tables.
-        ::obake::negate(p.second);
+    using opt_t = remove_cvref_t<decltype(f(::std::size_t(0)))>;
+
+    if (n == 0u) {
+        return opt_t{};
     }
-}
 
-} // namespace detail
+    if (n == 1u) {
+        // A single item, no need to go parallel.
+        return opt_t(f(::std::size_t(0)));
+    }
 
-// Negated copy operator.
-#if defined(OBAKE_HAVE_CONCEPTS)
-template <CvrSeries T>
-#else
-template <typename T, ::std::enable_if_t<is_cvr_series_v<T>, int> = 0>
-#endif
-inline remove_cvref_t<T> operator-(T &&x)
+    // Compute the partial results in parallel.
+    ::std::vector<opt_t> partials;
+    partials.resize(::obake::safe_cast<decltype(partials.size())>(n));
+
+    ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, n), [&partials, &f](const auto &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            partials[static_cast<decltype(partials.size())>(i)] = f(i);
+        }
+    });
+
+    // Combine them serially.
+    opt_t retval;
+    for (auto &p : partials) {
+        if (p) {
+            if (retval) {
+                op(*retval, ::std::move(*p));
+            } else {
+                retval.emplace(::std::move(*p));
+            }
+        }
+    }
+
+    return retval;
+}
+
+// Helper to compute a reduction over the tables of the series s.
+// f is invoked on each non-empty table of s, and it returns
+// the partial result for that table. The partial results are then
+// combined via op(acc, partial), as explained in ordered_reduce().
+// If s is segmented, the partial results are computed in parallel.
+// The return value is an optional which is empty if s has no terms.
+template <typename S, typename F, typename Op>
+inline auto series_table_reduce(const S &s, const F &f, const Op &op)
 {
-    if constexpr (is_mutable_rvalue_reference_v<T &&>) {
-        // NOTE: if we have an rvalue reference in input, we
+    const auto &s_table = s._get_s_table();
+
+    using ret_t = remove_cvref_t<decltype(f(s_table[0]))>;
+
+    return detail::ordered_reduce(
+        static_cast<::std::size_t>(s_table.size()),
+        [&s_table, &f](::std::size_t i) {
+            ::std::optional<ret_t> retval;
+
+            const auto &table = s_table[static_cast<decltype(s_table.size())>(i)];
+            if (!table.empty()) {
+                retval.emplace(f(table));
+            }
+
+            return retval;
+        },
+        op);
+}
+
+// Default implementation of obake::negate() for series.
+template <typename T>
+inline void series_default_negate_impl(T &&x)
+{
+    static_assert(is_cvr_series_v<T>);
+
+    // Helper to negate the coefficients in a table.
+    auto negate_table = [](auto &t) {
+        for (auto &p : t) {
+            // NOTE: the runtime requirements
+            // of negate() ensure that the coefficient
+            // will never become zero after negation.
+            ::obake::negate(p.second);
+        }
+    };
+
+    auto &s_table = x._get_s_table();
+
+    if (s_table.size() == 1u) {
+        negate_table(s_table[0]);
+    } else {
+        // Negate the tables in parallel.
+        ::tbb::parallel_for(::tbb::blocked_range<decltype(s_table.size())>(0, s_table.size()),
+                            [&negate_table, &s_table](const auto &range) {
+                                for (auto i = range.begin(); i != range.end(); ++i) {
+                                    negate_table(s_table[i]);
+                                }
+                            });
+    }
+}
+
+// Helper to apply in-place the functor f to all the
+// coefficients of the series s. The terms whose coefficients
+// become zero are removed. If s is segmented, the tables are
+// processed in parallel.
+template <typename S, typename F>
+inline void series_cf_apply_in_place(S &s, const F &f)
+{
+    // Helper to process a single table.
+    auto apply_table = [&f](auto &t) {
+        const auto end = t.end();
+        for (auto it = t.begin(); it != end;) {
+            auto &c = it->second;
+
+            f(c);
+
+            if (obake_unlikely(::obake::is_zero(::std::as_const(c)))) {
+                // NOTE: abseil's flat_hash_map returns void on erase(),
+                // thus we need to increase 'it' before possibly erasing.
+                // erase() does not cause rehash and thus will not invalidate
+                // any other iterator apart from the one being erased.
+                t.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    };
+
+    auto &s_table = s._get_s_table();
+
+    try {
+        if (s_table.size() == 1u) {
+            apply_table(s_table[0]);
+        } else {
+            ::tbb::parallel_for(::tbb::blocked_range<decltype(s_table.size())>(0, s_table.size()),
+                                [&apply_table, &s_table](const auto &range) {
+                                    for (auto i = range.begin(); i != range.end(); ++i) {
+                                        apply_table(s_table[i]);
+                                    }
+                                });
+        }
+        // LCOV_EXCL_START
+    } catch (...) {
+        // If something goes wrong, make sure to clear
+        // out s before rethrowing, in order to avoid
+        // a possibly inconsistent state and thus assertion
+        // failures in debug mode.
+        s.clear();
+        throw;
+    }
+    // LCOV_EXCL_STOP
+}
+
+} // namespace detail
+
+// Negated copy operator.
+#if defined(OBAKE_HAVE_CONCEPTS)
+template <CvrSeries T>
+#else
+template <typename T, ::std::enable_if_t<is_cvr_series_v<T>, int> = 0>
+#endif
+inline remove_cvref_t<T> operator-(T &&x)
+{
+    if constexpr (is_mutable_rvalue_reference_v<T &&>) {
+        // NOTE: if we have an rvalue reference in input, we
         // can negate all coefficients in-place and then re-use
         // the same reference to move-construct the return value.
         detail::series_default_negate_impl(::std::forward<T>(x));
@@ -2470,16 +3689,12 @@ inline series_default_addsub_ret_t<Sign, T &&, U &&> series_default_addsub_impl(
         auto merge_with_identical_ss = [](auto &&a, auto &&b) {
             assert(a.get_symbol_set() == b.get_symbol_set());
 
-            // Helper to merge the terms from the smaller series (rhs) into the return value
-            // (which will be inited from the larger series, lhs).
+            // Helper to merge the terms from rhs into the return value
+            // (which will be inited from lhs, the accumulator).
             auto term_merger = [](auto &&lhs, auto &&rhs) {
-                assert(lhs.size() >= rhs.size());
-
                 using rhs_t = decltype(rhs);
 
                 // Build the retval.
-                // NOTE: perhaps in the future we can consider reserving
-                // additional space for the return value.
                 auto retval = [&lhs, &rhs]() {
                     detail::ignore(rhs);
                     // NOTE: if lhs and rhs are the same object, don't
@@ -2496,56 +3711,25 @@ inline series_default_addsub_ret_t<Sign, T &&, U &&> series_default_addsub_impl(
                     }
                 }();
 
+                // NOTE: if the accumulator is smaller than rhs
+                // (which can happen if we are re-using the storage
+                // of an rvalue), adopt the segmentation of rhs and
+                // reserve enough space to avoid repeated rehashing
+                // during the merge.
+                if (retval.get_s_size() < rhs.get_s_size()) {
+                    retval.resegment(rhs.get_s_size());
+                }
+                if (retval.size() < rhs.size()) {
+                    retval.reserve(retval.size() + rhs.size());
+                }
+
                 // We may end up moving coefficients from rhs.
                 // Make sure we will clear it out properly.
                 series_rref_clearer<rhs_t> rhs_c(::std::forward<rhs_t>(rhs));
 
-                // Distinguish the two cases in which the internal table
-                // is segmented or not.
-                if (retval._get_s_table().size() > 1u) {
-                    for (auto &t : rhs) {
-                        // NOTE: old clang does not like structured
-                        // bindings in the for loop.
-                        auto &k = t.first;
-                        auto &c = t.second;
-
-                        if constexpr (is_mutable_rvalue_reference_v<rhs_t &&>) {
-                            // NOTE: turn on the zero check, as we might end up
-                            // annihilating terms during insertion.
-                            // Compatibility check is not needed.
-                            detail::series_add_term<Sign, sat_check_zero::on, sat_check_compat_key::off,
-                                                    sat_check_table_size::on, sat_assume_unique::off>(retval, k,
-                                                                                                      ::std::move(c));
-                        } else {
-                            detail::series_add_term<Sign, sat_check_zero::on, sat_check_compat_key::off,
-                                                    sat_check_table_size::on, sat_assume_unique::off>(
-                                retval, k, ::std::as_const(c));
-                        }
-                    }
-                } else {
-                    assert(retval._get_s_table().size() == 1u);
-
-                    auto &t = retval._get_s_table()[0];
-
-                    for (auto &term : rhs) {
-                        // NOTE: old clang does not like structured
-                        // bindings in the for loop.
-                        auto &k = term.first;
-                        auto &c = term.second;
-
-                        if constexpr (is_mutable_rvalue_reference_v<rhs_t &&>) {
-                            // NOTE: disable the table size check, as we are
-                            // sure we have a single table.
-                            detail::series_add_term_table<Sign, sat_check_zero::on, sat_check_compat_key::off,
-                                                          sat_check_table_size::off, sat_assume_unique::off>(
-                                retval, t, k, ::std::move(c));
-                        } else {
-                            detail::series_add_term_table<Sign, sat_check_zero::on, sat_check_compat_key::off,
-                                                          sat_check_table_size::off, sat_assume_unique::off>(
-                                retval, t, k, ::std::as_const(c));
-                        }
-                    }
-                }
+                detail::series_merge_terms<Sign>(retval, ::std::forward<rhs_t>(rhs));
+
+                detail::series_maybe_auto_segment(retval);
 
                 return retval;
             };
@@ -2553,7 +3737,28 @@ inline series_default_addsub_ret_t<Sign, T &&, U &&> series_default_addsub_impl(
             using a_t = decltype(a);
             using b_t = decltype(b);
 
-            if (a.size() >= b.size()) {
+            // Establish which operand will be used as accumulator
+            // for the result. Normally the larger one is chosen, so that
+            // the fewest terms are inserted. A mutable rvalue of type ret_t
+            // can however be moved into the return value without copying
+            // or rehashing, thus it is preferred if it is at least half
+            // the size of the other operand.
+            constexpr bool a_reusable
+                = ::std::conjunction_v<is_mutable_rvalue_reference<a_t>, ::std::is_same<remove_cvref_t<a_t>, ret_t>>;
+            constexpr bool b_reusable
+                = ::std::conjunction_v<is_mutable_rvalue_reference<b_t>, ::std::is_same<remove_cvref_t<b_t>, ret_t>>;
+
+            const auto use_a = [&a, &b]() {
+                if constexpr (a_reusable == b_reusable) {
+                    return a.size() >= b.size();
+                } else if constexpr (a_reusable) {
+                    return a.size() >= b.size() / 2u;
+                } else {
+                    return b.size() < a.size() / 2u;
+                }
+            }();
+
+            if (use_a) {
                 return term_merger(::std::forward<a_t>(a), ::std::forward<b_t>(b));
             } else {
                 if constexpr (Sign) {
@@ -2833,52 +4038,9 @@ inline series_default_in_place_addsub_ret_t<Sign, T &&, U &&> series_default_in_
             using rhs_t = decltype(rhs);
             series_rref_clearer<rhs_t> rhs_c(::std::forward<rhs_t>(rhs));
 
-            // Distinguish the two cases in which the lhs table
-            // is segmented or not.
-            if (lhs._get_s_table().size() > 1u) {
-                for (auto &t : rhs) {
-                    // NOTE: old clang does not like structured
-                    // bindings in the for loop.
-                    auto &k = t.first;
-                    auto &c = t.second;
-
-                    if constexpr (is_mutable_rvalue_reference_v<rhs_t &&>) {
-                        // NOTE: turn on the zero check, as we might end up
-                        // annihilating terms during insertion.
-                        // Compatibility check is not needed.
-                        detail::series_add_term<Sign, sat_check_zero::on, sat_check_compat_key::off,
-                                                sat_check_table_size::on, sat_assume_unique::off>(lhs, k,
-                                                                                                  ::std::move(c));
-                    } else {
-                        detail::series_add_term<Sign, sat_check_zero::on, sat_check_compat_key::off,
-                                                sat_check_table_size::on, sat_assume_unique::off>(lhs, k,
-                                                                                                  ::std::as_const(c));
-                    }
-                }
-            } else {
-                assert(lhs._get_s_table().size() == 1u);
-
-                auto &t = lhs._get_s_table()[0];
+            detail::series_merge_terms<Sign>(lhs, ::std::forward<rhs_t>(rhs));
 
-                for (auto &term : rhs) {
-                    // NOTE: old clang does not like structured
-                    // bindings in the for loop.
-                    auto &k = term.first;
-                    auto &c = term.second;
-
-                    if constexpr (is_mutable_rvalue_reference_v<rhs_t &&>) {
-                        // NOTE: disable the table size check, as we are
-                        // sure we have a single table.
-                        detail::series_add_term_table<Sign, sat_check_zero::on, sat_check_compat_key::off,
-                                                      sat_check_table_size::off, sat_assume_unique::off>(
-                            lhs, t, k, ::std::move(c));
-                    } else {
-                        detail::series_add_term_table<Sign, sat_check_zero::on, sat_check_compat_key::off,
-                                                      sat_check_table_size::off, sat_assume_unique::off>(
-                            lhs, t, k, ::std::as_const(c));
-                    }
-                }
-            }
+            detail::series_maybe_auto_segment(lhs);
         };
 
         if (x.get_symbol_set() == y.get_symbol_set()) {
@@ -3211,6 +4373,17 @@ template <typename T, typename U>
 constexpr auto series_mul_impl(T &&x, U &&y, priority_tag<1>)
     OBAKE_SS_FORWARD_FUNCTION(series_mul(::std::forward<T>(x), ::std::forward<U>(y)));
 
+// Detect if series_mul() has been customised for T and U,
+// either via the external customisation point or via ADL.
+template <typename T, typename U>
+using series_mul_ext_t = decltype((customisation::series_mul<T &&, U &&>)(::std::declval<T>(), ::std::declval<U>()));
+
+template <typename T, typename U>
+using series_mul_adl_t = decltype(series_mul(::std::declval<T>(), ::std::declval<U>()));
+
+template <typename T, typename U>
+using is_series_mul_customised = ::std::disjunction<is_detected<series_mul_ext_t, T, U>, is_detected<series_mul_adl_t, T, U>>;
+
 // Meta-programming to establish the algorithm and return type
 // of the default implementation of series mul. It will return
 // a pair containing an integral value (1 or 2) signalling the algorithm
@@ -3322,51 +4495,11 @@ inline series_default_mul_ret_t<T &&, U &&> series_default_mul_impl(T &&x, U &&y
         // Init the return value from the higher-rank series.
         ret_t retval(::std::forward<decltype(a)>(a));
 
-        // Multiply in-place all coefficients of retval by b.
-        // Store in a vector the keys of the terms
-        // whose coefficients become zero after
-        // the multiplication, so that we can remove them.
-        // NOTE: this can be parallelised for a segmented table.
-        auto &s_table = retval._get_s_table();
-        ::std::vector<series_key_t<ret_t>> v_keys;
-        try {
-            for (auto &t : s_table) {
-                // Reset the vector of keys to be removed.
-                v_keys.clear();
-
-                // Perform the multiplications for this table.
-                for (auto &term : t) {
-                    // NOTE: old clang does not like structured
-                    // bindings in the for loop.
-                    auto &k = term.first;
-                    auto &c = term.second;
-
-                    c *= ::std::as_const(b);
-                    // Check if the coefficient became zero
-                    // after the multiplication.
-                    if (obake_unlikely(::obake::is_zero(::std::as_const(c)))) {
-                        v_keys.push_back(k);
-                    }
-                }
-
-                // Erase any term whose coefficient became zero.
-                for (const auto &k : v_keys) {
-                    assert(t.find(k) != t.end());
-                    t.erase(k);
-                }
-            }
+        // Multiply in-place all coefficients of retval by b,
+        // removing the terms whose coefficients become zero.
+        detail::series_cf_apply_in_place(retval, [&b](auto &c) { c *= ::std::as_const(b); });
 
-            return retval;
-            // LCOV_EXCL_START
-        } catch (...) {
-            // If something goes wrong, make sure to clear
-            // out retval before rethrowing, in order to avoid
-            // a possibly inconsistent state and thus assertion
-            // failures in debug mode.
-            retval.clear();
-            throw;
-        }
-        // LCOV_EXCL_STOP
+        return retval;
     };
 
     if constexpr (algo == 2) {
@@ -3412,15 +4545,70 @@ template <typename T, typename U, ::std::enable_if_t<::std::disjunction_v<is_cvr
 constexpr auto operator*(T &&x, U &&y)
     OBAKE_SS_FORWARD_FUNCTION(::obake::series_mul(::std::forward<T>(x), ::std::forward<U>(y)));
 
-// NOTE: for now, implement operator*=() in terms of operator*().
-// This can be optimised later performance-wise.
+namespace detail
+{
+
+// Establish if the in-place multiplication of the series T
+// by the lower-rank U can be performed by multiplying
+// in-place the coefficients of T. This requires that:
+// - T is not const,
+// - the series multiplication is not customised and the
+//   default implementation returns T,
+// - U can be zero-tested,
+// - a copy of U can be constructed from U.
+template <typename T, typename U>
+constexpr bool series_in_place_scalar_mul_enabled()
+{
+    if constexpr (::std::conjunction_v<::std::negation<::std::is_const<::std::remove_reference_t<T>>>,
+                                       ::std::negation<is_series_mul_customised<T, U>>>) {
+        if constexpr (series_default_mul_algo<T, U> == 2) {
+            return ::std::conjunction_v<::std::is_same<series_default_mul_ret_t<T, U>, remove_cvref_t<T>>,
+                                        is_zero_testable<::std::add_lvalue_reference_t<const remove_cvref_t<U>>>,
+                                        ::std::is_constructible<remove_cvref_t<U>, U>>;
+        } else {
+            return false;
+        }
+    } else {
+        return false;
+    }
+}
+
+// In-place multiplication of a series by a lower-rank object,
+// performed without copying the series.
+template <typename T, typename U, ::std::enable_if_t<series_in_place_scalar_mul_enabled<T &&, U &&>(), int> = 0>
+inline remove_cvref_t<T> &series_in_place_mul_impl(T &&x, U &&y, priority_tag<1>)
+{
+    if (::obake::is_zero(::std::as_const(y))) {
+        // NOTE: this matches the behaviour of
+        // the binary operator.
+        x = remove_cvref_t<T>{};
+    } else {
+        // NOTE: y might be a reference to one of the coefficients
+        // of x (e.g., x *= x.cbegin()->second), thus we need to make
+        // a copy of it before modifying the coefficients of x.
+        const remove_cvref_t<U> y_copy(::std::forward<U>(y));
+
+        detail::series_cf_apply_in_place(x, [&y_copy](auto &c) { c *= y_copy; });
+    }
+
+    return x;
+}
+
+// Fallback: implement operator*=() in terms of operator*().
+template <typename T, typename U>
+constexpr auto series_in_place_mul_impl(T &&x, U &&y, priority_tag<0>)
+    OBAKE_SS_FORWARD_FUNCTION(x = ::std::forward<T>(x) * ::std::forward<U>(y));
+
+} // namespace detail
+
 #if defined(OBAKE_HAVE_CONCEPTS)
 template <typename T, typename U>
 requires CvrSeries<T>
 #else
 template <typename T, typename U, ::std::enable_if_t<is_cvr_series_v<T>, int> = 0>
 #endif
-    constexpr auto operator*=(T &&x, U &&y) OBAKE_SS_FORWARD_FUNCTION(x = ::std::forward<T>(x) * ::std::forward<U>(y));
+    constexpr auto operator*=(T &&x, U &&y) OBAKE_SS_FORWARD_FUNCTION(
+        detail::series_in_place_mul_impl(::std::forward<T>(x), ::std::forward<U>(y), detail::priority_tag<1>{}));
 
 #if defined(OBAKE_HAVE_CONCEPTS)
 template <typename T, typename U>
@@ -3460,6 +4648,17 @@ template <typename T, typename U>
 constexpr auto series_div_impl(T &&x, U &&y, priority_tag<1>)
     OBAKE_SS_FORWARD_FUNCTION(series_div(::std::forward<T>(x), ::std::forward<U>(y)));
 
+// Detect if series_div() has been customised for T and U,
+// either via the external customisation point or via ADL.
+template <typename T, typename U>
+using series_div_ext_t = decltype((customisation::series_div<T &&, U &&>)(::std::declval<T>(), ::std::declval<U>()));
+
+template <typename T, typename U>
+using series_div_adl_t = decltype(series_div(::std::declval<T>(), ::std::declval<U>()));
+
+template <typename T, typename U>
+using is_series_div_customised = ::std::disjunction<is_detected<series_div_ext_t, T, U>, is_detected<series_div_adl_t, T, U>>;
+
 // Meta-programming to establish the algorithm and return type
 // of the default implementation of series div. It will return
 // a pair containing an integral value signalling the algorithm
@@ -3532,39 +4731,11 @@ inline series_default_div_ret_t<T &&, U &&> series_default_div_impl(T &&x, U &&y
     // Init the return value from the higher-rank series.
     ret_t retval(::std::forward<T>(x));
 
-    // Divide in-place all coefficients of retval by y.
-    // NOTE: this can be parallelised for a segmented table.
-    auto &s_table = retval._get_s_table();
-    try {
-        for (auto &t : s_table) {
-            // Perform the divisions for this table.
-            const auto end = t.end();
-            for (auto it = t.begin(); it != end;) {
-                auto &c = it->second;
-
-                c /= ::std::as_const(y);
-
-                if (obake_unlikely(::obake::is_zero(::std::as_const(c)))) {
-                    // NOTE: abseil's flat_hash_map returns void on erase(),
-                    // thus we need to increase 'it' before possibly erasing.
-                    // erase() does not cause rehash and thus will not invalidate
-                    // any other iterator apart from the one being erased.
-                    t.erase(it++);
-                } else {
-                    ++it;
-                }
-            }
-        }
+    // Divide in-place all coefficients of retval by y,
+    // removing the terms whose coefficients become zero.
+    detail::series_cf_apply_in_place(retval, [&y](auto &c) { c /= ::std::as_const(y); });
 
-        return retval;
-    } catch (...) {
-        // If something goes wrong, make sure to clear
-        // out retval before rethrowing, in order to avoid
-        // a possibly inconsistent state and thus assertion
-        // failures in debug mode.
-        retval.clear();
-        throw;
-    }
+    return retval;
 }
 
 // Lowest priority: the default implementation for series.
@@ -3603,15 +4774,60 @@ template <typename T, typename U, ::std::enable_if_t<::std::disjunction_v<is_cvr
 constexpr auto operator/(T &&x, U &&y)
     OBAKE_SS_FORWARD_FUNCTION(::obake::series_div(::std::forward<T>(x), ::std::forward<U>(y)));
 
-// NOTE: for now, implement operator/=() in terms of operator/().
-// This can be optimised later performance-wise.
+namespace detail
+{
+
+// Establish if the in-place division of the series T
+// by U can be performed by dividing in-place the coefficients
+// of T. This requires that T is not const, that the series
+// division is not customised and its default implementation
+// returns T, and that a copy of U can be constructed from U.
+template <typename T, typename U>
+constexpr bool series_in_place_scalar_div_enabled()
+{
+    if constexpr (::std::conjunction_v<::std::negation<::std::is_const<::std::remove_reference_t<T>>>,
+                                       ::std::negation<is_series_div_customised<T, U>>>) {
+        if constexpr (series_default_div_algo<T, U> == 1) {
+            return ::std::conjunction_v<::std::is_same<series_default_div_ret_t<T, U>, remove_cvref_t<T>>,
+                                        ::std::is_constructible<remove_cvref_t<U>, U>>;
+        } else {
+            return false;
+        }
+    } else {
+        return false;
+    }
+}
+
+// In-place division of a series by a lower-rank object,
+// performed without copying the series.
+template <typename T, typename U, ::std::enable_if_t<series_in_place_scalar_div_enabled<T &&, U &&>(), int> = 0>
+inline remove_cvref_t<T> &series_in_place_div_impl(T &&x, U &&y, priority_tag<1>)
+{
+    // NOTE: y might be a reference to one of the coefficients
+    // of x (e.g., x /= x.cbegin()->second), thus we need to make
+    // a copy of it before modifying the coefficients of x.
+    const remove_cvref_t<U> y_copy(::std::forward<U>(y));
+
+    detail::series_cf_apply_in_place(x, [&y_copy](auto &c) { c /= y_copy; });
+
+    return x;
+}
+
+// Fallback: implement operator/=() in terms of operator/().
+template <typename T, typename U>
+constexpr auto series_in_place_div_impl(T &&x, U &&y, priority_tag<0>)
+    OBAKE_SS_FORWARD_FUNCTION(x = ::std::forward<T>(x) / ::std::forward<U>(y));
+
+} // namespace detail
+
 #if defined(OBAKE_HAVE_CONCEPTS)
 template <typename T, typename U>
 requires CvrSeries<T>
 #else
 template <typename T, typename U, ::std::enable_if_t<is_cvr_series_v<T>, int> = 0>
 #endif
-    constexpr auto operator/=(T &&x, U &&y) OBAKE_SS_FORWARD_FUNCTION(x = ::std::forward<T>(x) / ::std::forward<U>(y));
+    constexpr auto operator/=(T &&x, U &&y) OBAKE_SS_FORWARD_FUNCTION(
+        detail::series_in_place_div_impl(::std::forward<T>(x), ::std::forward<U>(y), detail::priority_tag<1>{}));
 
 #if defined(OBAKE_HAVE_CONCEPTS)
 template <typename T, typename U>
@@ -4012,20 +5228,33 @@ struct series_default_degree_impl {
         // The functor to extract the term's degree.
         d_extractor<T &&> d_extract{&x.get_symbol_set()};
 
-        // Find the maximum degree.
-        // NOTE: parallelisation opportunities here for
-        // segmented tables.
-        auto it = x.cbegin();
-        const auto end = x.cend();
-        ret_t<T &&> max_deg(d_extract(*it));
-        for (++it; it != end; ++it) {
-            ret_t<T &&> cur(d_extract(*it));
-            if (::std::as_const(max_deg) < ::std::as_const(cur)) {
-                max_deg = ::std::move(cur);
-            }
-        }
+        // Find the maximum degree in each table (in parallel,
+        // if x is segmented), and then the overall maximum.
+        auto max_deg = detail::series_table_reduce(
+            x,
+            [&d_extract](const auto &tab) {
+                auto it = tab.begin();
+                const auto end = tab.end();
+                ret_t<T &&> retval(d_extract(*it));
+                for (++it; it != end; ++it) {
+                    ret_t<T &&> cur(d_extract(*it));
+                    if (::std::as_const(retval) < ::std::as_const(cur)) {
+                        retval = ::std::move(cur);
+                    }
+                }
+
+                return retval;
+            },
+            [](auto &acc, auto &&cur) {
+                if (::std::as_const(acc) < ::std::as_const(cur)) {
+                    acc = ::std::move(cur);
+                }
+            });
+        // NOTE: x is not empty, thus max_deg
+        // must contain a value.
+        assert(max_deg);
 
-        return max_deg;
+        return ::std::move(*max_deg);
     }
 };
 
@@ -4170,20 +5399,33 @@ struct series_default_p_degree_impl {
         // The functor to extract the term's partial degree.
         d_extractor<T &&> d_extract{&s, &si, &ss};
 
-        // Find the maximum degree.
-        // NOTE: parallelisation opportunities here for
-        // segmented tables.
-        auto it = x.cbegin();
-        const auto end = x.cend();
-        ret_t<T &&> max_deg(d_extract(*it));
-        for (++it; it != end; ++it) {
-            ret_t<T &&> cur(d_extract(*it));
-            if (::std::as_const(max_deg) < ::std::as_const(cur)) {
-                max_deg = ::std::move(cur);
-            }
-        }
+        // Find the maximum degree in each table (in parallel,
+        // if x is segmented), and then the overall maximum.
+        auto max_deg = detail::series_table_reduce(
+            x,
+            [&d_extract](const auto &tab) {
+                auto it = tab.begin();
+                const auto end = tab.end();
+                ret_t<T &&> retval(d_extract(*it));
+                for (++it; it != end; ++it) {
+                    ret_t<T &&> cur(d_extract(*it));
+                    if (::std::as_const(retval) < ::std::as_const(cur)) {
+                        retval = ::std::move(cur);
+                    }
+                }
+
+                return retval;
+            },
+            [](auto &acc, auto &&cur) {
+                if (::std::as_const(acc) < ::std::as_const(cur)) {
+                    acc = ::std::move(cur);
+                }
+            });
+        // NOTE: x is not empty, thus max_deg
+        // must contain a value.
+        assert(max_deg);
 
-        return max_deg;
+        return ::std::move(*max_deg);
     }
 };
 
@@ -4335,20 +5577,27 @@ struct series_default_evaluate_impl {
         // Thus, si must contain the [0, ss.size()) sequence.
         assert(si.empty() || (si.cend() - 1)->first == (ss.size() - 1u));
 
-        // NOTE: parallelisation opportunities here.
-        ret_t<T &&, U> retval(0);
-        for (const auto &tab : s._get_s_table()) {
-            for (const auto &t : tab) {
-                const auto &k = t.first;
-                const auto &c = t.second;
+        // Evaluate the tables (in parallel, if s is segmented),
+        // and accumulate the partial results.
+        auto retval = detail::series_table_reduce(
+            s,
+            [&si, &ss, &sm](const auto &tab) {
+                ret_t<T &&, U> acc(0);
 
-                // NOTE: there's an opportunity for fma3 here,
-                // but I am not sure it's worth the hassle.
-                retval += ::obake::key_evaluate(k, si, ss) * ::obake::evaluate(c, sm);
-            }
-        }
+                for (const auto &t : tab) {
+                    const auto &k = t.first;
+                    const auto &c = t.second;
 
-        return retval;
+                    // NOTE: there's an opportunity for fma3 here,
+                    // but I am not sure it's worth the hassle.
+                    acc += ::obake::key_evaluate(k, si, ss) * ::obake::evaluate(c, sm);
+                }
+
+                return acc;
+            },
+            [](auto &acc, auto &&p) { acc += ::std::move(p); });
+
+        return retval ? ::std::move(*retval) : ret_t<T &&, U>(0);
     }
 };
 
@@ -4422,19 +5671,115 @@ struct series_default_trim_impl {
         // Cache x's original symbol set.
         const auto &ss = x.get_symbol_set();
 
-        // Run trim_identify() on all the keys.
-        ::std::vector<int> trim_v(::obake::safe_cast<::std::vector<int>::size_type>(ss.size()), 1);
-        for (const auto &t : x) {
-            ::obake::key_trim_identify(trim_v, t.first, ss);
+        using table_type = typename ret_t<T &&>::table_type;
+        using key_t = series_key_t<ret_t<T &&>>;
+        using cf_t = series_cf_t<ret_t<T &&>>;
+
+        const auto &in_tables = x._get_s_table();
+        const auto n_syms = ss.size();
+
+        // Run trim_identify() on all the keys. The tables are
+        // processed in parallel, and the identification stops
+        // as soon as all the symbols are known to be in use.
+        ::std::vector<int> trim_v(::obake::safe_cast<::std::vector<int>::size_type>(n_syms), 1);
+        ::std::atomic<bool> all_used(n_syms == 0u);
+
+        // Helper to check if all the symbols are in use according to v.
+        auto check_all_used = [](const ::std::vector<int> &v) {
+            return ::std::all_of(v.begin(), v.end(), [](int n) { return n == 0; });
+        };
+
+        // Helper to run trim_identify() on the keys of a table.
+        auto identify = [&all_used, &check_all_used, &ss](const table_type &table, ::std::vector<int> &v) {
+            // NOTE: check for early termination periodically,
+            // as the check has a cost proportional to the number
+            // of symbols.
+            constexpr ::std::size_t check_period = 256;
+
+            ::std::size_t counter = 0;
+            for (const auto &t : table) {
+                ::obake::key_trim_identify(v, t.first, ss);
+
+                if (++counter == check_period) {
+                    counter = 0;
+
+                    if (all_used.load(::std::memory_order_relaxed)) {
+                        return;
+                    }
+
+                    if (check_all_used(v)) {
+                        all_used.store(true, ::std::memory_order_relaxed);
+                        return;
+                    }
+                }
+            }
+
+            if (check_all_used(v)) {
+                all_used.store(true, ::std::memory_order_relaxed);
+            }
+        };
+
+        if (in_tables.size() == 1u) {
+            identify(in_tables[0], trim_v);
+        } else if (n_syms != 0u) {
+            ::std::vector<::std::vector<int>> trim_vs(in_tables.size(), trim_v);
+
+            ::tbb::parallel_for(::tbb::blocked_range<decltype(in_tables.size())>(0, in_tables.size()),
+                                [&identify, &in_tables, &trim_vs, &all_used](const auto &range) {
+                                    for (auto i = range.begin(); i != range.end(); ++i) {
+                                        if (all_used.load(::std::memory_order_relaxed)) {
+                                            return;
+                                        }
+
+                                        identify(in_tables[i], trim_vs[i]);
+                                    }
+                                });
+
+            if (!all_used.load()) {
+                // Combine the partial results.
+                for (const auto &v : trim_vs) {
+                    for (decltype(v.size()) i = 0; i < v.size(); ++i) {
+                        trim_v[i] = trim_v[i] && v[i];
+                    }
+                }
+            }
+        }
+
+        if (all_used.load()) {
+            // All the symbols are in use: nothing will be trimmed
+            // from the keys. Copy/move x into the return value, and trim
+            // the coefficients in place. As the keys do not change, there
+            // is no need to rebuild the tables.
+            ret_t<T &&> retval(::std::forward<T>(x_));
+
+            auto trim_table = [](table_type &table) {
+                for (auto &t : table) {
+                    t.second = ::obake::trim(::std::as_const(t.second));
+                }
+            };
+
+            auto &out_tables = retval._get_s_table();
+            if (out_tables.size() == 1u) {
+                trim_table(out_tables[0]);
+            } else {
+                ::tbb::parallel_for(::tbb::blocked_range<decltype(out_tables.size())>(0, out_tables.size()),
+                                    [&trim_table, &out_tables](const auto &range) {
+                                        for (auto i = range.begin(); i != range.end(); ++i) {
+                                            trim_table(out_tables[i]);
+                                        }
+                                    });
+            }
+
+            return retval;
         }
 
         // Create the set of symbol indices for trimming,
         // and the trimmed symbol set.
         symbol_idx_set::sequence_type si_seq;
-        si_seq.reserve(static_cast<decltype(si_seq.size())>(ss.size()));
+        si_seq.reserve(static_cast<decltype(si_seq.size())>(n_syms));
         symbol_set::sequence_type new_ss_seq;
-        new_ss_seq.reserve(static_cast<decltype(new_ss_seq.size())>(ss.size()));
-        for (symbol_idx i = 0; i < ss.size(); ++i) {
+        new_ss_seq.reserve(static_cast<decltype(new_ss_seq.size())>(n_syms));
+        for (symbol_idx i = 0; i < n_syms; ++i) {
             if (trim_v[i] != 0) {
                 si_seq.push_back(i);
             } else {
@@ -4449,30 +5794,77 @@ struct series_default_trim_impl {
         // Prepare the return value.
         ret_t<T &&> retval;
         retval.set_symbol_set(new_ss);
-        // NOTE: use the same number of segments as x
-        // and reserve space for the same number of terms.
-        retval.set_n_segments(retval.get_s_size());
-        retval.reserve(x.size());
-
-        for (const auto &t : x) {
-            // NOTE: run all checks on insertion:
-            // - we don't know if something becomes zero after
-            //   trimming,
-            // - we don't know if a key loses compatibility after
-            //   trimming (this is difficult to impose as a runtime
-            //   requirement on key_trim()),
-            // - we don't know if keys are not unique any more after
-            //   trimming (same problem as above),
-            // - we don't know if we are going to go over the table
-            //   size limit (as terms will be shuffled around after
-            //   trimming).
-            // We can always think about removing some checks at
-            // a later stage.
-            // NOTE: in the series_sym_extender() helper, we distinguish
-            // the segmented vs non-segmented case. Perhaps we can do it
-            // here as well in the future, if it makes sense for performance.
-            retval.add_term(::obake::key_trim(t.first, si, ss), ::obake::trim(t.second));
+        // NOTE: use the same number of segments as x.
+        retval.set_n_segments(x.get_s_size());
+
+        // NOTE: run all checks on insertion:
+        // - we don't know if something becomes zero after
+        //   trimming,
+        // - we don't know if a key loses compatibility after
+        //   trimming (this is difficult to impose as a runtime
+        //   requirement on key_trim()),
+        // - we don't know if keys are not unique any more after
+        //   trimming (same problem as above),
+        // - we don't know if we are going to go over the table
+        //   size limit (as terms will be shuffled around after
+        //   trimming).
+        // We can always think about removing some checks at
+        // a later stage.
+        if (in_tables.size() == 1u) {
+            // Reserve space for the same number of terms.
+            retval.reserve(x.size());
+
+            for (const auto &t : x) {
+                retval.add_term(::obake::key_trim(t.first, si, ss), ::obake::trim(t.second));
+            }
+
+            return retval;
+        }
+
+        // Segmented case: the trimmed keys are shuffled around,
+        // thus we proceed in two parallel phases. In the first phase,
+        // the terms of each table of x are trimmed, and their destination
+        // tables in retval are computed. The trimmed terms are then sorted
+        // according to their destinations and, in the second phase,
+        // each table of retval is filled with the terms destined to it.
+        const auto n_tables = in_tables.size();
+        const auto mask = n_tables - 1u;
+
+        ::std::vector<::std::size_t> t_offsets(n_tables + 1u, 0);
+        for (decltype(in_tables.size()) i = 0; i < n_tables; ++i) {
+            t_offsets[i + 1u] = t_offsets[i] + in_tables[i].size();
         }
+        const auto tot = t_offsets.back();
+
+        ::std::vector<::std::pair<key_t, cf_t>> terms(tot);
+        ::std::vector<::std::size_t> dest(tot);
+        ::tbb::parallel_for(::tbb::blocked_range<decltype(in_tables.size())>(0, n_tables), [&](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                auto idx = t_offsets[i];
+                for (const auto &t : in_tables[i]) {
+                    auto k = ::obake::key_trim(t.first, si, ss);
+                    dest[idx] = static_cast<::std::size_t>(::obake::hash(::std::as_const(k)) & mask);
+                    terms[idx] = ::std::pair<key_t, cf_t>(::std::move(k), ::obake::trim(t.second));
+                    ++idx;
+                }
+            }
+        });
+
+        const detail::series_scatter_plan plan(dest, n_tables);
+
+        auto &out_tables = retval._get_s_table();
+        ::tbb::parallel_for(::tbb::blocked_range<decltype(out_tables.size())>(0, n_tables), [&](const auto &range) {
+            for (auto j = range.begin(); j != range.end(); ++j) {
+                auto &table = out_tables[j];
+
+                table.reserve(plan.count(j));
+                plan.for_each(j, [&](::std::size_t idx) {
+                    detail::series_add_term_table<true, detail::sat_check_zero::on, detail::sat_check_compat_key::on,
+                                                  detail::sat_check_table_size::on, detail::sat_assume_unique::off>(
+                        retval, table, ::std::move(terms[idx].first), ::std::move(terms[idx].second));
+                });
+            }
+        });
 
         return retval;
     }
@@ -4511,14 +5903,12 @@ inline series<K, C, Tag> filtered_impl(const series<K, C, Tag> &s, const F &f)
     retval.set_symbol_set(s.get_symbol_set());
     retval.set_n_segments(s.get_s_size());
 
-    // Do the filtering table by table.
-    // NOTE: this can easily be parallelised.
-    const auto n_tables = s._get_s_table().size();
-    for (decltype(s._get_s_table().size()) table_idx = 0; table_idx < n_tables; ++table_idx) {
-        // Fetch references to the input/output tables.
-        const auto &in_table = s._get_s_table()[table_idx];
-        auto &out_table = retval._get_s_table()[table_idx];
+    // Fetch references to the input/output tables.
+    const auto &in_tables = s._get_s_table();
+    auto &out_tables = retval._get_s_table();
 
+    // Helper to filter a single table.
+    auto filter_table = [&f](const auto &in_table, auto &out_table) {
         for (const auto &t : in_table) {
             if (f(t)) {
                 [[maybe_unused]] const auto res = out_table.insert(t);
@@ -4527,6 +5917,18 @@ inline series<K, C, Tag> filtered_impl(const series<K, C, Tag> &s, const F &f)
                 assert(res.second);
             }
         }
+    };
+
+    if (in_tables.size() == 1u) {
+        filter_table(in_tables[0], out_tables[0]);
+    } else {
+        // Do the filtering table by table, in parallel.
+        ::tbb::parallel_for(::tbb::blocked_range<decltype(in_tables.size())>(0, in_tables.size()),
+                            [&filter_table, &in_tables, &out_tables](const auto &range) {
+                                for (auto i = range.begin(); i != range.end(); ++i) {
+                                    filter_table(in_tables[i], out_tables[i]);
+                                }
+                            });
     }
 
     return retval;
@@ -4534,6 +5936,12 @@ inline series<K, C, Tag> filtered_impl(const series<K, C, Tag> &s, const F &f)
 
 } // namespace detail
 
+// Return a copy of the series s containing only the terms
+// for which the predicate f returns true.
+// NOTE: if s is segmented, f is invoked concurrently from
+// multiple threads (on distinct terms), thus f must be safe
+// to call concurrently via a const reference. Predicates
+// with side effects must provide their own synchronisation.
 #if defined(OBAKE_MSVC_LAMBDA_WORKAROUND)
 
 struct filtered_msvc {
@@ -4561,9 +5969,10 @@ template <typename K, typename C, typename Tag, typename F,
           ::std::enable_if_t<::std::is_convertible_v<detected_t<term_filter_return_t, F, K, C, Tag>, bool>, int> = 0>
 inline void filter_impl(series<K, C, Tag> &s, const F &f)
 {
-    // Do the filtering table by table.
-    // NOTE: this can easily be parallelised.
-    for (auto &table : s._get_s_table()) {
+    using table_type = typename series<K, C, Tag>::table_type;
+
+    // Helper to filter a single table.
+    auto filter_table = [&f](table_type &table) {
         const auto it_f = table.end();
 
         for (auto it = table.begin(); it != it_f;) {
@@ -4577,11 +5986,39 @@ inline void filter_impl(series<K, C, Tag> &s, const F &f)
                 table.erase(it++);
             }
         }
+
+        // NOTE: erase() never shrinks the table. If the filtering
+        // emptied the table, release its memory.
+        if (table.empty() && table.capacity() != 0u) {
+            table = table_type{};
+        }
+    };
+
+    auto &s_table = s._get_s_table();
+
+    if (s_table.size() == 1u) {
+        filter_table(s_table[0]);
+    } else {
+        // Do the filtering table by table, in parallel.
+        ::tbb::parallel_for(::tbb::blocked_range<decltype(s_table.size())>(0, s_table.size()),
+                            [&filter_table, &s_table](const auto &range) {
+                                for (auto i = range.begin(); i != range.end(); ++i) {
+                                    filter_table(s_table[i]);
+                                }
+                            });
     }
+
+    // NOTE: the filtering may have removed
+    // a large number of terms.
+    detail::series_maybe_auto_segment(s);
 }
 
 } // namespace detail
 
+// Remove in-place from the series s the terms
+// for which the predicate f returns false.
+// NOTE: as in filtered(), if s is segmented f is invoked
+// concurrently from multiple threads.
 #if defined(OBAKE_MSVC_LAMBDA_WORKAROUND)
 
 struct filter_msvc {
@@ -4607,6 +6044,114 @@ inline constexpr auto filter =
 namespace detail
 {
 
+// Apply the functor f to all the terms of the series s.
+// The segments of s are processed in parallel, the terms
+// of each segment sequentially.
+template <typename K, typename C, typename Tag, typename F,
+          ::std::enable_if_t<is_detected_v<term_filter_return_t, F, K, C, Tag>, int> = 0>
+inline void parallel_for_each_term_impl(const series<K, C, Tag> &s, const F &f)
+{
+    const auto &s_table = s._get_s_table();
+
+    if (s_table.size() == 1u) {
+        for (const auto &t : s_table[0]) {
+            f(t);
+        }
+    } else {
+        ::tbb::parallel_for(s.segments(), [&f](const auto &range) {
+            for (const auto &table : range) {
+                for (const auto &t : table) {
+                    f(t);
+                }
+            }
+        });
+    }
+}
+
+// Check if the transformation F and the reduction Op
+// can be used in the transform-reduce of the terms of
+// a series with key K, coefficient C and tag Tag into
+// a value of type T.
+template <typename Op, typename T>
+using term_reduce_return_t = decltype(::std::declval<const Op &>()(::std::declval<T>(), ::std::declval<T>()));
+
+template <typename T, typename Op, typename F, typename K, typename C, typename Tag>
+using is_term_transform_reducible
+    = ::std::conjunction<::std::is_move_constructible<T>, ::std::is_move_assignable<T>,
+                         ::std::is_constructible<T, detected_t<term_filter_return_t, F, K, C, Tag>>,
+                         ::std::is_convertible<detected_t<term_reduce_return_t, Op, T>, T>>;
+
+// Transform-reduce of the terms of the series s: the terms
+// are transformed via f, and the results are reduced via op,
+// together with the initial value init. op must be associative.
+// The segments of s are reduced in parallel, and then the results
+// for each segment are reduced sequentially in segment order. Thus,
+// for a given segmentation, the result is deterministic (and,
+// in particular, it does not depend on the number of threads)
+// even if op is not commutative (e.g., floating-point addition).
+template <typename K, typename C, typename Tag, typename T, typename Op, typename F,
+          ::std::enable_if_t<is_term_transform_reducible<T, Op, F, K, C, Tag>::value, int> = 0>
+inline T parallel_transform_reduce_impl(const series<K, C, Tag> &s, T init, const Op &op, const F &f)
+{
+    // Reduce the terms of each table, and combine the
+    // partial results in table order.
+    auto res = detail::series_table_reduce(
+        s,
+        [&op, &f](const auto &table) {
+            // NOTE: series_table_reduce() invokes
+            // this only on non-empty tables.
+            assert(!table.empty());
+
+            auto it = table.begin();
+            T retval(f(*it));
+            for (++it; it != table.end(); ++it) {
+                retval = op(::std::move(retval), T(f(*it)));
+            }
+
+            return retval;
+        },
+        [&op](T &acc, T &&p) { acc = op(::std::move(acc), ::std::move(p)); });
+
+    return res ? T(op(::std::move(init), ::std::move(*res))) : init;
+}
+
+} // namespace detail
+
+#if defined(OBAKE_MSVC_LAMBDA_WORKAROUND)
+
+struct parallel_for_each_term_msvc {
+    template <typename T, typename F>
+    constexpr auto operator()(T &&s, const F &f) const
+        OBAKE_SS_FORWARD_MEMBER_FUNCTION(detail::parallel_for_each_term_impl(::std::forward<T>(s), f))
+};
+
+inline constexpr auto parallel_for_each_term = parallel_for_each_term_msvc{};
+
+struct parallel_transform_reduce_msvc {
+    template <typename T, typename U, typename Op, typename F>
+    constexpr auto operator()(T &&s, U &&init, const Op &op, const F &f) const
+        OBAKE_SS_FORWARD_MEMBER_FUNCTION(detail::parallel_transform_reduce_impl(::std::forward<T>(s),
+                                                                                ::std::forward<U>(init), op, f))
+};
+
+inline constexpr auto parallel_transform_reduce = parallel_transform_reduce_msvc{};
+
+#else
+
+// NOTE: force const reference passing for the functors
+// as a hint that they will be invoked concurrently.
+inline constexpr auto parallel_for_each_term = [](auto &&s, const auto &f)
+    OBAKE_SS_FORWARD_LAMBDA(detail::parallel_for_each_term_impl(::std::forward<decltype(s)>(s), f));
+
+inline constexpr auto parallel_transform_reduce = [](auto &&s, auto &&init, const auto &op, const auto &f)
+    OBAKE_SS_FORWARD_LAMBDA(detail::parallel_transform_reduce_impl(::std::forward<decltype(s)>(s),
+                                                                   ::std::forward<decltype(init)>(init), op, f));
+
+#endif
+
+namespace detail
+{
+
 // NOTE: for now, pass the series with a const reference. In the future,
 // we may want to allow for perfect forwarding to exploit rvalue
 // semantics in series_sym_extender().
@@ -4651,6 +6196,1038 @@ inline constexpr auto add_symbols = [](auto &&s, const symbol_set &ss)
 
 #endif
 
+namespace detail
+{
+
+// The reference type of the range R.
+template <typename R>
+using lin_comb_ref_t = typename ::std::iterator_traits<detected_t<range_begin_t, R>>::reference;
+
+// The scalar and series types of the pair-like
+// elements of the range R.
+template <typename R>
+using lin_comb_scalar_t = remove_cvref_t<decltype(::std::get<0>(::std::declval<lin_comb_ref_t<R>>()))>;
+
+template <typename R>
+using lin_comb_series_t = remove_cvref_t<decltype(::std::get<1>(::std::declval<lin_comb_ref_t<R>>()))>;
+
+// Establish the algorithm to be used in linear_combination():
+// - 0: the operation is not well-defined,
+// - 1: accumulation via fma3(),
+// - 2: accumulation via multiplication and in-place addition.
+template <typename R>
+constexpr int linear_combination_algorithm_impl()
+{
+    // NOTE: the range must be a forward range yielding lvalue
+    // references, as we will be storing pointers to the scalars
+    // and series.
+    if constexpr (::std::conjunction_v<is_forward_range<R>,
+                                       ::std::is_lvalue_reference<detected_t<lin_comb_ref_t, R>>>) {
+        using scalar_t = detected_t<lin_comb_scalar_t, R>;
+        using series_t = detected_t<lin_comb_series_t, R>;
+
+        if constexpr (::std::conjunction_v<
+                          // The second element must be a series
+                          // of rank higher than the first element.
+                          ::std::bool_constant<(series_rank<series_t> > series_rank<scalar_t>)>,
+                          // We may need to merge the symbol sets.
+                          ::std::is_copy_constructible<series_t>,
+                          is_symbols_mergeable_key<const detected_t<series_key_t, series_t> &>>) {
+            using cf_t = series_cf_t<series_t>;
+
+            // NOTE: the return type is series_t, thus the product of the
+            // scalar by a coefficient must yield exactly the coefficient type
+            // (otherwise, the products would be truncated when accumulated
+            // into the result, e.g., a rational scalar with integral
+            // coefficients).
+            if constexpr (!::std::is_same_v<detected_t<mul_t, const scalar_t &, const cf_t &>, cf_t>) {
+                return 0;
+            } else if constexpr (is_mult_addable_v<cf_t &, const scalar_t &, const cf_t &>) {
+                return 1;
+            } else if constexpr (is_in_place_addable_v<cf_t &, cf_t>) {
+                return 2;
+            } else {
+                return 0;
+            }
+        } else {
+            return 0;
+        }
+    } else {
+        return 0;
+    }
+}
+
+template <typename R>
+inline constexpr int linear_combination_algo = detail::linear_combination_algorithm_impl<R>();
+
+// Implementation of linear_combination(): compute sum_i c_i * s_i,
+// where (c_i, s_i) are the elements of the range r.
+// The symbol sets of the series are merged once at the beginning,
+// and then the result is accumulated in parallel over the tables
+// of the output series.
+template <typename R, ::std::enable_if_t<linear_combination_algo<R &&> != 0, int> = 0>
+inline lin_comb_series_t<R &&> linear_combination_impl(R &&r)
+{
+    using scalar_t = lin_comb_scalar_t<R &&>;
+    using series_t = lin_comb_series_t<R &&>;
+    using term_t = series_term_t<series_t>;
+    using s_size_t = decltype(::std::declval<const series_t &>().get_s_size());
+
+    // Collect pointers to the scalars and to the series,
+    // and determine the merged symbol set, the number
+    // of segments and the size of the largest series.
+    ::std::vector<const scalar_t *> scalars;
+    ::std::vector<const series_t *> series_ptrs;
+    symbol_set merged_ss;
+    s_size_t log2_size = 0;
+    typename series_t::size_type max_size = 0;
+    for (auto &&p : r) {
+        const auto &c = ::std::get<0>(p);
+        const auto &s = ::std::get<1>(p);
+
+        scalars.push_back(&c);
+        series_ptrs.push_back(&s);
+
+        if (series_ptrs.size() == 1u) {
+            merged_ss = s.get_symbol_set();
+        } else if (s.get_symbol_set() != merged_ss) {
+            merged_ss = ::std::get<0>(detail::merge_symbol_sets(merged_ss, s.get_symbol_set()));
+        }
+
+        log2_size = ::std::max(log2_size, s.get_s_size());
+        max_size = ::std::max(max_size, s.size());
+    }
+
+    const auto n_series = series_ptrs.size();
+
+    series_t retval;
+    retval.set_symbol_set(merged_ss);
+
+    if (n_series == 0u) {
+        return retval;
+    }
+
+    // Extend the symbol sets of the series, if needed.
+    ::std::vector<series_t> ext_series;
+    ext_series.reserve(n_series);
+    for (auto &s_ptr : series_ptrs) {
+        if (s_ptr->get_symbol_set() != merged_ss) {
+            ext_series.push_back(::obake::add_symbols(*s_ptr, merged_ss));
+            s_ptr = &ext_series.back();
+        }
+    }
+
+    // Prepare the output series. The size of the largest
+    // input series is used as an estimate of the final size.
+    retval.set_n_segments(log2_size);
+    retval.reserve(max_size);
+
+    auto &out_tables = retval._get_s_table();
+    const auto n_tables = out_tables.size();
+    const auto mask = n_tables - 1u;
+
+    // For the series whose segmentation differs from the
+    // segmentation of the output, sort (in parallel) pointers to
+    // the terms according to their destination table in the output.
+    ::std::vector<::std::vector<const term_t *>> t_ptrs(n_series);
+    ::std::vector<::std::vector<::std::size_t>> t_offsets(n_series);
+    ::tbb::parallel_for(
+        ::tbb::blocked_range<decltype(series_ptrs.size())>(0, n_series),
+        [&series_ptrs, &t_ptrs, &t_offsets, log2_size, n_tables, mask](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                const auto &s = *series_ptrs[i];
+
+                if (s.get_s_size() == log2_size) {
+                    continue;
+                }
+
+                auto &offsets = t_offsets[i];
+                offsets.assign(static_cast<decltype(offsets.size())>(n_tables + 1u), 0);
+                for (const auto &t : s) {
+                    ++offsets[static_cast<::std::size_t>(::obake::hash(t.first) & mask) + 1u];
+                }
+                ::std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+                auto pos(offsets);
+                auto &ptrs = t_ptrs[i];
+                ptrs.resize(s.size());
+                for (const auto &t : s) {
+                    ptrs[pos[static_cast<::std::size_t>(::obake::hash(t.first) & mask)]++] = &t;
+                }
+            }
+        });
+
+    // Helper to accumulate c * term into the output table.
+    auto accumulate = [&retval, n_tables](auto &table, const scalar_t &c, const term_t &t) {
+        // NOTE: if the key is not in the table yet, it will be
+        // inserted with a default-constructed (i.e., zero) coefficient.
+        const auto res = table.try_emplace(t.first);
+
+        // NOTE: the table size needs to be checked only if a new
+        // term was actually inserted. If the check fails, the table
+        // will be cleared out in the catch block below.
+        if (n_tables > 1u && res.second && obake_unlikely(table.size() > retval._get_max_table_size())) {
+            // LCOV_EXCL_START
+            obake_throw(::std::overflow_error, "Cannot attempt the insertion of a new term into a series: the "
+                                               "destination table already contains the maximum number of terms ("
+                                                   + detail::to_string(retval._get_max_table_size()) + ")");
+            // LCOV_EXCL_STOP
+        }
+
+        auto &out_c = res.first->second;
+
+        if constexpr (linear_combination_algo<R &&> == 1) {
+            ::obake::fma3(out_c, c, t.second);
+        } else {
+            out_c += c * t.second;
+        }
+    };
+
+    // Accumulate the result, in parallel over the output tables.
+    ::tbb::parallel_for(::tbb::blocked_range<decltype(out_tables.size())>(0, n_tables), [&](const auto &range) {
+        for (auto j = range.begin(); j != range.end(); ++j) {
+            auto &table = out_tables[j];
+
+            try {
+                for (decltype(series_ptrs.size()) i = 0; i < n_series; ++i) {
+                    const auto &s = *series_ptrs[i];
+                    const auto &c = *scalars[i];
+
+                    if (s.get_s_size() == log2_size) {
+                        // Same segmentation as the output: the terms
+                        // of table j can end up only in table j.
+                        for (const auto &t : s._get_s_table()[j]) {
+                            accumulate(table, c, t);
+                        }
+                    } else {
+                        const auto &offsets = t_offsets[i];
+                        for (auto idx = offsets[j]; idx < offsets[j + 1u]; ++idx) {
+                            accumulate(table, c, *t_ptrs[i][idx]);
+                        }
+                    }
+                }
+
+                // Remove the terms which ended up with a zero coefficient
+                // (see filter_impl() for the erasure technique).
+                const auto it_f = table.end();
+                for (auto it = table.begin(); it != it_f;) {
+                    if (::obake::is_zero(::std::as_const(it->second))) {
+                        table.erase(it++);
+                    } else {
+                        ++it;
+                    }
+                }
+            } catch (...) {
+                // NOTE: if something threw, the table might now be in an
+                // inconsistent state. Clear it out before rethrowing.
+                table.clear();
+
+                throw;
+            }
+        }
+    });
+
+    return retval;
+}
+
+} // namespace detail
+
+#if defined(OBAKE_MSVC_LAMBDA_WORKAROUND)
+
+struct linear_combination_msvc {
+    template <typename R>
+    constexpr auto operator()(R &&r) const
+        OBAKE_SS_FORWARD_MEMBER_FUNCTION(detail::linear_combination_impl(::std::forward<R>(r)))
+};
+
+inline constexpr auto linear_combination = linear_combination_msvc{};
+
+#else
+
+// NOTE: the elements of the input range must be pair-like
+// objects (e.g., std::pair or std::tuple) containing a scalar
+// and a series.
+inline constexpr auto linear_combination
+    = [](auto &&r) OBAKE_SS_FORWARD_LAMBDA(detail::linear_combination_impl(::std::forward<decltype(r)>(r)));
+
+#endif
+
+namespace detail
+{
+
+// Native serialisation of series appearing as
+// coefficients of other series: the symbol set and
+// the number of terms are followed by the terms.
+template <typename K, typename C, typename Tag>
+struct native_s11n<series<K, C, Tag>,
+                   ::std::enable_if_t<::std::conjunction_v<is_native_s11n<K>, is_native_s11n<C>>>> {
+    static ::std::string tag()
+    {
+        return "series<" + native_s11n<K>::tag() + "," + native_s11n<C>::tag() + "," + ::obake::type_name<Tag>()
+               + ">";
+    }
+    static void save(native_s11n_writer &w, const series<K, C, Tag> &s, const symbol_set &)
+    {
+        const auto &ss = s.get_symbol_set();
+
+        detail::native_s11n_save_ss(w, ss);
+        w.write_value(static_cast<::std::uint64_t>(s.size()));
+        for (const auto &t : s) {
+            native_s11n<K>::save(w, t.first, ss);
+            native_s11n<C>::save(w, t.second, ss);
+        }
+    }
+    static void load(native_s11n_reader &r, series<K, C, Tag> &s, const symbol_set &)
+    {
+        series<K, C, Tag> retval;
+        retval.set_symbol_set(detail::native_s11n_load_ss(r));
+        const auto &ss = retval.get_symbol_set();
+
+        const auto size = r.read_value<::std::uint64_t>();
+
+        K tmp_k;
+        C tmp_c;
+        for (::std::uint64_t i = 0; i < size; ++i) {
+            native_s11n<K>::load(r, tmp_k, ss);
+            native_s11n<C>::load(r, tmp_c, ss);
+
+            // NOTE: nested series are small and carry no
+            // segmentation information, thus we just run
+            // all the checks on insertion.
+            detail::series_add_term<true, sat_check_zero::on, sat_check_compat_key::on, sat_check_table_size::on,
+                                    sat_assume_unique::off>(retval, ::std::as_const(tmp_k), ::std::as_const(tmp_c));
+        }
+
+        s = ::std::move(retval);
+    }
+};
+
+// Magic bytes, version and byte order marker
+// of the native serialisation format for series.
+inline constexpr char series_native_magic[] = "OBAKESER";
+inline constexpr ::std::uint32_t series_native_version = 1;
+inline constexpr ::std::uint32_t series_native_bom = 0x01020304ul;
+
+// Flags of the native serialisation format for series.
+inline constexpr ::std::uint32_t series_native_flag_compressed = 1u;
+inline constexpr ::std::uint32_t series_native_flag_indexed = 2u;
+
+// Entry of the segment index in the native serialisation
+// format for series. The offset is relative to the beginning
+// of the data section, where the keys of each segment are
+// stored before its coefficients.
+struct series_native_seg_info {
+    ::std::uint64_t n_terms;
+    ::std::uint64_t offset;
+    ::std::uint64_t key_bytes;
+    ::std::uint64_t cf_bytes;
+};
+
+// Entry of the on-disk hash index of a segment (indexed mode only).
+// The offsets are relative to the beginning of the key and
+// coefficient blocks of the segment.
+struct series_native_hash_entry {
+    ::std::uint64_t hash;
+    ::std::uint64_t key_offset;
+    ::std::uint64_t cf_offset;
+};
+
+// Encode the terms of the table tab, writing the keys
+// into kb, the coefficients into cb and, in indexed mode,
+// the hash index into ib.
+template <typename K, typename C, typename Table>
+inline void series_native_save_segment(native_s11n_writer &kb, native_s11n_writer &cb, native_s11n_writer &ib,
+                                       const Table &tab, const symbol_set &ss, native_s11n_mode mode)
+{
+    if (mode == native_s11n_mode::plain) {
+        // NOTE: the in-memory sizes of the keys/coefficients
+        // are a reasonable guess for the sizes of the encodings.
+        kb.reserve(tab.size() * sizeof(K));
+        cb.reserve(tab.size() * sizeof(C));
+
+        for (const auto &t : tab) {
+            native_s11n<K>::save(kb, t.first, ss);
+            native_s11n<C>::save(cb, t.second, ss);
+        }
+
+        return;
+    }
+
+    if (mode == native_s11n_mode::indexed) {
+        // Sort the terms according to the hashes of the keys,
+        // and record for each term its hash and the offsets
+        // of its key and coefficient.
+        ::std::vector<::std::pair<::std::uint64_t, const typename Table::value_type *>> v;
+        v.reserve(tab.size());
+        for (const auto &t : tab) {
+            v.emplace_back(static_cast<::std::uint64_t>(::obake::hash(t.first)), &t);
+        }
+        ::std::sort(v.begin(), v.end(), [](const auto &p1, const auto &p2) { return p1.first < p2.first; });
+
+        kb.reserve(tab.size() * sizeof(K));
+        cb.reserve(tab.size() * sizeof(C));
+        ib.reserve(tab.size() * sizeof(series_native_hash_entry));
+
+        for (const auto &[h, t_ptr] : v) {
+            ib.write_value(series_native_hash_entry{h, static_cast<::std::uint64_t>(kb.buffer().size()),
+                                                    static_cast<::std::uint64_t>(cb.buffer().size())});
+            native_s11n<K>::save(kb, t_ptr->first, ss);
+            native_s11n<C>::save(cb, t_ptr->second, ss);
+        }
+
+        return;
+    }
+
+    if constexpr (is_native_s11n_key_delta_v<K>) {
+        // Sort the terms according to the integral
+        // representation of the keys, and store the
+        // differences between consecutive keys.
+        ::std::vector<::std::pair<::std::uint64_t, const C *>> v;
+        v.reserve(tab.size());
+        for (const auto &t : tab) {
+            v.emplace_back(native_s11n_key_delta<K>::to_uint(t.first), &t.second);
+        }
+        ::std::sort(v.begin(), v.end(), [](const auto &p1, const auto &p2) { return p1.first < p2.first; });
+
+        ::std::uint64_t prev = 0;
+        for (const auto &[n, c_ptr] : v) {
+            kb.write_varint(n - prev);
+            prev = n;
+
+            detail::native_s11n_save_compact(cb, *c_ptr, ss);
+        }
+    } else {
+        for (const auto &t : tab) {
+            native_s11n<K>::save(kb, t.first, ss);
+            detail::native_s11n_save_compact(cb, t.second, ss);
+        }
+    }
+}
+
+// Write into h the header of the native serialisation format
+// for a series with symbol set ss, 2**log2_size segments and
+// segment index index.
+template <typename K, typename C>
+inline void series_native_write_header(native_s11n_writer &h, const symbol_set &ss, unsigned log2_size,
+                                       native_s11n_mode mode, const ::std::vector<series_native_seg_info> &index)
+{
+    assert(index.size() == ::std::size_t(1) << log2_size);
+
+    h.write(series_native_magic, sizeof(series_native_magic) - 1u);
+    h.write_value(series_native_version);
+    h.write_value(series_native_bom);
+    switch (mode) {
+        case native_s11n_mode::compressed:
+            h.write_value(series_native_flag_compressed);
+            break;
+        case native_s11n_mode::indexed:
+            h.write_value(series_native_flag_indexed);
+            break;
+        default:
+            h.write_value(::std::uint32_t(0));
+    }
+    h.write_value(static_cast<::std::uint32_t>(log2_size));
+    detail::native_s11n_save_ss(h, ss);
+    h.write_string(native_s11n<K>::tag());
+    h.write_string(native_s11n<C>::tag());
+
+    for (const auto &info : index) {
+        h.write_value(info);
+    }
+}
+
+// Approximate size (in bytes) of the groups of segments
+// which are encoded in memory before being written out
+// when saving a series in the native serialisation format.
+inline constexpr ::std::size_t series_native_group_bytes = ::std::size_t(1) << 26;
+
+// Streaming writer for the native serialisation format of series.
+// The header is written first with a placeholder segment index,
+// then the segments are encoded and written out in groups and,
+// at the end, the placeholder index is overwritten with the
+// actual one. Thus, only the encoding of the current group
+// of segments needs to be kept in memory.
+// NOTE: if the output stream is not seekable, the encoded
+// groups are kept in memory and written out, after the
+// header, by finish().
+template <typename K, typename C>
+class series_native_stream_writer
+{
+public:
+    explicit series_native_stream_writer(::std::ostream &os, const symbol_set &ss, unsigned log2_size,
+                                         native_s11n_mode mode)
+        : m_os(&os), m_ss(&ss), m_log2_size(log2_size), m_mode(mode), m_index(::std::size_t(1) << log2_size),
+          m_h_pos(os.tellp())
+    {
+        if (seekable()) {
+            native_s11n_writer h;
+            detail::series_native_write_header<K, C>(h, ss, log2_size, mode, m_index);
+            write_buffer(h);
+        }
+    }
+
+    // Encode and write out the segments [begin, end) of the segmented
+    // table s_table, in parallel. The groups must be written in order.
+    // If Release is true, the memory of the tables is released as soon
+    // as they have been encoded.
+    template <bool Release, typename STable>
+    void write_segments(STable &s_table, ::std::size_t begin, ::std::size_t end)
+    {
+        assert(begin == m_n_written);
+        assert(begin <= end && end <= m_index.size());
+
+        const auto n = end - begin;
+
+        ::std::vector<native_s11n_writer> k_bufs(n), c_bufs(n), i_bufs(n);
+        ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, n), [&](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                auto &tab = s_table[begin + i];
+                detail::series_native_save_segment<K, C>(k_bufs[i], c_bufs[i], i_bufs[i], tab, *m_ss, m_mode);
+                m_index[begin + i].n_terms = static_cast<::std::uint64_t>(tab.size());
+                if constexpr (Release) {
+                    remove_cvref_t<decltype(tab)>{}.swap(tab);
+                }
+            }
+        });
+
+        for (::std::size_t i = 0; i < n; ++i) {
+            auto &info = m_index[begin + i];
+            info.offset = m_offset;
+            info.key_bytes = static_cast<::std::uint64_t>(k_bufs[i].buffer().size());
+            info.cf_bytes = static_cast<::std::uint64_t>(c_bufs[i].buffer().size());
+
+            m_offset += info.key_bytes + info.cf_bytes + static_cast<::std::uint64_t>(i_bufs[i].buffer().size());
+
+            if (seekable()) {
+                write_buffer(k_bufs[i]);
+                write_buffer(c_bufs[i]);
+                write_buffer(i_bufs[i]);
+            } else {
+                m_pending.push_back(::std::move(k_bufs[i]));
+                m_pending.push_back(::std::move(c_bufs[i]));
+                m_pending.push_back(::std::move(i_bufs[i]));
+            }
+        }
+
+        m_n_written = end;
+    }
+
+    // Write out the final segment index, after
+    // all the segments have been written.
+    void finish()
+    {
+        assert(m_n_written == m_index.size());
+
+        native_s11n_writer h;
+        detail::series_native_write_header<K, C>(h, *m_ss, m_log2_size, m_mode, m_index);
+
+        if (seekable()) {
+            const auto end_pos = m_os->tellp();
+            m_os->seekp(m_h_pos);
+            write_buffer(h);
+            m_os->seekp(end_pos);
+        } else {
+            write_buffer(h);
+            for (const auto &w : m_pending) {
+                write_buffer(w);
+            }
+            m_pending.clear();
+        }
+    }
+
+private:
+    bool seekable() const
+    {
+        return m_h_pos != ::std::ostream::pos_type(-1);
+    }
+    void write_buffer(const native_s11n_writer &w) const
+    {
+        m_os->write(w.buffer().data(), static_cast<::std::streamsize>(w.buffer().size()));
+    }
+
+    ::std::ostream *m_os;
+    const symbol_set *m_ss;
+    unsigned m_log2_size;
+    native_s11n_mode m_mode;
+    ::std::vector<series_native_seg_info> m_index;
+    ::std::ostream::pos_type m_h_pos;
+    ::std::size_t m_n_written = 0;
+    ::std::uint64_t m_offset = 0;
+    ::std::vector<native_s11n_writer> m_pending;
+};
+
+// Layout of the native serialisation format for series:
+// - the magic bytes,
+// - the version, byte order marker, flags and log2 of
+//   the number of segments (as 32-bit unsigned integers),
+// - the symbol set,
+// - the tags of the key and coefficient types,
+// - the segment index (one series_native_seg_info per segment),
+// - the data section (for each segment, the keys, the coefficients
+//   and, in indexed mode, the hash index).
+template <typename K, typename C, typename Tag>
+inline void series_native_save_impl(::std::ostream &os, const series<K, C, Tag> &s, native_s11n_mode mode,
+                                    ::std::size_t group_bytes = series_native_group_bytes)
+{
+    const auto &s_table = s._get_s_table();
+    const auto n_segs = static_cast<::std::size_t>(s_table.size());
+
+    series_native_stream_writer<K, C> w(os, s.get_symbol_set(), s.get_s_size(), mode);
+
+    // Encode and write out the segments in groups whose
+    // in-memory sizes add up to (roughly) group_bytes,
+    // so that the encoding of the whole series is never held in memory.
+    for (::std::size_t begin = 0; begin < n_segs;) {
+        auto end = begin;
+        ::std::size_t bytes = 0;
+        do {
+            bytes += s_table[end].size() * (sizeof(K) + sizeof(C));
+            ++end;
+        } while (end < n_segs && bytes < group_bytes);
+
+        w.template write_segments<false>(s_table, begin, end);
+        begin = end;
+    }
+
+    w.finish();
+
+    if (obake_unlikely(!os)) {
+        obake_throw(::std::runtime_error,
+                    "An error occurred while writing a series in the native serialisation format");
+    }
+}
+
+// Header of the native serialisation format for series,
+// as parsed and validated by series_native_read_header().
+struct series_native_header {
+    symbol_set ss;
+    unsigned log2_size;
+    ::std::uint32_t flags;
+    ::std::vector<series_native_seg_info> index;
+    // Pointer to the beginning of the data section
+    // (null if the data section is not in memory).
+    const char *data;
+};
+
+// Size of the fixed-size prefix of the header of the native
+// serialisation format (magic bytes, version, byte order
+// marker, flags and log2 of the number of segments).
+inline constexpr ::std::size_t series_native_prefix_size
+    = sizeof(series_native_magic) - 1u + 4u * sizeof(::std::uint32_t);
+
+// Parse and validate the fixed-size prefix of the header of the
+// native serialisation format from r. Returns the flags and
+// the log2 of the number of segments.
+template <typename K, typename C, typename Tag>
+inline ::std::pair<::std::uint32_t, unsigned> series_native_parse_prefix(native_s11n_reader &r)
+{
+    using series_t = series<K, C, Tag>;
+
+    char magic[sizeof(series_native_magic) - 1u];
+    r.read(magic, sizeof(magic));
+    if (obake_unlikely(::std::memcmp(magic, series_native_magic, sizeof(magic)) != 0)) {
+        obake_throw(::std::invalid_argument, "Cannot load a series from native serialised data: the magic bytes "
+                                             "were not found");
+    }
+
+    const auto version = r.read_value<::std::uint32_t>();
+    if (obake_unlikely(version != series_native_version)) {
+        obake_throw(::std::invalid_argument, "Cannot load a series from native serialised data: the version of the "
+                                             "format ("
+                                                 + detail::to_string(version) + ") is not supported");
+    }
+
+    if (obake_unlikely(r.read_value<::std::uint32_t>() != series_native_bom)) {
+        obake_throw(::std::invalid_argument, "Cannot load a series from native serialised data: the data was "
+                                             "produced on a machine with a different byte order");
+    }
+
+    // NOTE: the compressed and indexed modes are mutually exclusive.
+    const auto flags = r.read_value<::std::uint32_t>();
+    if (obake_unlikely(flags != 0u && flags != series_native_flag_compressed
+                       && flags != series_native_flag_indexed)) {
+        obake_throw(::std::invalid_argument, "Cannot load a series from native serialised data: the flags ("
+                                                 + detail::to_string(flags) + ") are not supported");
+    }
+
+    const auto log2_size = r.read_value<::std::uint32_t>();
+    if (obake_unlikely(log2_size > series_t::get_max_s_size())) {
+        obake_throw(::std::invalid_argument, "Cannot load a series from native serialised data: the number of "
+                                             "segments (2**"
+                                                 + detail::to_string(log2_size) + ") is too large");
+    }
+
+    return {flags, static_cast<unsigned>(log2_size)};
+}
+
+// Parse and validate the header of the native serialisation
+// format from r, which is left at the beginning of the data
+// section. The segment index is not checked against the
+// size of the data section.
+template <typename K, typename C, typename Tag>
+inline series_native_header series_native_parse_header(native_s11n_reader &r)
+{
+    using series_t = series<K, C, Tag>;
+
+    const auto [flags, log2_size] = detail::series_native_parse_prefix<K, C, Tag>(r);
+
+    auto ss = detail::native_s11n_load_ss(r);
+
+    for (const auto &[tag, exp_tag, name] : {::std::tuple{r.read_string(), native_s11n<K>::tag(), "key"},
+                                             ::std::tuple{r.read_string(), native_s11n<C>::tag(), "coefficient"}}) {
+        if (obake_unlikely(tag != exp_tag)) {
+            obake_throw(::std::invalid_argument, "Cannot load a series from native serialised data: the "
+                                                     + ::std::string(name) + " type tag in the data ('" + tag
+                                                     + "') differs from the expected tag ('" + exp_tag + "')");
+        }
+    }
+
+    // Read the segment index.
+    const auto n_segs = ::std::size_t(1) << log2_size;
+    if (obake_unlikely(n_segs > r.remaining() / sizeof(series_native_seg_info))) {
+        obake_throw(::std::invalid_argument, "Invalid data detected during native deserialisation: the "
+                                             "data ended unexpectedly");
+    }
+    ::std::vector<series_native_seg_info> index(n_segs);
+    r.read(index.data(), n_segs * sizeof(series_native_seg_info));
+
+    const auto max_table_size = static_cast<::std::uint64_t>(
+        detail::limits_max<typename series_t::size_type> / (typename series_t::s_size_type(1) << log2_size));
+    for (const auto &info : index) {
+        if (obake_unlikely(info.n_terms > max_table_size)) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during the native deserialisation of a "
+                                                 "series: a segment contains too many terms");
+        }
+    }
+
+    return series_native_header{::std::move(ss), log2_size, flags, ::std::move(index), nullptr};
+}
+
+// Parse and validate the header of the native serialisation
+// format stored in the range [begin, end).
+template <typename K, typename C, typename Tag>
+inline series_native_header series_native_read_header(const char *begin, const char *end)
+{
+    native_s11n_reader r(begin, end);
+
+    auto h = detail::series_native_parse_header<K, C, Tag>(r);
+    h.data = r.current();
+
+    // Validate the segment index.
+    const auto data_size = static_cast<::std::uint64_t>(r.remaining());
+    const auto indexed = h.flags == series_native_flag_indexed;
+    for (const auto &info : h.index) {
+        if (obake_unlikely(info.offset > data_size || info.key_bytes > data_size - info.offset
+                           || info.cf_bytes > data_size - info.offset - info.key_bytes
+                           || (indexed
+                               && info.n_terms > (data_size - info.offset - info.key_bytes - info.cf_bytes)
+                                                     / sizeof(series_native_hash_entry)))) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during the native deserialisation of a "
+                                                 "series: the segment index is inconsistent with the size of the "
+                                                 "data");
+        }
+    }
+
+    return h;
+}
+
+// Sequential decoder for the terms of a segment
+// in the native serialisation format.
+template <typename K, typename C>
+class series_native_seg_decoder
+{
+public:
+    // NOTE: seg_data points to the beginning of the
+    // data of the segment idx.
+    explicit series_native_seg_decoder(const series_native_header &h, ::std::size_t idx, const char *seg_data)
+        : m_kr(seg_data, seg_data + h.index[idx].key_bytes),
+          m_cr(seg_data + h.index[idx].key_bytes, seg_data + h.index[idx].key_bytes + h.index[idx].cf_bytes),
+          m_ss(&h.ss), m_n_terms(h.index[idx].n_terms),
+          m_compressed((h.flags & series_native_flag_compressed) != 0u)
+    {
+        check_end();
+    }
+    explicit series_native_seg_decoder(const series_native_header &h, ::std::size_t idx)
+        : series_native_seg_decoder(h, idx, h.data + h.index[idx].offset)
+    {
+    }
+
+    // Number of terms left to be decoded.
+    ::std::uint64_t remaining() const
+    {
+        return m_n_terms;
+    }
+
+    // Decode the next term into k and c.
+    void next(K &k, C &c)
+    {
+        assert(m_n_terms > 0u);
+
+        if (m_compressed) {
+            if constexpr (is_native_s11n_key_delta_v<K>) {
+                const auto delta = m_kr.read_varint();
+                if (obake_unlikely(delta > ::std::numeric_limits<::std::uint64_t>::max() - m_prev)) {
+                    obake_throw(::std::invalid_argument, "Invalid data detected during the native deserialisation "
+                                                         "of a series: a delta-encoded key overflows");
+                }
+                m_prev += delta;
+                native_s11n_key_delta<K>::from_uint(k, m_prev);
+            } else {
+                native_s11n<K>::load(m_kr, k, *m_ss);
+            }
+            detail::native_s11n_load_compact(m_cr, c, *m_ss);
+        } else {
+            native_s11n<K>::load(m_kr, k, *m_ss);
+            native_s11n<C>::load(m_cr, c, *m_ss);
+        }
+
+        --m_n_terms;
+        check_end();
+    }
+
+private:
+    // Once all the terms have been decoded, check
+    // that the key and coefficient blocks were consumed
+    // exactly.
+    void check_end() const
+    {
+        if (obake_unlikely(m_n_terms == 0u && (m_kr.remaining() != 0u || m_cr.remaining() != 0u))) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during the native deserialisation of a "
+                                                 "series: the size of a segment is inconsistent with its content");
+        }
+    }
+
+    native_s11n_reader m_kr;
+    native_s11n_reader m_cr;
+    const symbol_set *m_ss;
+    ::std::uint64_t m_n_terms;
+    ::std::uint64_t m_prev = 0;
+    bool m_compressed;
+};
+
+// Load the terms of the segment idx of a series from its data,
+// which begins at seg_data. mask is the number of segments minus one.
+template <typename K, typename C, typename Table>
+inline void series_native_load_segment(Table &tab, ::std::size_t idx, ::std::size_t mask,
+                                       const series_native_header &h, const char *seg_data)
+{
+    assert(tab.empty());
+
+    const auto &info = h.index[idx];
+    series_native_seg_decoder<K, C> dec(h, idx, seg_data);
+
+    // NOTE: don't trust n_terms blindly when reserving
+    // space: all the supported coefficient types
+    // are encoded in at least one byte.
+    tab.reserve(static_cast<decltype(tab.size())>(::std::min(info.n_terms, info.key_bytes + info.cf_bytes)));
+
+    K tmp_k;
+    C tmp_c;
+    while (dec.remaining() != 0u) {
+        dec.next(tmp_k, tmp_c);
+
+        // NOTE: like in the Boost.serialization load() member function,
+        // we assume that the original series had no zero coefficients
+        // and no incompatible keys. We do check though that the keys
+        // are unique and stored in the correct segment, as that comes
+        // essentially for free.
+        if (obake_unlikely(mask != 0u && (::obake::hash(::std::as_const(tmp_k)) & mask) != idx)) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during the native deserialisation of a "
+                                                 "series: a key is stored in the wrong segment");
+        }
+        if (obake_unlikely(!tab.try_emplace(::std::move(tmp_k), ::std::move(tmp_c)).second)) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during the native deserialisation of a "
+                                                 "series: duplicate keys were detected");
+        }
+    }
+}
+
+// Build a series from a parsed header of the
+// native serialisation format.
+template <typename K, typename C, typename Tag>
+inline series<K, C, Tag> series_native_decode(const series_native_header &h)
+{
+    series<K, C, Tag> retval;
+    retval.set_symbol_set(h.ss);
+    retval.set_n_segments(h.log2_size);
+
+    // Decode the segments in parallel. Thanks to the index,
+    // each segment is read from its own chunk of the data
+    // and inserted directly into its own table.
+    auto &s_table = retval._get_s_table();
+    const auto n_segs = h.index.size();
+    ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, n_segs), [&s_table, &h, n_segs](const auto &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            detail::series_native_load_segment<K, C>(s_table[i], i, n_segs - 1u, h, h.data + h.index[i].offset);
+        }
+    });
+
+    return retval;
+}
+
+// Load a series from the native serialisation
+// format stored in the range [begin, end).
+template <typename K, typename C, typename Tag>
+inline void series_native_load_impl(series<K, C, Tag> &s, const char *begin, const char *end)
+{
+    s = detail::series_native_decode<K, C, Tag>(detail::series_native_read_header<K, C, Tag>(begin, end));
+}
+
+// Load a series from the native serialisation format
+// stored in the input stream is. The data section is read
+// and decoded in groups of segments, so that only the encoding
+// of the current group needs to be kept in memory.
+template <typename K, typename C, typename Tag>
+inline series<K, C, Tag> series_native_load_stream(::std::istream &is,
+                                                  ::std::size_t group_bytes = series_native_group_bytes)
+{
+    auto read_exact = [&is](::std::vector<char> &buf, ::std::uint64_t n) {
+        if (obake_unlikely(!detail::native_s11n_read_exact(is, buf, n))) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during the native deserialisation of a "
+                                                 "series: the data ended unexpectedly");
+        }
+    };
+    auto read_u64 = [&read_exact](::std::vector<char> &buf) {
+        read_exact(buf, sizeof(::std::uint64_t));
+        ::std::uint64_t retval;
+        ::std::memcpy(&retval, buf.data() + buf.size() - sizeof(::std::uint64_t), sizeof(::std::uint64_t));
+        return retval;
+    };
+
+    // Read the raw bytes of the header. The fixed-size prefix
+    // is validated first, so that the number of segments can be
+    // trusted. The symbol set and the type tags are read according
+    // to their encoded lengths, and they are validated when
+    // the whole header is parsed.
+    ::std::vector<char> buf;
+    read_exact(buf, series_native_prefix_size);
+    native_s11n_reader pr(buf.data(), buf.data() + buf.size());
+    const auto log2_size = detail::series_native_parse_prefix<K, C, Tag>(pr).second;
+    for (auto n_symbols = read_u64(buf); n_symbols != 0u; --n_symbols) {
+        read_exact(buf, read_u64(buf));
+    }
+    for (auto i = 0; i < 2; ++i) {
+        read_exact(buf, read_u64(buf));
+    }
+    read_exact(buf, static_cast<::std::uint64_t>(::std::size_t(1) << log2_size) * sizeof(series_native_seg_info));
+
+    native_s11n_reader r(buf.data(), buf.data() + buf.size());
+    const auto h = detail::series_native_parse_header<K, C, Tag>(r);
+    assert(r.remaining() == 0u);
+
+    // Compute the sizes of the segments in the data section.
+    // NOTE: the segments must be stored contiguously and in order,
+    // as they are read sequentially from the stream.
+    const auto n_segs = h.index.size();
+    const auto indexed = h.flags == series_native_flag_indexed;
+    ::std::vector<::std::uint64_t> seg_sizes(n_segs);
+    ::std::uint64_t offset = 0;
+    for (::std::size_t i = 0; i < n_segs; ++i) {
+        const auto &info = h.index[i];
+        constexpr auto u64_max = ::std::numeric_limits<::std::uint64_t>::max();
+
+        if (obake_unlikely(info.offset != offset || info.key_bytes > u64_max - offset
+                           || info.cf_bytes > u64_max - offset - info.key_bytes
+                           || (indexed
+                               && info.n_terms > (u64_max - offset - info.key_bytes - info.cf_bytes)
+                                                     / sizeof(series_native_hash_entry)))) {
+            obake_throw(::std::invalid_argument, "Invalid data detected during the native deserialisation of a "
+                                                 "series: the segment index is inconsistent with the size of the "
+                                                 "data");
+        }
+
+        seg_sizes[i] = info.key_bytes + info.cf_bytes
+                       + (indexed ? info.n_terms * sizeof(series_native_hash_entry) : ::std::uint64_t(0));
+        offset += seg_sizes[i];
+    }
+
+    series<K, C, Tag> retval;
+    retval.set_symbol_set(h.ss);
+    retval.set_n_segments(h.log2_size);
+    auto &s_table = retval._get_s_table();
+
+    // Read the segments in groups whose encoded sizes add up
+    // to (roughly) group_bytes, and decode
+    // each group in parallel.
+    for (::std::size_t begin = 0; begin < n_segs;) {
+        auto end = begin;
+        ::std::uint64_t bytes = 0;
+        do {
+            bytes += seg_sizes[end];
+            ++end;
+        } while (end < n_segs && bytes < group_bytes);
+
+        buf.clear();
+        read_exact(buf, bytes);
+
+        ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(begin, end),
+                            [&s_table, &h, &buf, begin, n_segs](const auto &range) {
+                                for (auto i = range.begin(); i != range.end(); ++i) {
+                                    detail::series_native_load_segment<K, C>(
+                                        s_table[i], i, n_segs - 1u, h,
+                                        buf.data() + (h.index[i].offset - h.index[begin].offset));
+                                }
+                            });
+
+        begin = end;
+    }
+
+    return retval;
+}
+
+} // namespace detail
+
+// Save the series s in obake's native binary serialisation format.
+// The format is designed for fast save/load of large series on
+// the same machine, and it is not portable across platforms
+// with different byte orders or data models. The compressed mode
+// trades some encoding time for a (much) smaller output, while
+// the indexed mode adds an on-disk hash index enabling fast lookups
+// via series_view.
+template <typename K, typename C, typename Tag,
+          ::std::enable_if_t<detail::is_native_s11n_v<series<K, C, Tag>>, int> = 0>
+inline void native_save(::std::ostream &os, const series<K, C, Tag> &s,
+                        native_s11n_mode mode = native_s11n_mode::plain)
+{
+    detail::series_native_save_impl(os, s, mode);
+}
+
+template <typename K, typename C, typename Tag,
+          ::std::enable_if_t<detail::is_native_s11n_v<series<K, C, Tag>>, int> = 0>
+inline void native_save(const ::std::string &filename, const series<K, C, Tag> &s,
+                        native_s11n_mode mode = native_s11n_mode::plain)
+{
+    ::std::ofstream ofs(filename, ::std::ios::binary | ::std::ios::trunc);
+    if (obake_unlikely(!ofs.is_open())) {
+        obake_throw(::std::runtime_error, "Cannot open the file '" + filename + "' for writing");
+    }
+
+    detail::series_native_save_impl(ofs, s, mode);
+}
+
+// Load the series s from data in obake's native binary
+// serialisation format (in either mode, which is detected
+// automatically). If an exception is thrown, s is left
+// unmodified.
+template <typename K, typename C, typename Tag,
+          ::std::enable_if_t<detail::is_native_s11n_v<series<K, C, Tag>>, int> = 0>
+inline void native_load(::std::istream &is, series<K, C, Tag> &s)
+{
+    s = detail::series_native_load_stream<K, C, Tag>(is);
+}
+
+template <typename K, typename C, typename Tag,
+          ::std::enable_if_t<detail::is_native_s11n_v<series<K, C, Tag>>, int> = 0>
+inline void native_load(const ::std::string &filename, series<K, C, Tag> &s)
+{
+    // NOTE: memory-map the file, so that the segments
+    // can be decoded in parallel directly from the mapping,
+    // without reading the whole file into a buffer first.
+    const detail::mmap_file f(filename);
+
+    detail::series_native_load_impl(s, f.data(), f.data() + f.size());
+}
+
 } // namespace obake
 
 namespace boost::serialization
@@ -0,0 +1,472 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OBAKE_SERIES_VIEW_HPP
+#define OBAKE_SERIES_VIEW_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/container/container_fwd.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <obake/detail/mmap_file.hpp>
+#include <obake/detail/to_string.hpp>
+#include <obake/exceptions.hpp>
+#include <obake/hash.hpp>
+#include <obake/key/key_evaluate.hpp>
+#include <obake/math/evaluate.hpp>
+#include <obake/native_s11n.hpp>
+#include <obake/series.hpp>
+#include <obake/symbols.hpp>
+#include <obake/type_traits.hpp>
+
+namespace obake
+{
+
+// Read-only view on a series stored in a file in
+// obake's native serialisation format. The file is
+// memory-mapped and the terms are decoded on demand,
+// thus no hash table is ever built. Lookups via find()
+// are efficient only if the file was saved in indexed
+// mode: otherwise, the segment of the key is scanned
+// linearly.
+// NOTE: copies of a view share the same mapping.
+template <typename K, typename C, typename Tag>
+class series_view
+{
+    static_assert(detail::is_native_s11n_v<series<K, C, Tag>>,
+                  "A series view can be created only for series types supporting the native serialisation format.");
+
+public:
+    using series_type = series<K, C, Tag>;
+    using key_type = K;
+    using cf_type = C;
+    using tag_type = Tag;
+    using size_type = typename series_type::size_type;
+    using value_type = ::std::pair<K, C>;
+
+    explicit series_view(const ::std::string &filename)
+        : m_file(::std::make_shared<const detail::mmap_file>(filename)),
+          m_header(detail::series_native_read_header<K, C, Tag>(m_file->data(), m_file->data() + m_file->size()))
+    {
+        // NOTE: the header validation ensures that the number of
+        // terms in each segment is not greater than the max table
+        // size, thus the total cannot overflow size_type.
+        for (const auto &info : m_header.index) {
+            m_size += static_cast<size_type>(info.n_terms);
+        }
+    }
+
+    // Input iterator decoding the terms
+    // of the view sequentially.
+    class const_iterator
+    {
+        friend class series_view;
+
+    public:
+        using iterator_category = ::std::input_iterator_tag;
+        using value_type = typename series_view::value_type;
+        using difference_type = ::std::ptrdiff_t;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        // NOTE: a default-constructed iterator
+        // is the end iterator.
+        const_iterator() = default;
+
+        reference operator*() const
+        {
+            assert(m_view != nullptr);
+            return m_cur;
+        }
+        pointer operator->() const
+        {
+            return &**this;
+        }
+        const_iterator &operator++()
+        {
+            next();
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            auto retval(*this);
+            next();
+            return retval;
+        }
+        friend bool operator==(const const_iterator &a, const const_iterator &b)
+        {
+            return a.m_view == b.m_view && a.m_count == b.m_count;
+        }
+        friend bool operator!=(const const_iterator &a, const const_iterator &b)
+        {
+            return !(a == b);
+        }
+
+    private:
+        explicit const_iterator(const series_view *v) : m_view(v)
+        {
+            next();
+        }
+        // Decode the next term, moving to the next non-empty
+        // segment if needed. When there are no more terms,
+        // the iterator becomes the end iterator.
+        void next()
+        {
+            assert(m_view != nullptr);
+
+            const auto &h = m_view->m_header;
+            while (!m_dec || m_dec->remaining() == 0u) {
+                if (m_seg == h.index.size()) {
+                    *this = const_iterator{};
+                    return;
+                }
+                m_dec.emplace(h, m_seg++);
+            }
+
+            m_dec->next(m_cur.first, m_cur.second);
+            ++m_count;
+        }
+
+        const series_view *m_view = nullptr;
+        ::std::size_t m_seg = 0;
+        ::std::uint64_t m_count = 0;
+        ::std::optional<detail::series_native_seg_decoder<K, C>> m_dec;
+        value_type m_cur;
+    };
+
+    const_iterator begin() const
+    {
+        return empty() ? end() : const_iterator(this);
+    }
+    const_iterator end() const
+    {
+        return const_iterator{};
+    }
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    size_type size() const
+    {
+        return m_size;
+    }
+    bool empty() const
+    {
+        return m_size == 0u;
+    }
+    const symbol_set &get_symbol_set() const
+    {
+        return m_header.ss;
+    }
+    unsigned get_s_size() const
+    {
+        return m_header.log2_size;
+    }
+    // Size in bytes of the underlying file.
+    ::std::size_t file_size() const
+    {
+        return m_file->size();
+    }
+    // Check if the file was saved in indexed mode.
+    bool is_indexed() const
+    {
+        return m_header.flags == detail::series_native_flag_indexed;
+    }
+
+    // Look up the coefficient of the key k.
+    ::std::optional<C> find(const K &k) const
+    {
+        const auto &h = m_header;
+        const auto idx = static_cast<::std::size_t>(::obake::hash(k) & (h.index.size() - 1u));
+
+        if (is_indexed()) {
+            return find_indexed(k, idx);
+        }
+
+        // No index available, decode the segment
+        // until the key is found.
+        detail::series_native_seg_decoder<K, C> dec(h, idx);
+        K tmp_k;
+        C tmp_c;
+        while (dec.remaining() != 0u) {
+            dec.next(tmp_k, tmp_c);
+            if (tmp_k == k) {
+                return tmp_c;
+            }
+        }
+
+        return ::std::nullopt;
+    }
+
+    // Load the whole series into memory. The segments
+    // are decoded in parallel.
+    series_type to_series() const
+    {
+        return detail::series_native_decode<K, C, Tag>(m_header);
+    }
+
+    // Decode all the terms into a vector, in parallel
+    // over the segments. The order of the terms
+    // is the same as the iteration order.
+    ::std::vector<value_type> to_term_vector() const
+    {
+        const auto &h = m_header;
+        const auto n_segs = h.index.size();
+
+        // Starting position of each segment
+        // in the output vector.
+        ::std::vector<::std::size_t> start(n_segs);
+        for (::std::size_t i = 1; i < n_segs; ++i) {
+            start[i] = start[i - 1u] + static_cast<::std::size_t>(h.index[i - 1u].n_terms);
+        }
+
+        ::std::vector<value_type> retval(static_cast<::std::size_t>(m_size));
+        ::tbb::parallel_for(::tbb::blocked_range<::std::size_t>(0, n_segs),
+                            [&h, &start, &retval](const auto &range) {
+                                for (auto i = range.begin(); i != range.end(); ++i) {
+                                    detail::series_native_seg_decoder<K, C> dec(h, i);
+                                    for (auto j = start[i]; dec.remaining() != 0u; ++j) {
+                                        dec.next(retval[j].first, retval[j].second);
+                                    }
+                                }
+                            });
+
+        return retval;
+    }
+
+    const detail::series_native_header &_get_header() const
+    {
+        return m_header;
+    }
+
+private:
+    // Lookup via the on-disk hash index of the segment idx.
+    ::std::optional<C> find_indexed(const K &k, ::std::size_t idx) const
+    {
+        using entry_t = detail::series_native_hash_entry;
+
+        const auto &h = m_header;
+        const auto &info = h.index[idx];
+        const auto k_begin = h.data + info.offset;
+        const auto c_begin = k_begin + info.key_bytes;
+        const auto i_begin = c_begin + info.cf_bytes;
+
+        // NOTE: the entries are not necessarily aligned
+        // in the mapping, read them via memcpy().
+        auto read_entry = [i_begin](::std::uint64_t i) {
+            entry_t e;
+            ::std::memcpy(&e, i_begin + i * sizeof(entry_t), sizeof(entry_t));
+            return e;
+        };
+
+        // Locate the first entry whose hash is not less than
+        // the hash of k via binary search.
+        const auto hk = static_cast<::std::uint64_t>(::obake::hash(k));
+        ::std::uint64_t lo = 0, hi = info.n_terms;
+        while (lo < hi) {
+            const auto mid = lo + (hi - lo) / 2u;
+            if (read_entry(mid).hash < hk) {
+                lo = mid + 1u;
+            } else {
+                hi = mid;
+            }
+        }
+
+        // Check the keys with matching hashes.
+        K tmp_k;
+        for (; lo < info.n_terms; ++lo) {
+            const auto e = read_entry(lo);
+            if (e.hash != hk) {
+                break;
+            }
+
+            if (obake_unlikely(e.key_offset >= info.key_bytes || e.cf_offset >= info.cf_bytes)) {
+                obake_throw(::std::invalid_argument, "Invalid data detected in a series view: an entry of the "
+                                                     "hash index points outside its segment");
+            }
+
+            detail::native_s11n_reader kr(k_begin + e.key_offset, c_begin);
+            detail::native_s11n<K>::load(kr, tmp_k, h.ss);
+            if (tmp_k == k) {
+                C retval;
+                detail::native_s11n_reader cr(c_begin + e.cf_offset, i_begin);
+                detail::native_s11n<C>::load(cr, retval, h.ss);
+                return retval;
+            }
+        }
+
+        return ::std::nullopt;
+    }
+
+    ::std::shared_ptr<const detail::mmap_file> m_file;
+    detail::series_native_header m_header;
+    size_type m_size = 0;
+};
+
+namespace detail
+{
+
+template <typename T>
+struct is_series_view_impl : ::std::false_type {
+};
+
+template <typename K, typename C, typename Tag>
+struct is_series_view_impl<series_view<K, C, Tag>> : ::std::true_type {
+};
+
+} // namespace detail
+
+template <typename T>
+using is_series_view = detail::is_series_view_impl<T>;
+
+template <typename T>
+inline constexpr bool is_series_view_v = is_series_view<T>::value;
+
+template <typename T>
+using is_cvr_series_view = is_series_view<remove_cvref_t<T>>;
+
+template <typename T>
+inline constexpr bool is_cvr_series_view_v = is_cvr_series_view<T>::value;
+
+namespace detail
+{
+
+// Apply the functor f to a decoder for each non-empty segment
+// of the view v (in parallel), and combine the partial results
+// serially via op, as explained in ordered_reduce().
+template <typename V, typename F, typename Op>
+inline auto series_view_segment_reduce(const V &v, const F &f, const Op &op)
+{
+    using dec_t = series_native_seg_decoder<typename V::key_type, typename V::cf_type>;
+    using ret_t = remove_cvref_t<decltype(f(::std::declval<dec_t &>()))>;
+
+    const auto &h = v._get_header();
+
+    return detail::ordered_reduce(
+        static_cast<::std::size_t>(h.index.size()),
+        [&h, &f](::std::size_t i) {
+            ::std::optional<ret_t> retval;
+
+            if (h.index[i].n_terms != 0u) {
+                dec_t dec(h, i);
+                retval.emplace(f(dec));
+            }
+
+            return retval;
+        },
+        op);
+}
+
+} // namespace detail
+
+namespace customisation::internal
+{
+
+// Evaluation of a series view, which shares the
+// requirements and the return type of the evaluation
+// of the corresponding series type.
+template <typename T, typename U>
+constexpr int series_view_evaluate_algorithm_impl()
+{
+    if constexpr (is_cvr_series_view_v<T>) {
+        return series_default_evaluate_impl::algo<const typename remove_cvref_t<T>::series_type &, U>;
+    } else {
+        return 0;
+    }
+}
+
+struct series_view_evaluate_impl {
+    template <typename T>
+    using series_t = typename remove_cvref_t<T>::series_type;
+
+    template <typename T, typename U>
+    static constexpr auto algo = internal::series_view_evaluate_algorithm_impl<T, U>();
+
+    template <typename T, typename U>
+    using ret_t = series_default_evaluate_impl::ret_t<const series_t<T> &, U>;
+
+    template <typename T, typename U>
+    ret_t<T, U> operator()(const T &v, const symbol_map<U> &sm) const
+    {
+        const auto &ss = v.get_symbol_set();
+        const auto si = detail::sm_intersect_idx(sm, ss);
+
+        if (obake_unlikely(si.size() != ss.size())) {
+            // Helper to extract a string reference from an item in sm.
+            struct str_extractor {
+                const ::std::string &operator()(const typename symbol_map<U>::value_type &p) const
+                {
+                    return p.first;
+                }
+            };
+
+            obake_throw(
+                ::std::invalid_argument,
+                "Cannot evaluate a series view: the evaluation map, which contains the symbols "
+                    + detail::to_string(symbol_set(::boost::container::ordered_unique_range_t{},
+                                                   ::boost::make_transform_iterator(sm.cbegin(), str_extractor{}),
+                                                   ::boost::make_transform_iterator(sm.cend(), str_extractor{})))
+                    + ", does not contain all the symbols in the view's symbol set, " + detail::to_string(ss));
+        }
+
+        // Evaluate the segments in parallel, and
+        // accumulate the partial results.
+        auto retval = detail::series_view_segment_reduce(
+            v,
+            [&si, &ss, &sm](auto &dec) {
+                ret_t<T, U> acc(0);
+
+                typename T::key_type k;
+                typename T::cf_type c;
+                while (dec.remaining() != 0u) {
+                    dec.next(k, c);
+                    acc += ::obake::key_evaluate(::std::as_const(k), si, ss)
+                           * ::obake::evaluate(::std::as_const(c), sm);
+                }
+
+                return acc;
+            },
+            [](auto &acc, auto &&p) { acc += ::std::move(p); });
+
+        return retval ? ::std::move(*retval) : ret_t<T, U>(0);
+    }
+};
+
+template <typename T, typename U>
+#if defined(OBAKE_HAVE_CONCEPTS)
+requires(series_view_evaluate_impl::algo<T, U> != 0) inline constexpr auto evaluate<T, U>
+#else
+inline constexpr auto evaluate<T, U, ::std::enable_if_t<series_view_evaluate_impl::algo<T, U> != 0>>
+#endif
+    = series_view_evaluate_impl{};
+
+} // namespace customisation::internal
+
+} // namespace obake
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <obake/config.hpp>
+#include <obake/detail/mmap_file.hpp>
+#include <obake/exceptions.hpp>
+
+namespace obake::detail
+{
+
+// NOTE: Boost.Interprocess is header-only, and
+// it provides a portable wrapper around mmap()
+// and the Windows file mapping API.
+struct mmap_file::impl {
+    ::boost::interprocess::file_mapping m_fm;
+    ::boost::interprocess::mapped_region m_region;
+};
+
+mmap_file::mmap_file(const ::std::string &filename)
+{
+    // NOTE: mapping an empty file is an error,
+    // thus we check the file size first.
+    ::std::ifstream ifs(filename, ::std::ios::binary | ::std::ios::ate);
+    if (obake_unlikely(!ifs.is_open())) {
+        obake_throw(::std::runtime_error, "Cannot open the file '" + filename + "' for reading");
+    }
+    const auto fsize = ifs.tellg();
+    ifs.close();
+
+    m_impl = ::std::make_unique<impl>();
+    if (fsize == 0) {
+        return;
+    }
+
+    try {
+        m_impl->m_fm = ::boost::interprocess::file_mapping(filename.c_str(), ::boost::interprocess::read_only);
+        m_impl->m_region = ::boost::interprocess::mapped_region(m_impl->m_fm, ::boost::interprocess::read_only);
+        // LCOV_EXCL_START
+    } catch (const ::boost::interprocess::interprocess_exception &e) {
+        obake_throw(::std::runtime_error, "Cannot memory-map the file '" + filename + "': " + e.what());
+    }
+    // LCOV_EXCL_STOP
+
+    // NOTE: the whole file is about to be read, let the
+    // OS know so that it can start the readahead.
+    // This is just a hint, ignore failures.
+    m_impl->m_region.advise(::boost::interprocess::mapped_region::advice_willneed);
+}
+
+mmap_file::~mmap_file() = default;
+
+const char *mmap_file::data() const
+{
+    return static_cast<const char *>(m_impl->m_region.get_address());
+}
+
+mmap_file::size_type mmap_file::size() const
+{
+    return m_impl->m_region.get_size();
+}
+
+} // namespace obake::detail
@@ -0,0 +1,98 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cassert>
+#include <mutex>
+#include <utility>
+
+#include <obake/polynomials/mul_profile.hpp>
+
+namespace obake::polynomials
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// The global state of the profiling machinery.
+// NOTE: the callback is copied out of the critical
+// section before being invoked, so that it can
+// install a new callback or query the last profile.
+struct mul_profile_state {
+    ::std::mutex mutex;
+    mul_profile last;
+    mul_profile_callback callback;
+};
+
+mul_profile_state &get_mul_profile_state()
+{
+    static mul_profile_state state;
+
+    return state;
+}
+
+} // namespace
+
+void mul_profile_deliver(mul_profile &&p)
+{
+    auto &state = get_mul_profile_state();
+
+    mul_profile_callback cb;
+    {
+        ::std::lock_guard<::std::mutex> lock(state.mutex);
+        state.last = p;
+        cb = state.callback;
+    }
+
+    if (cb) {
+        cb(p);
+    }
+}
+
+} // namespace detail
+
+const char *mul_phase_name(mul_phase p)
+{
+    switch (p) {
+        case mul_phase::copy:
+            return "copy";
+        case mul_phase::overflow_check:
+            return "overflow_check";
+        case mul_phase::estimate:
+            return "estimate";
+        case mul_phase::sort:
+            return "sort";
+        case mul_phase::segment:
+            return "segment";
+        case mul_phase::multiply:
+            return "multiply";
+        default:
+            assert(p == mul_phase::cleanup);
+            return "cleanup";
+    }
+}
+
+void set_mul_profile_callback(mul_profile_callback cb)
+{
+    auto &state = detail::get_mul_profile_state();
+
+    ::std::lock_guard<::std::mutex> lock(state.mutex);
+    state.callback = ::std::move(cb);
+}
+
+mul_profile get_last_mul_profile()
+{
+    auto &state = detail::get_mul_profile_state();
+
+    ::std::lock_guard<::std::mutex> lock(state.mutex);
+    return state.last;
+}
+
+} // namespace obake::polynomials
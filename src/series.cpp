@@ -6,8 +6,13 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <limits>
+#include <locale>
 #include <mutex>
+#include <sstream>
 #include <string>
 #include <tuple>
 
@@ -18,6 +23,14 @@ namespace obake
 namespace detail
 {
 
+// The global segmentation policy.
+::std::atomic_bool series_seg_policy_enabled(series_segmentation_policy{}.enabled);
+::std::atomic<::std::size_t> series_seg_policy_segment_bytes(series_segmentation_policy{}.segment_bytes);
+::std::atomic<unsigned> series_seg_policy_max_log2_size(series_segmentation_policy{}.max_log2_size);
+
+// The global memory budget (no limit by default).
+::std::atomic<::std::size_t> series_mem_budget(0);
+
 // Implementation of the default streaming for a single term.
 void series_stream_single_term(::std::string &ret, ::std::string &str_cf, const ::std::string &str_key, bool tex_mode)
 {
@@ -82,4 +95,74 @@ void clear_series_pow_map()
 
 } // namespace customisation::internal
 
+::std::string series_table_stats::to_string() const
+{
+    ::std::ostringstream oss;
+
+    oss << "Total number of terms             : " << n_terms << '\n';
+    oss << "Total number of tables            : " << n_tables << '\n';
+
+    if (n_terms != 0u) {
+        oss << "Average terms per table           : " << mean_terms << '\n';
+        oss << "Min/max terms per table           : " << min_terms << '/' << max_terms << '\n';
+        oss << "Imbalance coefficient             : " << imbalance << '\n';
+    }
+
+    oss << "Total capacity                    : " << total_capacity << '\n';
+    oss << "Load factor                       : " << load_factor << '\n';
+
+    if (has_probe_lengths && n_terms != 0u) {
+        oss << "Mean/max probe length             : " << mean_probe_length << '/' << max_probe_length << '\n';
+    }
+
+    oss << "Slack size in bytes               : " << slack_bytes << '\n';
+    oss << "Total size in bytes               : " << total_bytes << '\n';
+
+    if (n_tables > 1u) {
+        oss << "Load factor histogram             :\n";
+        for (::std::size_t i = 0; i < occupancy_histogram.size(); ++i) {
+            oss << "  [" << static_cast<double>(i) / 10 << ", " << static_cast<double>(i + 1u) / 10
+                << (i + 1u == occupancy_histogram.size() ? "]" : ")") << " : " << occupancy_histogram[i] << '\n';
+        }
+    }
+
+    return oss.str();
+}
+
+::std::string series_table_stats::to_json() const
+{
+    ::std::ostringstream oss;
+    // NOTE: ensure the output is not influenced
+    // by the global locale, and that the floating-point
+    // values round-trip.
+    oss.imbue(::std::locale::classic());
+    oss.precision(::std::numeric_limits<double>::max_digits10);
+
+    oss << "{\"n_terms\": " << n_terms << ", \"n_tables\": " << n_tables << ", \"min_terms\": " << min_terms
+        << ", \"max_terms\": " << max_terms << ", \"mean_terms\": " << mean_terms << ", \"imbalance\": " << imbalance
+        << ", \"total_capacity\": " << total_capacity << ", \"load_factor\": " << load_factor;
+    if (has_probe_lengths) {
+        oss << ", \"mean_probe_length\": " << mean_probe_length << ", \"max_probe_length\": " << max_probe_length;
+    }
+    oss << ", \"slack_bytes\": " << slack_bytes << ", \"total_bytes\": " << total_bytes
+        << ", \"occupancy_histogram\": [";
+    for (::std::size_t i = 0; i < occupancy_histogram.size(); ++i) {
+        oss << (i == 0u ? "" : ", ") << occupancy_histogram[i];
+    }
+    oss << "], \"tables\": [";
+    for (::std::size_t i = 0; i < tables.size(); ++i) {
+        const auto &ti = tables[i];
+        oss << (i == 0u ? "" : ", ") << "{\"size\": " << ti.size << ", \"capacity\": " << ti.capacity
+            << ", \"load_factor\": " << ti.load_factor;
+        if (has_probe_lengths) {
+            oss << ", \"mean_probe_length\": " << ti.mean_probe_length
+                << ", \"max_probe_length\": " << ti.max_probe_length;
+        }
+        oss << '}';
+    }
+    oss << "]}";
+
+    return oss.str();
+}
+
 } // namespace obake
@@ -0,0 +1,453 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <utility>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/hash.hpp>
+#include <obake/math/pow.hpp>
+#include <obake/native_s11n.hpp>
+#include <obake/polynomials/d_packed_monomial.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+#include <obake/symbols.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace obake;
+
+using obake_test::segmented_copy;
+
+// Round-trip of x via the native serialisation primitives.
+template <typename T>
+inline T native_round_trip(const T &x, const symbol_set &ss = symbol_set{})
+{
+    detail::native_s11n_writer w;
+    detail::native_s11n<T>::save(w, x, ss);
+
+    const auto &buf = w.buffer();
+    detail::native_s11n_reader r(buf.data(), buf.data() + buf.size());
+
+    T retval;
+    detail::native_s11n<T>::load(r, retval, ss);
+    REQUIRE(r.remaining() == 0u);
+
+    return retval;
+}
+
+// Round-trip of x via the compact encodings.
+template <typename T>
+inline T compact_round_trip(const T &x)
+{
+    detail::native_s11n_writer w;
+    detail::native_s11n_save_compact(w, x, symbol_set{});
+
+    const auto &buf = w.buffer();
+    detail::native_s11n_reader r(buf.data(), buf.data() + buf.size());
+
+    T retval;
+    detail::native_s11n_load_compact(r, retval, symbol_set{});
+    REQUIRE(r.remaining() == 0u);
+
+    return retval;
+}
+
+// Round-trip of the series s via a string stream.
+template <typename S>
+inline S series_round_trip(const S &s, native_s11n_mode mode = native_s11n_mode::plain)
+{
+    std::stringstream ss;
+    native_save(ss, s, mode);
+
+    S retval;
+    native_load(ss, retval);
+
+    return retval;
+}
+
+// Output stream buffer which appends the data to a string
+// and does not support seeking.
+struct unseekable_buf : std::streambuf {
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            str.push_back(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+    std::streamsize xsputn(const char *s, std::streamsize n) override
+    {
+        str.append(s, static_cast<std::size_t>(n));
+        return n;
+    }
+
+    std::string str;
+};
+
+// Check that all the terms of the segmented series s
+// are stored in the expected table.
+template <typename S>
+inline bool check_segments(const S &s)
+{
+    const auto &tables = s._get_s_table();
+
+    for (decltype(tables.size()) i = 0; i < tables.size(); ++i) {
+        for (const auto &t : tables[i]) {
+            if ((hash(t.first) & (tables.size() - 1u)) != i) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+TEST_CASE("native_s11n_primitives")
+{
+    using int_t = mppp::integer<1>;
+    using rat_t = mppp::rational<1>;
+
+    // Type traits.
+    REQUIRE(detail::is_native_s11n_v<int>);
+    REQUIRE(detail::is_native_s11n_v<double>);
+    REQUIRE(detail::is_native_s11n_v<int_t>);
+    REQUIRE(detail::is_native_s11n_v<rat_t>);
+    REQUIRE(detail::is_native_s11n_v<packed_monomial<long long>>);
+    REQUIRE(detail::is_native_s11n_v<d_packed_monomial<long long, 8>>);
+    REQUIRE(detail::is_native_s11n_v<polynomial<packed_monomial<long long>, int_t>>);
+    REQUIRE(!detail::is_native_s11n_v<std::string>);
+
+    // Tags.
+    REQUIRE(detail::native_s11n<std::int32_t>::tag() == "i32");
+    REQUIRE(detail::native_s11n<std::uint16_t>::tag() == "u16");
+    REQUIRE(detail::native_s11n<double>::tag() == "f64_53");
+    REQUIRE(detail::native_s11n<packed_monomial<std::int64_t>>::tag() == "packed_monomial<i64>");
+    REQUIRE(detail::native_s11n<d_packed_monomial<std::int64_t, 8>>::tag() == "d_packed_monomial<i64,8>");
+    REQUIRE(detail::native_s11n<int_t>::tag() != detail::native_s11n<rat_t>::tag());
+
+    // Arithmetic types.
+    REQUIRE(native_round_trip(42) == 42);
+    REQUIRE(native_round_trip(-1.5) == -1.5);
+    REQUIRE(native_round_trip(std::numeric_limits<unsigned long long>::max())
+            == std::numeric_limits<unsigned long long>::max());
+
+    // Integers and rationals, including large values.
+    for (const auto &n : {int_t{}, int_t{1}, int_t{-42}, int_t{1} << 200, -(int_t{3} << 500)}) {
+        REQUIRE(native_round_trip(n) == n);
+    }
+    for (const auto &q : {rat_t{}, rat_t{1, 3}, rat_t{-7, 2}, rat_t{int_t{1} << 300, 7}}) {
+        REQUIRE(native_round_trip(q) == q);
+    }
+
+    // Monomials.
+    REQUIRE(native_round_trip(packed_monomial<long long>{1, 2, 3}) == packed_monomial<long long>{1, 2, 3});
+    const symbol_set ss{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+    const d_packed_monomial<long long, 8> d{1, -2, 3, 4, 5, 6, 7, 8, 9, -10};
+    REQUIRE(native_round_trip(d, ss) == d);
+
+    // Symbol sets.
+    {
+        detail::native_s11n_writer w;
+        detail::native_s11n_save_ss(w, ss);
+        const auto &buf = w.buffer();
+        detail::native_s11n_reader r(buf.data(), buf.data() + buf.size());
+        REQUIRE(detail::native_s11n_load_ss(r) == ss);
+    }
+
+    // Truncated data.
+    {
+        detail::native_s11n_writer w;
+        detail::native_s11n<int_t>::save(w, int_t{1} << 200, symbol_set{});
+        const auto &buf = w.buffer();
+        detail::native_s11n_reader r(buf.data(), buf.data() + buf.size() - 1);
+
+        int_t n;
+        OBAKE_REQUIRES_THROWS_CONTAINS(detail::native_s11n<int_t>::load(r, n, symbol_set{}), std::invalid_argument,
+                                       "the data ended unexpectedly");
+    }
+}
+
+TEST_CASE("native_s11n_compact")
+{
+    using int_t = mppp::integer<1>;
+    using rat_t = mppp::rational<1>;
+
+    // Varints and zigzag mapping.
+    for (auto n : {std::uint64_t(0), std::uint64_t(1), std::uint64_t(127), std::uint64_t(128),
+                   std::uint64_t(1) << 35, std::numeric_limits<std::uint64_t>::max()}) {
+        detail::native_s11n_writer w;
+        w.write_varint(n);
+        auto n_bytes = 1u;
+        for (auto tmp = n; tmp >= 128u; tmp >>= 7) {
+            ++n_bytes;
+        }
+        REQUIRE(w.buffer().size() == n_bytes);
+
+        detail::native_s11n_reader r(w.buffer().data(), w.buffer().data() + w.buffer().size());
+        REQUIRE(r.read_varint() == n);
+    }
+    for (auto n : {std::int64_t(0), std::int64_t(-1), std::int64_t(1), std::int64_t(-64),
+                   std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()}) {
+        REQUIRE(detail::native_s11n_unzigzag(detail::native_s11n_zigzag(n)) == n);
+    }
+    REQUIRE(detail::native_s11n_zigzag(-1) == 1u);
+    REQUIRE(detail::native_s11n_zigzag(1) == 2u);
+
+    // Malformed varints.
+    {
+        const std::string bad(11, '\xff');
+        detail::native_s11n_reader r(bad.data(), bad.data() + bad.size());
+        OBAKE_REQUIRES_THROWS_CONTAINS(r.read_varint(), std::invalid_argument, "overflows 64 bits");
+
+        detail::native_s11n_reader r2(bad.data(), bad.data() + 2);
+        OBAKE_REQUIRES_THROWS_CONTAINS(r2.read_varint(), std::invalid_argument, "the data ended unexpectedly");
+    }
+
+    // Integral types.
+    REQUIRE(compact_round_trip(-42) == -42);
+    REQUIRE(compact_round_trip(std::numeric_limits<long long>::min()) == std::numeric_limits<long long>::min());
+    REQUIRE(compact_round_trip(std::numeric_limits<unsigned>::max()) == std::numeric_limits<unsigned>::max());
+    {
+        detail::native_s11n_writer w;
+        w.write_varint(std::uint64_t(1) << 40);
+        detail::native_s11n_reader r(w.buffer().data(), w.buffer().data() + w.buffer().size());
+        unsigned n;
+        OBAKE_REQUIRES_THROWS_CONTAINS(detail::native_s11n_load_compact(r, n, symbol_set{}), std::invalid_argument,
+                                       "an integral value is out of range");
+    }
+
+    // Integers of all magnitude classes.
+    for (const auto &n : {int_t{}, int_t{1}, int_t{-1}, int_t{63}, int_t{-64}, (int_t{1} << 62) - 1,
+                          -((int_t{1} << 62) - 1), int_t{1} << 62, -(int_t{1} << 62), int_t{1} << 64,
+                          -(int_t{7} << 300)}) {
+        REQUIRE(compact_round_trip(n) == n);
+    }
+    {
+        // Small values take a single byte.
+        detail::native_s11n_writer w;
+        detail::native_s11n_save_compact(w, int_t{-17}, symbol_set{});
+        REQUIRE(w.buffer().size() == 1u);
+    }
+    for (const auto &q : {rat_t{}, rat_t{1, 3}, rat_t{-7, 2}, rat_t{int_t{1} << 300, 7}}) {
+        REQUIRE(compact_round_trip(q) == q);
+    }
+
+    // Delta encoding of packed monomials.
+    using pm_t = packed_monomial<int>;
+    REQUIRE(detail::is_native_s11n_key_delta_v<pm_t>);
+    REQUIRE(!detail::is_native_s11n_key_delta_v<d_packed_monomial<long long, 8>>);
+    pm_t m;
+    detail::native_s11n_key_delta<pm_t>::from_uint(m, detail::native_s11n_key_delta<pm_t>::to_uint(pm_t{-1}));
+    REQUIRE(m == pm_t{-1});
+    OBAKE_REQUIRES_THROWS_CONTAINS(detail::native_s11n_key_delta<pm_t>::from_uint(m, std::uint64_t(1) << 40),
+                                   std::invalid_argument, "a packed value is out of range");
+}
+
+TEST_CASE("native_s11n_series")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using dpm_t = d_packed_monomial<long long, 8>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<dpm_t, mppp::rational<1>>;
+    using dpoly_t = polynomial<pm_t, double>;
+    using ppoly_t = polynomial<pm_t, poly_t>;
+
+    // Empty series.
+    REQUIRE(series_round_trip(poly_t{}).empty());
+    REQUIRE(series_round_trip(segmented_copy(poly_t{}, 3)).get_s_size() == 3u);
+
+    auto [x, y, z] = make_polynomials<poly_t>("x", "y", "z");
+    auto [a, b, c] = make_polynomials<qpoly_t>("a", "b", "c");
+    auto [u, v] = make_polynomials<dpoly_t>("u", "v");
+    auto [xp, yp] = make_polynomials<ppoly_t>("x", "y");
+
+    const auto p = obake::pow(x - 2 * y + 3 * z - 1, 10) * (mppp::integer<1>{1} << 100);
+    const auto q = obake::pow(a / 3 - b + 2 * c, 8) - a * b * c / 7;
+    const auto r = obake::pow(u - 1.5 * v, 6);
+    const auto t = obake::pow(xp * x + yp * y - 1, 4);
+
+    for (auto mode : {native_s11n_mode::plain, native_s11n_mode::compressed, native_s11n_mode::indexed}) {
+        for (auto l : {0u, 1u, 4u}) {
+            const auto ps = segmented_copy(p, l);
+            const auto ps2 = series_round_trip(ps, mode);
+            REQUIRE(ps2 == p);
+            REQUIRE(ps2.get_s_size() == l);
+            REQUIRE(ps2.get_symbol_set() == p.get_symbol_set());
+            REQUIRE(check_segments(ps2));
+
+            const auto qs = series_round_trip(segmented_copy(q, l), mode);
+            REQUIRE(qs == q);
+            REQUIRE(qs.get_s_size() == l);
+            REQUIRE(check_segments(qs));
+
+            REQUIRE(series_round_trip(segmented_copy(r, l), mode) == r);
+
+            // Nested series.
+            const auto ts = series_round_trip(segmented_copy(t, l), mode);
+            REQUIRE(ts == t);
+            REQUIRE(check_segments(ts));
+        }
+    }
+
+    // The compressed mode produces smaller output.
+    {
+        const auto [x2, y2, z2] = make_polynomials<polynomial<packed_monomial<std::uint64_t>, mppp::integer<2>>>(
+            "x", "y", "z");
+        const auto p2 = segmented_copy(obake::pow(x2 + 2 * y2 - z2 + 1, 12), 2);
+
+        std::stringstream ss_p, ss_c;
+        native_save(ss_p, p2);
+        native_save(ss_c, p2, native_s11n_mode::compressed);
+        REQUIRE(ss_c.str().size() * 2u < ss_p.str().size());
+
+        auto tmp2 = x2;
+        native_load(ss_c, tmp2);
+        REQUIRE(tmp2 == p2);
+    }
+
+    // Files.
+    {
+        const auto ps = segmented_copy(p, 2);
+        const std::string filename = "native_s11n_test.bin";
+
+        native_save(filename, ps);
+
+        poly_t tmp;
+        native_load(filename, tmp);
+        REQUIRE(tmp == p);
+        REQUIRE(tmp.get_s_size() == 2u);
+
+        std::remove(filename.c_str());
+
+        OBAKE_REQUIRES_THROWS_CONTAINS(native_load(filename, tmp), std::runtime_error,
+                                       "Cannot open the file 'native_s11n_test.bin' for reading");
+        REQUIRE(tmp == p);
+
+        // Empty file.
+        std::ofstream{filename};
+        OBAKE_REQUIRES_THROWS_CONTAINS(native_load(filename, tmp), std::invalid_argument,
+                                       "the data ended unexpectedly");
+        REQUIRE(tmp == p);
+
+        // Many segments, decoded in parallel from the mapped file.
+        const auto big = obake::pow(q + 1, 3);
+        for (auto l : {6u, 9u}) {
+            native_save(filename, segmented_copy(big, l), native_s11n_mode::compressed);
+
+            qpoly_t tmp_q;
+            native_load(filename, tmp_q);
+            REQUIRE(tmp_q == big);
+            REQUIRE(tmp_q.get_s_size() == l);
+            REQUIRE(check_segments(tmp_q));
+        }
+
+        std::remove(filename.c_str());
+    }
+
+    // Streaming in groups of segments.
+    {
+        const auto big = segmented_copy(obake::pow(q + 1, 3), 6);
+
+        for (auto mode : {native_s11n_mode::plain, native_s11n_mode::compressed, native_s11n_mode::indexed}) {
+            std::stringstream ss_ref, ss_g;
+            native_save(ss_ref, big, mode);
+            // NOTE: tiny groups, so that each segment
+            // is encoded and decoded on its own.
+            detail::series_native_save_impl(ss_g, big, mode, 1);
+            REQUIRE(ss_g.str() == ss_ref.str());
+
+            auto tmp_q = detail::series_native_load_stream<dpm_t, mppp::rational<1>, polynomials::tag>(ss_g, 1);
+            REQUIRE(tmp_q == big);
+            REQUIRE(tmp_q.get_s_size() == 6u);
+            REQUIRE(check_segments(tmp_q));
+
+            // Non-seekable output stream.
+            unseekable_buf ubuf;
+            std::ostream os(&ubuf);
+            detail::series_native_save_impl(os, big, mode, 1);
+            REQUIRE(ubuf.str == ss_ref.str());
+
+            // Truncation in the middle of the data section.
+            const auto data = ss_ref.str();
+            std::stringstream ss_t(data.substr(0, data.size() / 2u));
+            OBAKE_REQUIRES_THROWS_CONTAINS(
+                (detail::series_native_load_stream<dpm_t, mppp::rational<1>, polynomials::tag>(ss_t, 1)),
+                std::invalid_argument, "the data ended unexpectedly");
+        }
+
+        // Several series in the same stream.
+        std::stringstream ss_m;
+        native_save(ss_m, big);
+        native_save(ss_m, q, native_s11n_mode::compressed);
+        qpoly_t tmp1, tmp2;
+        native_load(ss_m, tmp1);
+        native_load(ss_m, tmp2);
+        REQUIRE(tmp1 == big);
+        REQUIRE(tmp2 == q);
+    }
+
+    // Error handling.
+    std::stringstream ss;
+    native_save(ss, segmented_copy(p, 2));
+    const auto data = ss.str();
+
+    auto load_str = [](const std::string &str, auto &s) {
+        std::stringstream tmp_ss(str);
+        native_load(tmp_ss, s);
+    };
+
+    poly_t tmp = x;
+
+    // Wrong key/coefficient types.
+    {
+        polynomial<pm_t, mppp::rational<1>> tmp_q;
+        OBAKE_REQUIRES_THROWS_CONTAINS(load_str(data, tmp_q), std::invalid_argument,
+                                       "the coefficient type tag in the data");
+        polynomial<dpm_t, mppp::integer<1>> tmp_d;
+        OBAKE_REQUIRES_THROWS_CONTAINS(load_str(data, tmp_d), std::invalid_argument, "the key type tag in the data");
+    }
+
+    // Wrong magic bytes.
+    auto bad = data;
+    bad[0] = 'X';
+    OBAKE_REQUIRES_THROWS_CONTAINS(load_str(bad, tmp), std::invalid_argument, "the magic bytes were not found");
+
+    // Wrong version.
+    bad = data;
+    bad[8] = 42;
+    OBAKE_REQUIRES_THROWS_CONTAINS(load_str(bad, tmp), std::invalid_argument, "is not supported");
+
+    // Wrong byte order.
+    bad = data;
+    std::swap(bad[12], bad[15]);
+    OBAKE_REQUIRES_THROWS_CONTAINS(load_str(bad, tmp), std::invalid_argument, "different byte order");
+
+    // Truncated data.
+    OBAKE_REQUIRES_THROWS_CONTAINS(load_str(data.substr(0, 30), tmp), std::invalid_argument,
+                                   "the data ended unexpectedly");
+    OBAKE_REQUIRES_THROWS_CONTAINS(load_str(data.substr(0, data.size() - 1u), tmp), std::invalid_argument,
+                                   "Invalid data detected during the native deserialisation of a series");
+
+    // The destination series is untouched on failure.
+    REQUIRE(tmp == x);
+}
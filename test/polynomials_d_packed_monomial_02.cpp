@@ -502,3 +502,41 @@ TEST_CASE("s11n_test")
         });
     });
 }
+
+TEST_CASE("monomial_unpack_test")
+{
+    detail::tuple_for_each(int_types{}, [](const auto &n) {
+        using int_t = remove_cvref_t<decltype(n)>;
+
+        detail::tuple_for_each(bits_widths<int_t>{}, [](auto b) {
+            constexpr auto bw = decltype(b)::value;
+            using pm_t = d_packed_monomial<int_t, bw>;
+
+            std::vector<int_t> v;
+
+            monomial_unpack(pm_t{}, symbol_set{}, v.data());
+            REQUIRE(v.empty());
+
+            v.resize(1);
+            monomial_unpack(pm_t{1}, symbol_set{"x"}, v.data());
+            REQUIRE(v == std::vector<int_t>{1});
+
+            if constexpr (bw >= 6u) {
+                // Spread the exponents over multiple
+                // packed values.
+                const std::vector<int_t> exps{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+                v.resize(exps.size());
+                monomial_unpack(pm_t(exps), symbol_set{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k"},
+                                v.begin());
+                REQUIRE(v == exps);
+
+                if constexpr (is_signed_v<int_t>) {
+                    v.resize(3);
+                    monomial_unpack(pm_t{-1, 4, -2}, symbol_set{"x", "y", "z"}, v.data());
+                    REQUIRE(v == std::vector<int_t>{-1, 4, -2});
+                }
+            }
+        });
+    });
+}
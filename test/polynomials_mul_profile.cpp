@@ -0,0 +1,125 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <string>
+
+#include <mp++/integer.hpp>
+
+#include <obake/math/pow.hpp>
+#include <obake/polynomials/mul_profile.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+
+#include "catch.hpp"
+
+using namespace obake;
+
+TEST_CASE("mul_phase_name")
+{
+    REQUIRE(polynomials::mul_phase_name(polynomials::mul_phase::copy) == std::string("copy"));
+    REQUIRE(polynomials::mul_phase_name(polynomials::mul_phase::overflow_check) == std::string("overflow_check"));
+    REQUIRE(polynomials::mul_phase_name(polynomials::mul_phase::estimate) == std::string("estimate"));
+    REQUIRE(polynomials::mul_phase_name(polynomials::mul_phase::sort) == std::string("sort"));
+    REQUIRE(polynomials::mul_phase_name(polynomials::mul_phase::segment) == std::string("segment"));
+    REQUIRE(polynomials::mul_phase_name(polynomials::mul_phase::multiply) == std::string("multiply"));
+    REQUIRE(polynomials::mul_phase_name(polynomials::mul_phase::cleanup) == std::string("cleanup"));
+}
+
+// Check the consistency of the profile p for the product
+// of polynomials with sizes s1 and s2 (untruncated).
+template <typename P>
+inline void check_profile(const polynomials::mul_profile &pr, const P &p, std::size_t s1, std::size_t s2)
+{
+    REQUIRE(pr.total_time >= 0);
+    REQUIRE(!pr.segments.empty());
+
+    unsigned long long n_mults = 0, n_ins = 0, n_coll = 0, n_erased = 0;
+    for (const auto &sp : pr.segments) {
+        REQUIRE(sp.n_mults == sp.n_insertions + sp.n_collisions);
+        n_mults += sp.n_mults;
+        n_ins += sp.n_insertions;
+        n_coll += sp.n_collisions;
+        n_erased += sp.n_erased;
+    }
+
+    REQUIRE(n_mults == static_cast<unsigned long long>(s1) * s2);
+    REQUIRE(n_ins - n_erased == p.size());
+    REQUIRE(n_ins + n_coll == n_mults);
+
+    for (auto t : pr.phase_times) {
+        REQUIRE(t >= 0);
+    }
+    for (auto t : pr.thread_busy_times) {
+        REQUIRE(t >= 0);
+    }
+}
+
+TEST_CASE("mul_profile")
+{
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    unsigned n_calls = 0;
+    polynomials::mul_profile last;
+    polynomials::set_mul_profile_callback([&n_calls, &last](const polynomials::mul_profile &pr) {
+        ++n_calls;
+        last = pr;
+    });
+
+    // Small product (simple implementation), with cancellations.
+    const auto p = (x + y + z) * (x - y);
+
+    if constexpr (polynomials::mul_profiling_enabled) {
+        REQUIRE(n_calls == 1u);
+        REQUIRE(last.algorithm == "simple");
+        REQUIRE(last.segments.size() == 1u);
+        check_profile(last, p, 3, 2);
+        REQUIRE(last.segments[0].n_erased == 1u);
+        REQUIRE(polynomials::get_last_mul_profile().algorithm == "simple");
+    } else {
+        REQUIRE(n_calls == 0u);
+        REQUIRE(polynomials::get_last_mul_profile().algorithm.empty());
+        REQUIRE(polynomials::get_last_mul_profile().segments.empty());
+    }
+
+    // Large product, possibly via the multi-threaded implementation.
+    const auto a = obake::pow(x + y + 2 * z + t + 1, 10);
+    const auto b = obake::pow(x - y - z + 3 * t - 1, 10);
+    n_calls = 0;
+    const auto ab = a * b;
+
+    if constexpr (polynomials::mul_profiling_enabled) {
+        REQUIRE(n_calls == 1u);
+        check_profile(last, ab, a.size(), b.size());
+        if (last.algorithm == "mt_hm") {
+            REQUIRE(last.segments.size() == ab._get_s_table().size());
+        }
+    } else {
+        REQUIRE(n_calls == 0u);
+    }
+
+    // Truncated multiplication.
+    n_calls = 0;
+    const auto ab_t = truncated_mul(a, b, 5);
+
+    if constexpr (polynomials::mul_profiling_enabled) {
+        REQUIRE(n_calls == 1u);
+        REQUIRE(polynomials::get_last_mul_profile().total_time >= 0);
+    } else {
+        REQUIRE(n_calls == 0u);
+    }
+
+    // Uninstall the callback.
+    polynomials::set_mul_profile_callback({});
+    n_calls = 0;
+    REQUIRE((x + y) * (x - y) == x * x - y * y);
+    REQUIRE(n_calls == 0u);
+}
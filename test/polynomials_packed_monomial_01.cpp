@@ -344,3 +344,29 @@ TEST_CASE("monomial_integrate")
         }
     });
 }
+
+TEST_CASE("monomial_unpack")
+{
+    detail::tuple_for_each(int_types{}, [](const auto &n) {
+        using int_t = remove_cvref_t<decltype(n)>;
+        using pm_t = packed_monomial<int_t>;
+
+        std::vector<int_t> v;
+
+        monomial_unpack(pm_t{}, symbol_set{}, v.data());
+        REQUIRE(v.empty());
+
+        v.resize(1);
+        monomial_unpack(pm_t{3}, symbol_set{"x"}, v.data());
+        REQUIRE(v == std::vector<int_t>{3});
+
+        v.resize(3);
+        monomial_unpack(pm_t{1, 0, 2}, symbol_set{"x", "y", "z"}, v.data());
+        REQUIRE(v == std::vector<int_t>{1, 0, 2});
+
+        if constexpr (is_signed_v<int_t>) {
+            monomial_unpack(pm_t{-1, 4, -2}, symbol_set{"x", "y", "z"}, v.begin());
+            REQUIRE(v == std::vector<int_t>{-1, 4, -2});
+        }
+    });
+}
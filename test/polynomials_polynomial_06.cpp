@@ -0,0 +1,126 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/math/evaluate.hpp>
+#include <obake/math/pow.hpp>
+#include <obake/polynomials/d_packed_monomial.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+#include <obake/symbols.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace obake;
+
+// Small helper to check the result of a batched
+// evaluation against the single-point evaluation.
+template <typename P, typename T>
+inline void check_evaluate_batch(const P &p, const symbol_map<std::vector<T>> &sm, T tol)
+{
+    const auto res = evaluate_batch(p, sm);
+
+    const auto npoints = sm.empty() ? std::size_t(0) : sm.begin()->second.size();
+    REQUIRE(res.size() == npoints);
+
+    for (std::size_t i = 0; i < npoints; ++i) {
+        symbol_map<T> cur;
+        for (const auto &q : sm) {
+            cur.emplace(q.first, q.second[i]);
+        }
+
+        const auto cmp = static_cast<T>(obake::evaluate(p, cur));
+        REQUIRE(std::abs(res[i] - cmp) <= tol * (std::abs(cmp) + 1));
+    }
+}
+
+TEST_CASE("polynomial_evaluate_batch")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using ppoly_t = polynomial<pm_t, poly_t>;
+
+    // Type checks.
+    REQUIRE(!polynomials::detail::poly_evaluate_batch_algo<const poly_t &, int>);
+    REQUIRE(!polynomials::detail::poly_evaluate_batch_algo<const ppoly_t &, double>);
+    REQUIRE(polynomials::detail::poly_evaluate_batch_algo<const poly_t &, double>);
+    REQUIRE(polynomials::detail::poly_evaluate_batch_algo<poly_t &&, float>);
+    REQUIRE(polynomials::detail::poly_evaluate_batch_algo<const polynomial<pm_t, mppp::rational<1>> &, double>);
+
+    auto [x, y, z] = make_polynomials<poly_t>("x", "y", "z");
+
+    // Empty polynomial.
+    REQUIRE(evaluate_batch(poly_t{}, symbol_map<std::vector<double>>{}).empty());
+    REQUIRE(evaluate_batch(poly_t{}, symbol_map<std::vector<double>>{{"x", {1., 2., 3.}}})
+            == std::vector<double>{0., 0., 0.});
+
+    // Constant polynomial.
+    REQUIRE(evaluate_batch(poly_t{5}, symbol_map<std::vector<double>>{{"x", {1., 2., 3.}}})
+            == std::vector<double>{5., 5., 5.});
+
+    // No points.
+    REQUIRE(evaluate_batch(x + y, symbol_map<std::vector<double>>{{"x", {}}, {"y", {}}}).empty());
+
+    // Error handling.
+    OBAKE_REQUIRES_THROWS_CONTAINS(evaluate_batch(x + y, symbol_map<std::vector<double>>{{"x", {1., 2.}}}),
+                                   std::invalid_argument,
+                                   "Cannot evaluate a polynomial in batch mode: the evaluation map does not contain "
+                                   "the symbol 'y', which appears in the polynomial's symbol set, {'x', 'y'}");
+    OBAKE_REQUIRES_THROWS_CONTAINS(
+        evaluate_batch(x + y, symbol_map<std::vector<double>>{{"x", {1., 2.}}, {"y", {1.}}}), std::invalid_argument,
+        "Cannot evaluate a polynomial in batch mode: the column of values for the symbol 'y' has a size of 1, but the "
+        "expected size is 2");
+
+    // A few simple checks.
+    REQUIRE(evaluate_batch(x * y - 2 * z, symbol_map<std::vector<double>>{{"x", {1., 2.}},
+                                                                           {"y", {3., 4.}},
+                                                                           {"z", {5., 6.}},
+                                                                           {"t", {7., 8.}}})
+            == std::vector<double>{-7., -4.});
+    REQUIRE(evaluate_batch(x * x * x + 1, symbol_map<std::vector<float>>{{"x", {1.f, 2.f, -1.f}}})
+            == std::vector<float>{2.f, 9.f, 0.f});
+
+    // Larger polynomial, with a number of points which is not a multiple
+    // of the block size.
+    auto p = obake::pow(x + 2 * y - z + 1, 6) - obake::pow(x * y * z - 3, 3);
+    symbol_map<std::vector<double>> sm;
+    for (const auto &s : {"x", "y", "z"}) {
+        auto &col = sm[s];
+        for (auto i = 0; i < 1000; ++i) {
+            col.push_back(std::sin(i * 0.37 + static_cast<double>(s[0])));
+        }
+    }
+    check_evaluate_batch(p, sm, 1E-12);
+
+    // Segmented polynomial, including empty tables.
+    check_evaluate_batch(obake_test::segmented_copy(p, 4), sm, 1E-12);
+    check_evaluate_batch(obake_test::segmented_copy(x - 2 * y * y, 6), sm, 1E-12);
+
+    // Negative exponents and rational coefficients.
+    using pm2_t = d_packed_monomial<long long, 8>;
+    using poly2_t = polynomial<pm2_t, mppp::rational<1>>;
+
+    poly2_t q;
+    q.set_symbol_set(symbol_set{"a", "b"});
+    q.add_term(pm2_t{-1, 2}, mppp::rational<1>{1, 3});
+    q.add_term(pm2_t{3, -2}, mppp::rational<1>{-7, 2});
+    q.add_term(pm2_t{0, 0}, 5);
+
+    check_evaluate_batch(q, symbol_map<std::vector<double>>{{"a", {1., 2., -3., .5}}, {"b", {4., -1., 2., 1.5}}},
+                         1E-12);
+}
@@ -0,0 +1,178 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <stdexcept>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/math/degree.hpp>
+#include <obake/math/diff.hpp>
+#include <obake/math/evaluate.hpp>
+#include <obake/math/integrate.hpp>
+#include <obake/math/p_degree.hpp>
+#include <obake/math/pow.hpp>
+#include <obake/math/subs.hpp>
+#include <obake/polynomials/d_packed_monomial.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+#include <obake/symbols.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace obake;
+
+using obake_test::segmented_copy;
+
+// Check that all the terms of the segmented polynomial p
+// are stored in the expected table.
+template <typename P>
+inline bool check_segments(const P &p)
+{
+    const auto &tables = p._get_s_table();
+
+    for (decltype(tables.size()) i = 0; i < tables.size(); ++i) {
+        for (const auto &t : tables[i]) {
+            if ((hash(t.first) & (tables.size() - 1u)) != i) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+TEST_CASE("polynomial_segmented_evaluate_subs_degree")
+{
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<pm_t, mppp::rational<1>>;
+
+    auto [x, y, z] = make_polynomials<poly_t>("x", "y", "z");
+
+    const auto p = obake::pow(x - 2 * y + 3 * z - 1, 8) + obake::pow(x * y * z, 5) - 4 * x * z;
+
+    for (auto l : {0u, 1u, 3u, 6u}) {
+        const auto ps = segmented_copy(p, l);
+
+        REQUIRE(ps.get_s_size() == l);
+        REQUIRE(ps._get_s_table().size() == 1u << l);
+        REQUIRE(ps == p);
+
+        // Evaluation.
+        REQUIRE(obake::evaluate(ps, symbol_map<mppp::integer<1>>{{"x", 3}, {"y", -2}, {"z", 5}})
+                == obake::evaluate(p, symbol_map<mppp::integer<1>>{{"x", 3}, {"y", -2}, {"z", 5}}));
+        REQUIRE(obake::evaluate(ps, symbol_map<mppp::rational<1>>{{"x", mppp::rational<1>{1, 3}},
+                                                                   {"y", mppp::rational<1>{-2, 7}},
+                                                                   {"z", 5}})
+                == obake::evaluate(p, symbol_map<mppp::rational<1>>{{"x", mppp::rational<1>{1, 3}},
+                                                                     {"y", mppp::rational<1>{-2, 7}},
+                                                                     {"z", 5}}));
+
+        // The result of floating-point evaluation must not depend
+        // on the number of threads.
+        const auto fp_res = obake::evaluate(ps, symbol_map<double>{{"x", 1.1}, {"y", -.3}, {"z", .7}});
+        for (auto i = 0; i < 10; ++i) {
+            REQUIRE(obake::evaluate(ps, symbol_map<double>{{"x", 1.1}, {"y", -.3}, {"z", .7}}) == fp_res);
+        }
+
+        // Degree.
+        REQUIRE(obake::degree(ps) == 15);
+        REQUIRE(obake::degree(ps) == obake::degree(p));
+        REQUIRE(obake::p_degree(ps, symbol_set{"x"}) == 8);
+        REQUIRE(obake::p_degree(ps, symbol_set{"x", "z"}) == 10);
+        REQUIRE(obake::p_degree(ps, symbol_set{"y", "t"}) == obake::p_degree(p, symbol_set{"y", "t"}));
+        REQUIRE(obake::p_degree(ps, symbol_set{}) == 0);
+
+        // Substitution.
+        REQUIRE(obake::subs(ps, symbol_map<mppp::integer<1>>{{"x", 2}, {"z", -1}})
+                == obake::subs(p, symbol_map<mppp::integer<1>>{{"x", 2}, {"z", -1}}));
+        REQUIRE(obake::subs(ps, symbol_map<mppp::integer<1>>{{"x", 2}, {"z", -1}})
+                == obake::pow(2 - 2 * y - 3 - 1, 8) + obake::pow(-2 * y, 5) + 8);
+        REQUIRE(obake::subs(ps, symbol_map<mppp::rational<1>>{{"y", mppp::rational<1>{1, 2}}})
+                == obake::subs(p, symbol_map<mppp::rational<1>>{{"y", mppp::rational<1>{1, 2}}}));
+        REQUIRE(obake::subs(ps, symbol_map<poly_t>{{"x", y + z}, {"y", x}})
+                == obake::subs(p, symbol_map<poly_t>{{"x", y + z}, {"y", x}}));
+        REQUIRE(obake::subs(ps, symbol_map<poly_t>{{"x", y + z}, {"y", x}})
+                == obake::pow(y + z - 2 * x + 3 * z - 1, 8) + obake::pow((y + z) * x * z, 5) - 4 * (y + z) * z);
+        REQUIRE(obake::subs(ps, symbol_map<qpoly_t>{{"t", qpoly_t{}}}) == qpoly_t{p});
+    }
+
+    // Empty polynomials.
+    REQUIRE(obake::evaluate(segmented_copy(poly_t{}, 2), symbol_map<double>{}) == 0.);
+    REQUIRE(obake::degree(segmented_copy(poly_t{}, 2)) == 0);
+    REQUIRE(obake::p_degree(segmented_copy(poly_t{}, 2), symbol_set{"x"}) == 0);
+    REQUIRE(obake::subs(segmented_copy(poly_t{}, 2), symbol_map<mppp::integer<1>>{{"x", 2}}).empty());
+}
+
+TEST_CASE("polynomial_segmented_diff_integrate")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<pm_t, mppp::rational<1>>;
+    using dpm_t = d_packed_monomial<long long, 8>;
+    using dqpoly_t = polynomial<dpm_t, mppp::rational<1>>;
+
+    auto [x, y, z] = make_polynomials<qpoly_t>("x", "y", "z");
+
+    const auto p = obake::pow(x - 2 * y + 3 * z - 1, 8) + obake::pow(x * y * z, 5) - 4 * x * z;
+
+    auto [a, b, c] = make_polynomials<dqpoly_t>("a", "b", "c");
+
+    const auto q = obake::pow(a + b / 3 - c + 2, 9) - a * b * b * c;
+
+    for (auto l : {1u, 3u, 6u}) {
+        const auto ps = segmented_copy(p, l);
+        const auto qs = segmented_copy(q, l);
+
+        for (const auto &s : {"x", "y", "z", "t"}) {
+            const auto d = obake::diff(ps, s);
+            REQUIRE(d == obake::diff(p, s));
+            REQUIRE(d.get_s_size() == l);
+            REQUIRE(check_segments(d));
+
+            const auto i = obake::integrate(ps, s);
+            REQUIRE(i == obake::integrate(p, s));
+            REQUIRE(check_segments(i));
+            REQUIRE(obake::diff(i, s) == p);
+        }
+
+        for (const auto &s : {"a", "b", "c"}) {
+            const auto d = obake::diff(qs, s);
+            REQUIRE(d == obake::diff(q, s));
+            REQUIRE(d.get_s_size() == l);
+            REQUIRE(check_segments(d));
+
+            const auto i = obake::integrate(qs, s);
+            REQUIRE(i == obake::integrate(q, s));
+            REQUIRE(i.get_s_size() == l);
+            REQUIRE(check_segments(i));
+            REQUIRE(obake::diff(i, s) == q);
+        }
+
+        // Integral coefficients, where the division
+        // in the integration may produce zero coefficients.
+        const auto [xi] = make_polynomials<poly_t>("x");
+        const auto pi = segmented_copy(2 * xi + xi * xi, l);
+        REQUIRE(obake::integrate(pi, "x") == xi * xi);
+        REQUIRE(check_segments(obake::integrate(pi, "x")));
+
+        // Integration of x**-1.
+        dqpoly_t r;
+        r.set_symbol_set(symbol_set{"a", "b"});
+        r.set_n_segments(l);
+        r.add_term(dpm_t{-1, 2}, 1);
+        r.add_term(dpm_t{1, 2}, 1);
+        OBAKE_REQUIRES_THROWS_CONTAINS(obake::integrate(r, "a"), std::domain_error,
+                                       "Cannot integrate a dynamic packed monomial: the exponent of the integration "
+                                       "variable ('a') is -1, and the integration would generate a logarithmic term");
+    }
+}
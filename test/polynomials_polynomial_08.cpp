@@ -0,0 +1,140 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <type_traits>
+#include <utility>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/math/evaluate.hpp>
+#include <obake/math/pow.hpp>
+#include <obake/math/subs.hpp>
+#include <obake/polynomials/d_packed_monomial.hpp>
+#include <obake/polynomials/monomial_subs.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+#include <obake/symbols.hpp>
+#include <obake/type_traits.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace obake;
+
+using obake_test::segmented_copy;
+
+// Reference implementation of polynomial substitution,
+// based on monomial_subs().
+template <typename P, typename U>
+inline auto subs_ref(const P &p, const symbol_map<U> &sm)
+{
+    using ret_t = remove_cvref_t<decltype(obake::subs(p, sm))>;
+
+    const auto &ss = p.get_symbol_set();
+    const auto si = obake::detail::sm_intersect_idx(sm, ss);
+
+    ret_t retval;
+    for (const auto &t : p) {
+        auto k_sub = obake::monomial_subs(t.first, si, ss);
+
+        P tmp;
+        tmp.set_symbol_set(ss);
+        tmp.add_term(std::move(k_sub.second), 1);
+
+        retval += std::move(k_sub.first) * obake::subs(t.second, sm) * tmp;
+    }
+
+    return retval;
+}
+
+TEST_CASE("polynomial_subs_cached")
+{
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<pm_t, mppp::rational<1>>;
+
+    // Algorithm selection.
+    REQUIRE(polynomials::detail::poly_subs_algo<const poly_t &, mppp::integer<1>> == 2);
+    REQUIRE(polynomials::detail::poly_subs_algo<poly_t &&, mppp::rational<1>> == 2);
+    REQUIRE(polynomials::detail::poly_subs_algo<const poly_t &, poly_t> == 2);
+    REQUIRE(polynomials::detail::poly_subs_algo<const poly_t &, double> == 2);
+    REQUIRE(polynomials::detail::poly_subs_algo<const polynomial<d_packed_monomial<long long, 8>, double> &,
+                                                mppp::integer<1>>
+            == 2);
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    const auto p = obake::pow(x - 2 * y + 3 * z * t - 1, 7) + obake::pow(x * y * z, 4) - 4 * x * z * t;
+
+    for (auto l : {0u, 2u, 5u}) {
+        const auto ps = segmented_copy(p, l);
+
+        // Direct insertion: integral values into an integral polynomial.
+        const auto sm0 = symbol_map<mppp::integer<1>>{{"x", 2}, {"z", -1}};
+        REQUIRE(std::is_same_v<decltype(obake::subs(ps, sm0)), poly_t>);
+        REQUIRE(obake::subs(ps, sm0) == subs_ref(p, sm0));
+        REQUIRE(obake::subs(ps, sm0) == obake::pow(2 - 2 * y - 3 * t - 1, 7) + obake::pow(-2 * y, 4) + 8 * t);
+        REQUIRE(obake::subs(ps, sm0).get_symbol_set() == p.get_symbol_set());
+
+        // Direct insertion: rational values.
+        const auto sm1 = symbol_map<mppp::rational<1>>{{"y", mppp::rational<1>{1, 2}}, {"t", mppp::rational<1>{-3}}};
+        REQUIRE(std::is_same_v<decltype(obake::subs(ps, sm1)), qpoly_t>);
+        REQUIRE(obake::subs(ps, sm1) == subs_ref(p, sm1));
+
+        // All the symbols substituted.
+        const auto sm2 = symbol_map<mppp::integer<1>>{{"x", 1}, {"y", 2}, {"z", 3}, {"t", 4}};
+        REQUIRE(obake::subs(ps, sm2) == subs_ref(p, sm2));
+        REQUIRE(obake::subs(ps, sm2) == poly_t{obake::evaluate(p, sm2)});
+
+        // No symbols substituted.
+        REQUIRE(obake::subs(ps, symbol_map<mppp::integer<1>>{{"a", 1}}) == p);
+
+        // Grouping: substitution of polynomials.
+        const auto sm3 = symbol_map<poly_t>{{"x", y + z}, {"y", x}};
+        REQUIRE(std::is_same_v<decltype(obake::subs(ps, sm3)), poly_t>);
+        REQUIRE(obake::subs(ps, sm3) == subs_ref(p, sm3));
+        REQUIRE(obake::subs(ps, sm3)
+                == obake::pow(y + z - 2 * x + 3 * z * t - 1, 7) + obake::pow((y + z) * x * z, 4) - 4 * (y + z) * z * t);
+
+        // Grouping with a change of coefficient type.
+        const auto sm4 = symbol_map<qpoly_t>{{"z", make_polynomials<qpoly_t>("x")[0] * mppp::rational<1>{1, 3}}};
+        REQUIRE(std::is_same_v<decltype(obake::subs(ps, sm4)), qpoly_t>);
+        REQUIRE(obake::subs(ps, sm4) == subs_ref(p, sm4));
+
+        // The symbols of the substituted polynomials
+        // must show up in the result even if the substituted
+        // symbol has zero exponent in all terms.
+        const auto sm5 = symbol_map<poly_t>{{"t", poly_t{}}};
+        REQUIRE(obake::subs(ps, sm5) == subs_ref(p, sm5));
+        REQUIRE(obake::subs(x + y, symbol_map<poly_t>{{"x", z}}).get_symbol_set() == symbol_set{"x", "y", "z"});
+    }
+
+    // Empty polynomials.
+    REQUIRE(obake::subs(poly_t{}, symbol_map<mppp::integer<1>>{{"x", 2}}).empty());
+    REQUIRE(obake::subs(segmented_copy(poly_t{}, 2), symbol_map<poly_t>{{"x", y}}).empty());
+
+    // Cancellations.
+    REQUIRE(obake::subs(x - y, symbol_map<mppp::integer<1>>{{"x", 1}, {"y", 1}}).empty());
+    REQUIRE(obake::subs(x * z - y * z, symbol_map<poly_t>{{"x", y}}).empty());
+
+    // Negative exponents.
+    using pm2_t = d_packed_monomial<long long, 8>;
+    using poly2_t = polynomial<pm2_t, mppp::rational<1>>;
+
+    poly2_t q;
+    q.set_symbol_set(symbol_set{"a", "b", "c"});
+    q.add_term(pm2_t{-1, 2, 1}, mppp::rational<1>{1, 3});
+    q.add_term(pm2_t{3, -2, 1}, mppp::rational<1>{-7, 2});
+    q.add_term(pm2_t{-1, 0, 1}, 5);
+    q.add_term(pm2_t{0, 0, 0}, 1);
+
+    const auto sm6 = symbol_map<mppp::rational<1>>{{"a", mppp::rational<1>{2, 5}}, {"b", -3}};
+    REQUIRE(obake::subs(q, sm6) == subs_ref(q, sm6));
+    REQUIRE(obake::subs(segmented_copy(q, 3), sm6) == subs_ref(q, sm6));
+}
@@ -0,0 +1,127 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <stdexcept>
+#include <type_traits>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/math/pow.hpp>
+#include <obake/math/subs.hpp>
+#include <obake/polynomials/d_packed_monomial.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+#include <obake/symbols.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace obake;
+
+TEST_CASE("polynomial_compose")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<pm_t, mppp::rational<1>>;
+
+    // Type checks.
+    REQUIRE(polynomials::detail::poly_compose_algo<const poly_t &, poly_t> == 1);
+    REQUIRE(polynomials::detail::poly_compose_algo<const poly_t &, qpoly_t> == 1);
+    REQUIRE(polynomials::detail::poly_compose_algo<const poly_t &, mppp::integer<1>> == 0);
+    REQUIRE(polynomials::detail::poly_compose_algo<const polynomial<pm_t, poly_t> &, poly_t> == 0);
+    REQUIRE(std::is_same_v<polynomials::detail::poly_compose_ret_t<const poly_t &, qpoly_t>, qpoly_t>);
+    REQUIRE(polynomials::detail::poly_compose_truncated_degree_algo<const poly_t &, poly_t, int> == 1);
+    REQUIRE(polynomials::detail::poly_compose_truncated_p_degree_algo<const poly_t &, poly_t, int> == 1);
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    // Empty polynomial.
+    REQUIRE(compose(poly_t{}, symbol_map<poly_t>{{"x", y}}).empty());
+    REQUIRE(compose(poly_t{}, symbol_map<poly_t>{{"x", y}}, 2).empty());
+
+    // Simple checks.
+    REQUIRE(compose(x, symbol_map<poly_t>{{"x", y + 1}}) == y + 1);
+    REQUIRE(compose(x * x + 2 * x + 1, symbol_map<poly_t>{{"x", y - 1}}) == y * y);
+    REQUIRE(compose(x + z, symbol_map<poly_t>{{"t", y}}) == x + z);
+    REQUIRE(compose(x * y, symbol_map<poly_t>{{"x", y}, {"y", x}}) == x * y);
+    REQUIRE(compose(x - y, symbol_map<poly_t>{{"x", z}, {"y", z}}).empty());
+
+    // The symbol set of the result contains the symbols
+    // of the substituted polynomials.
+    REQUIRE(compose(x, symbol_map<poly_t>{{"x", y + 1}}).get_symbol_set() == symbol_set{"x", "y"});
+    REQUIRE(compose(x + y, symbol_map<poly_t>{{"x", z}}).get_symbol_set() == symbol_set{"x", "y", "z"});
+
+    // Comparison with subs().
+    const auto p = obake::pow(x - 2 * y + 3 * z * t - 1, 6) + obake::pow(x * y * z, 3) - 4 * x * z * t;
+
+    const auto sm0 = symbol_map<poly_t>{{"x", y + z}, {"y", x - 2 * t}};
+    REQUIRE(compose(p, sm0) == obake::subs(p, sm0));
+
+    const auto sm1 = symbol_map<poly_t>{{"x", 1 - x * x}, {"y", y + 1}, {"z", x * t}, {"t", y * y}};
+    REQUIRE(compose(p, sm1) == obake::subs(p, sm1));
+
+    const auto sm2 = symbol_map<qpoly_t>{{"z", qpoly_t{x} * mppp::rational<1>{1, 3}}};
+    REQUIRE(std::is_same_v<decltype(compose(p, sm2)), qpoly_t>);
+    REQUIRE(compose(p, sm2) == obake::subs(p, sm2));
+
+    // Segmented input.
+    auto ps = p;
+    ps.set_n_segments(3);
+    for (const auto &term : p) {
+        ps.add_term(term.first, term.second);
+    }
+    REQUIRE(compose(ps, sm1) == obake::subs(p, sm1));
+
+    // Truncation.
+    for (auto d : {-1, 0, 3, 7, 20}) {
+        auto cmp = obake::subs(p, sm1);
+        truncate_degree(cmp, d);
+        REQUIRE(compose(p, sm1, d) == cmp);
+
+        cmp = obake::subs(p, sm1);
+        truncate_p_degree(cmp, d, symbol_set{"x", "t"});
+        REQUIRE(compose(p, sm1, d, symbol_set{"x", "t"}) == cmp);
+    }
+
+    // Truncation with high powers of the substituted polynomials.
+    {
+        const auto hp = obake::pow(x, 25) + 2 * obake::pow(x, 12) * y - obake::pow(y, 7);
+        const auto sm4 = symbol_map<poly_t>{{"x", 1 + x + y}, {"y", y - z + 1}};
+
+        auto cmp = obake::subs(hp, sm4);
+        truncate_degree(cmp, 4);
+        REQUIRE(compose(hp, sm4, 4) == cmp);
+
+        cmp = obake::subs(hp, sm4);
+        truncate_p_degree(cmp, 2, symbol_set{"y"});
+        REQUIRE(compose(hp, sm4, 2, symbol_set{"y"}) == cmp);
+    }
+
+    // Negative exponents.
+    using pm2_t = d_packed_monomial<long long, 8>;
+    using poly2_t = polynomial<pm2_t, mppp::integer<1>>;
+
+    auto [a, b] = make_polynomials<poly2_t>("a", "b");
+
+    poly2_t q;
+    q.set_symbol_set(symbol_set{"a", "b"});
+    q.add_term(pm2_t{-1, 2}, 3);
+    q.add_term(pm2_t{2, 1}, -5);
+
+    const auto sm3 = symbol_map<poly2_t>{{"b", a + b}};
+    REQUIRE(compose(q, sm3) == obake::subs(q, sm3));
+    OBAKE_REQUIRES_THROWS_CONTAINS(compose(q, symbol_map<poly2_t>{{"a", b}}, 3), std::invalid_argument,
+                                   "Cannot compute a truncated polynomial composition if the exponents of the "
+                                   "substituted symbols are negative");
+    OBAKE_REQUIRES_THROWS_CONTAINS(compose(q, symbol_map<poly2_t>{{"b", q}}, 3), std::invalid_argument,
+                                   "Cannot compute a truncated polynomial composition if the polynomials being "
+                                   "substituted contain negative exponents");
+}
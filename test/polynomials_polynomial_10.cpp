@@ -0,0 +1,169 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <vector>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/hash.hpp>
+#include <obake/math/diff.hpp>
+#include <obake/math/pow.hpp>
+#include <obake/math/truncate_degree.hpp>
+#include <obake/math/truncate_p_degree.hpp>
+#include <obake/polynomials/d_packed_monomial.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+#include <obake/symbols.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace obake;
+
+using obake_test::segmented_copy;
+
+// Check that all the terms of the segmented polynomial p
+// are stored in the expected table.
+template <typename P>
+inline bool check_segments(const P &p)
+{
+    const auto &tables = p._get_s_table();
+
+    for (decltype(tables.size()) i = 0; i < tables.size(); ++i) {
+        for (const auto &t : tables[i]) {
+            if ((hash(t.first) & (tables.size() - 1u)) != i) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Check the gradient of p against diff().
+template <typename P, typename... Args>
+inline void check_gradient(const P &p, const Args &... args)
+{
+    const auto g = gradient(p, args...);
+    const auto &ss = p.get_symbol_set();
+
+    REQUIRE(g.size() == ss.size());
+
+    for (decltype(g.size()) i = 0; i < g.size(); ++i) {
+        auto cmp = obake::diff(p, *ss.nth(i));
+        if constexpr (sizeof...(args) == 1u) {
+            obake::truncate_degree(cmp, args...);
+        } else if constexpr (sizeof...(args) == 2u) {
+            obake::truncate_p_degree(cmp, args...);
+        }
+
+        REQUIRE(g[i] == cmp);
+        REQUIRE(g[i].get_symbol_set() == ss);
+        REQUIRE(g[i].get_s_size() == p.get_s_size());
+        REQUIRE(check_segments(g[i]));
+    }
+}
+
+TEST_CASE("polynomial_gradient")
+{
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<pm_t, mppp::rational<1>>;
+    using ppoly_t = polynomial<pm_t, poly_t>;
+
+    // Algorithm selection.
+    REQUIRE(polynomials::detail::poly_gradient_algo<const poly_t &> == 2);
+    REQUIRE(polynomials::detail::poly_gradient_algo<ppoly_t &&> == 2);
+    REQUIRE(polynomials::detail::poly_gradient_truncated_degree_algo<const poly_t &, int> == 2);
+    REQUIRE(polynomials::detail::poly_gradient_truncated_p_degree_algo<const poly_t &, int> == 2);
+
+    // Empty polynomials.
+    REQUIRE(gradient(poly_t{}).empty());
+    REQUIRE(jacobian(std::vector<poly_t>{}).empty());
+
+    auto [x, y, z, t] = make_polynomials<qpoly_t>("x", "y", "z", "t");
+
+    const auto p = obake::pow(x - 2 * y + 3 * z * t - 1, 7) + obake::pow(x * y * z, 4) / 5 - 4 * x * z * t;
+
+    for (auto l : {0u, 1u, 4u}) {
+        const auto ps = segmented_copy(p, l);
+
+        check_gradient(ps);
+
+        // Truncation.
+        for (auto d : {-1, 0, 3, 8}) {
+            check_gradient(ps, d);
+            check_gradient(ps, d, symbol_set{"x", "t"});
+        }
+
+        // Dynamic packed monomials, with negative exponents.
+        using dpm_t = d_packed_monomial<long long, 8>;
+        using dpoly_t = polynomial<dpm_t, mppp::rational<1>>;
+
+        dpoly_t q;
+        q.set_symbol_set(symbol_set{"a", "b", "c"});
+        q.set_n_segments(l);
+        q.add_term(dpm_t{-1, 2, 0}, mppp::rational<1>{1, 3});
+        q.add_term(dpm_t{3, -2, 1}, mppp::rational<1>{-7, 2});
+        q.add_term(dpm_t{1, 0, 0}, 5);
+        q.add_term(dpm_t{0, 0, 0}, 1);
+
+        check_gradient(q);
+        check_gradient(q, 1);
+
+        // Polynomial coefficients, whose derivatives
+        // are not zero.
+        auto [a, b] = make_polynomials<ppoly_t>("a", "b");
+        auto [xp, yp] = make_polynomials<poly_t>("x", "a");
+
+        const auto r = segmented_copy(obake::pow(a * xp + b * yp + xp * yp, 5) - a * b, l);
+
+        check_gradient(r);
+    }
+
+    // Jacobian.
+    auto [xi, yi, zi] = make_polynomials<poly_t>("x", "y", "z");
+    std::vector<poly_t> v{obake::pow(xi + yi, 3), xi * zi - 1, poly_t{}, poly_t{5}};
+    v.push_back(segmented_copy(obake::pow(xi - zi + yi * zi, 4), 2));
+
+    const symbol_set jss{"x", "y", "z"};
+
+    const auto jac = jacobian(v);
+    REQUIRE(jac.size() == v.size());
+    for (decltype(jac.size()) i = 0; i < jac.size(); ++i) {
+        REQUIRE(jac[i].size() == 3u);
+
+        for (auto j = 0u; j < 3u; ++j) {
+            const auto &s = *jss.nth(j);
+
+            REQUIRE(jac[i][j] == obake::diff(v[i], s));
+            REQUIRE(jac[i][j].get_symbol_set() == jss);
+        }
+    }
+
+    const auto jac_t = jacobian(v, 2);
+    for (decltype(jac_t.size()) i = 0; i < jac_t.size(); ++i) {
+        for (auto j = 0u; j < 3u; ++j) {
+            auto cmp = obake::diff(v[i], *jss.nth(j));
+            obake::truncate_degree(cmp, 2);
+
+            REQUIRE(jac_t[i][j] == cmp);
+        }
+    }
+
+    const auto jac_pt = jacobian(v, 1, symbol_set{"z"});
+    for (decltype(jac_pt.size()) i = 0; i < jac_pt.size(); ++i) {
+        for (auto j = 0u; j < 3u; ++j) {
+            auto cmp = obake::diff(v[i], *jss.nth(j));
+            obake::truncate_p_degree(cmp, 1, symbol_set{"z"});
+
+            REQUIRE(jac_pt[i][j] == cmp);
+        }
+    }
+}
@@ -0,0 +1,200 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/byte_size.hpp>
+#include <obake/detail/hc.hpp>
+#include <obake/math/pow.hpp>
+#include <obake/native_s11n.hpp>
+#include <obake/polynomials/d_packed_monomial.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+#include <obake/series.hpp>
+#include <obake/series_view.hpp>
+#include <obake/symbols.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace obake;
+
+TEST_CASE("estimate_mul")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<pm_t, mppp::rational<1>>;
+    using dpoly_t = polynomial<d_packed_monomial<long long, 8>, double>;
+    using view_t = series_view<pm_t, mppp::integer<1>, polynomials::tag>;
+
+    REQUIRE(std::is_same_v<polynomials::mul_estimate, decltype(estimate_mul(poly_t{}, poly_t{}))>);
+    REQUIRE(std::is_same_v<polynomials::mul_estimate, decltype(estimate_mul(poly_t{}, qpoly_t{}, 2))>);
+    REQUIRE(std::is_same_v<polynomials::mul_estimate, decltype(estimate_mul(poly_t{}, poly_t{}, 2, symbol_set{}))>);
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    // Empty operands.
+    auto est = estimate_mul(poly_t{}, x + y);
+    REQUIRE(est.n_terms == 0);
+    REQUIRE(est.n_bytes == 0);
+    REQUIRE(est.n_mults == 0);
+    est = estimate_mul(x + y, poly_t{});
+    REQUIRE(est.n_terms == 0);
+
+    const auto p = obake::pow(x + y + 2 * z + t + 1, 6);
+    const auto q = obake::pow(x - y - z + 3 * t - 1, 7);
+    const auto cmp = p * q;
+
+    est = estimate_mul(p, q);
+    REQUIRE(est.n_mults == p.size() * q.size());
+    REQUIRE(est.n_terms > 0);
+    REQUIRE(est.n_terms <= est.n_mults);
+    REQUIRE(est.n_bytes >= est.n_terms * sizeof(pm_t));
+
+    // Symmetry in the number of multiplications.
+    REQUIRE(estimate_mul(q, p).n_mults == est.n_mults);
+
+    // Different coefficient types and symbol sets.
+    REQUIRE(estimate_mul(p, qpoly_t{q}).n_mults == est.n_mults);
+    est = estimate_mul(obake::pow(x + y, 4), obake::pow(z - t + 1, 3));
+    REQUIRE(est.n_mults == 5 * 10);
+    REQUIRE(est.n_terms > 0);
+
+    // Dynamic monomials.
+    auto [a, b] = make_polynomials<dpoly_t>("a", "b");
+    est = estimate_mul(obake::pow(a + b + 1, 5), obake::pow(a - b, 3));
+    REQUIRE(est.n_mults == 21 * 4);
+
+    // Truncation.
+    est = estimate_mul(p, q, 4);
+    REQUIRE(est.n_mults > 0);
+    REQUIRE(est.n_mults < p.size() * q.size());
+    est = estimate_mul(p, q, -1);
+    REQUIRE(est.n_terms == 0);
+    REQUIRE(est.n_bytes == 0);
+    REQUIRE(est.n_mults == 0);
+    est = estimate_mul(p, q, 3, symbol_set{"x", "y"});
+    REQUIRE(est.n_mults > 0);
+    REQUIRE(est.n_mults < p.size() * q.size());
+    est = estimate_mul(p, q, -1, symbol_set{"x"});
+    REQUIRE(est.n_mults == 0);
+
+    // Views.
+    const std::string filename = "estimate_mul_test.bin";
+    native_save(filename, q);
+    const view_t v(filename);
+    REQUIRE(estimate_mul(p, v).n_mults == p.size() * q.size());
+    REQUIRE(estimate_mul(v, v).n_mults == q.size() * q.size());
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("memory_budget")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+
+    REQUIRE(get_memory_budget() == 0u);
+
+    {
+        memory_budget_guard g(100);
+        REQUIRE(get_memory_budget() == 100u);
+
+        {
+            memory_budget_guard g2(0);
+            REQUIRE(get_memory_budget() == 0u);
+        }
+
+        REQUIRE(get_memory_budget() == 100u);
+    }
+
+    REQUIRE(get_memory_budget() == 0u);
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    const auto p = obake::pow(x + y + 2 * z + t + 1, 10);
+    const auto q = obake::pow(x - y - z + 3 * t - 1, 10);
+    const auto cmp = p * q;
+
+    if (detail::hc() > 1u && byte_size(p) >= 30000u) {
+        // The multi-threaded implementation fails early
+        // if the product does not fit in the budget.
+        {
+            memory_budget_guard g(1024);
+            OBAKE_REQUIRES_THROWS_CONTAINS(p * q, std::length_error, "exceeds the memory budget (1024 bytes)");
+        }
+
+        // A budget large enough does not prevent the multiplication.
+        {
+            memory_budget_guard g(static_cast<std::size_t>(estimate_mul(p, q).n_bytes) * 2u);
+            REQUIRE(p * q == cmp);
+        }
+    }
+
+    // Small multiplications are not affected.
+    {
+        memory_budget_guard g(1);
+        REQUIRE((x + y) * (x - y) == x * x - y * y);
+    }
+
+    REQUIRE(get_memory_budget() == 0u);
+}
+
+TEST_CASE("shrink_to_fit")
+{
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+
+    auto [x, y, z] = make_polynomials<poly_t>("x", "y", "z");
+
+    auto p = obake::pow(x + y + z + 1, 10);
+    const auto cap = p._get_s_table()[0].capacity();
+    REQUIRE(cap > 0u);
+
+    // Remove most of the terms.
+    auto s = poly_t{p};
+    std::vector<pm_t> keys;
+    for (const auto &term : p) {
+        keys.push_back(term.first);
+    }
+    keys.resize(keys.size() - 3u);
+    for (const auto &k : keys) {
+        p._get_s_table()[0].erase(k);
+    }
+    REQUIRE(p.size() == 3u);
+    REQUIRE(p._get_s_table()[0].capacity() == cap);
+
+    p.shrink_to_fit();
+    REQUIRE(p.size() == 3u);
+    REQUIRE(p._get_s_table()[0].capacity() < cap);
+    for (const auto &term : p) {
+        REQUIRE(s.find(term.first) != s.end());
+    }
+
+    // Empty series.
+    poly_t e;
+    e.shrink_to_fit();
+    REQUIRE(e.empty());
+
+    // Segmented series.
+    s.set_n_segments(2);
+    s.shrink_to_fit();
+    REQUIRE(s.empty());
+    REQUIRE(s.get_s_size() == 2u);
+}
@@ -9,12 +9,14 @@
 #include <algorithm>
 #include <exception>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/lexical_cast.hpp>
@@ -29,7 +31,9 @@
 
 #include <obake/config.hpp>
 #include <obake/detail/tuple_for_each.hpp>
+#include <obake/hash.hpp>
 #include <obake/polynomials/packed_monomial.hpp>
+#include <obake/ranges.hpp>
 #include <obake/series.hpp>
 #include <obake/symbols.hpp>
 #include <obake/type_traits.hpp>
@@ -1443,3 +1447,146 @@ TEST_CASE("series_iterators")
     REQUIRE(is_mutable_forward_iterator_v<s1_t::iterator>);
     REQUIRE(is_forward_iterator_v<s1_t::const_iterator>);
 }
+
+// Check that all the terms of the segmented series s
+// are stored in the expected table.
+template <typename S>
+inline bool check_segments(const S &s)
+{
+    const auto &tables = s._get_s_table();
+
+    for (decltype(tables.size()) i = 0; i < tables.size(); ++i) {
+        for (const auto &t : tables[i]) {
+            if ((hash(t.first) & (tables.size() - 1u)) != i) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// A single-pass range whose iterators yield
+// references to an internal buffer.
+template <typename T>
+struct input_terms_range {
+    std::istream_iterator<T> begin() const;
+    std::istream_iterator<T> end() const;
+};
+
+TEST_CASE("series_add_terms")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<int>;
+    using s1_t = series<pm_t, rat_t, void>;
+
+    // Type checks.
+    REQUIRE(detail::series_add_terms_enabled<std::vector<std::pair<pm_t, int>> &, pm_t, rat_t>);
+    REQUIRE(detail::series_add_terms_enabled<const std::vector<std::pair<pm_t, rat_t>> &, pm_t, rat_t>);
+    REQUIRE(detail::series_add_terms_enabled<std::vector<std::tuple<pm_t, int_t>> &&, pm_t, rat_t>);
+    REQUIRE(detail::series_add_terms_enabled<const s1_t &, pm_t, rat_t>);
+    REQUIRE(!detail::series_add_terms_enabled<std::vector<std::pair<int, int>> &, pm_t, rat_t>);
+    REQUIRE(!detail::series_add_terms_enabled<std::vector<std::pair<pm_t, std::vector<int>>> &, pm_t, rat_t>);
+    REQUIRE(!detail::series_add_terms_enabled<std::vector<int> &, pm_t, rat_t>);
+    REQUIRE(!detail::series_add_terms_enabled<int, pm_t, rat_t>);
+    REQUIRE(is_input_range_v<input_terms_range<std::pair<pm_t, int>> &>);
+    REQUIRE(!detail::series_add_terms_enabled<input_terms_range<std::pair<pm_t, int>> &, pm_t, rat_t>);
+    REQUIRE(detail::series_add_terms_move<std::vector<std::pair<pm_t, int>> &&>);
+    REQUIRE(!detail::series_add_terms_move<std::vector<std::pair<pm_t, int>> &>);
+    REQUIRE(!detail::series_add_terms_move<const std::vector<std::pair<pm_t, int>> &&>);
+
+    const symbol_set ss{"x", "y", "z"};
+
+    // Generate the terms, including duplicates
+    // and zero coefficients.
+    std::vector<std::pair<pm_t, int_t>> v, u;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            for (int k = 0; k < 10; ++k) {
+                u.emplace_back(pm_t{i, j, k}, int_t{i - j + 2 * k + 1});
+
+                v.emplace_back(pm_t{i, j, k}, int_t{i + j - k});
+                if ((i + j + k) % 3 == 0) {
+                    v.emplace_back(pm_t{i, j, k}, int_t{k - i - j});
+                }
+            }
+        }
+    }
+    v.emplace_back(pm_t{1, 1, 1}, int_t{0});
+
+    // Reference results via add_term().
+    s1_t v_ref, u_ref;
+    v_ref.set_symbol_set(ss);
+    u_ref.set_symbol_set(ss);
+    for (const auto &p : v) {
+        v_ref.add_term(p.first, p.second);
+    }
+    for (const auto &p : u) {
+        u_ref.add_term(p.first, p.second);
+    }
+
+    for (auto l : {0u, 1u, 3u, 5u}) {
+        s1_t s;
+        s.set_symbol_set(ss);
+        s.set_n_segments(l);
+
+        // Empty range.
+        s.add_terms(std::vector<std::pair<pm_t, int_t>>{});
+        REQUIRE(s.empty());
+
+        // Duplicates and cancellations.
+        s.add_terms(v);
+        REQUIRE(s == v_ref);
+        REQUIRE(s.get_s_size() == l);
+        REQUIRE(check_segments(s));
+
+        // Subtraction.
+        s.template add_terms<false>(v);
+        REQUIRE(s.empty());
+        s.template add_terms<false>(v);
+        REQUIRE(s == -v_ref);
+        s.clear_terms();
+
+        // Assume unique.
+        s.add_terms(u, add_terms_mode::assume_unique);
+        REQUIRE(s == u_ref);
+        REQUIRE(check_segments(s));
+
+        // Accumulation into a non-empty series.
+        s.add_terms(v);
+        REQUIRE(s == u_ref + v_ref);
+        REQUIRE(check_segments(s));
+
+        // Insertion from a series, with a different segmentation.
+        s1_t s2;
+        s2.set_symbol_set(ss);
+        s2.set_n_segments(2);
+        s2.add_terms(s);
+        REQUIRE(s2 == s);
+        REQUIRE(check_segments(s2));
+
+        // Moving from the range.
+        auto v_copy(v);
+        s.clear_terms();
+        s.add_terms(std::move(v_copy));
+        REQUIRE(s == v_ref);
+
+        // Tuples, with conversion of the coefficients.
+        std::vector<std::tuple<pm_t, int>> w{{pm_t{1, 2, 3}, 1}, {pm_t{4, 5, 6}, -2}, {pm_t{1, 2, 3}, 3}};
+        s.clear_terms();
+        s.add_terms(w, add_terms_mode::checked);
+        REQUIRE(s.size() == 2u);
+        REQUIRE(s.find(pm_t{1, 2, 3})->second == 4);
+        REQUIRE(s.find(pm_t{4, 5, 6})->second == -2);
+    }
+
+    // Incompatible keys: nothing is inserted.
+    s1_t s3;
+    s3.set_symbol_set(symbol_set{});
+    s3.set_n_segments(2);
+    std::vector<std::pair<pm_t, int>> bad{{pm_t(0), 1}, {pm_t(1), 2}};
+    OBAKE_REQUIRES_THROWS_CONTAINS(s3.add_terms(bad), std::invalid_argument,
+                                   "not compatible with the series' symbol set");
+    REQUIRE(s3.empty());
+}
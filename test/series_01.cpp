@@ -1334,6 +1334,99 @@ TEST_CASE("series_sub")
     }
 }
 
+// Check that binary add/sub re-use the storage of
+// the largest mutable rvalue operand.
+TEST_CASE("series_addsub_rvalue_accumulator")
+{
+    using pm_t = packed_monomial<int>;
+    using s1_t = series<pm_t, rat_t, void>;
+
+    // Helper to build a series in {x, y} with n terms,
+    // n_segs segments and coefficients multiplied by m.
+    auto make_s = [](int n, unsigned n_segs, int m) {
+        s1_t retval;
+        retval.set_symbol_set(symbol_set{"x", "y"});
+        retval.set_n_segments(n_segs);
+        for (int i = 0; i < n; ++i) {
+            retval.add_term(pm_t{i, i % 3}, rat_t{m * (i + 1), 3});
+        }
+        return retval;
+    };
+
+    const auto big = make_s(100, 2, 1), small = make_s(10, 0, 2);
+
+    // Reference results.
+    s1_t sum_ref, diff_ref;
+    sum_ref.set_symbol_set(symbol_set{"x", "y"});
+    diff_ref.set_symbol_set(symbol_set{"x", "y"});
+    for (int i = 0; i < 100; ++i) {
+        const auto f = i < 10 ? 3 : 1;
+        sum_ref.add_term(pm_t{i, i % 3}, rat_t{f * (i + 1), 3});
+        if (i < 10) {
+            diff_ref.add_term(pm_t{i, i % 3}, rat_t{-(i + 1), 3});
+        } else {
+            diff_ref.add_term(pm_t{i, i % 3}, rat_t{i + 1, 3});
+        }
+    }
+
+    // Lvalues: the larger operand is the accumulator.
+    auto res = small + big;
+    REQUIRE(res == sum_ref);
+    REQUIRE(res.get_s_size() == 2u);
+    res = big - small;
+    REQUIRE(res == diff_ref);
+    REQUIRE(res.get_s_size() == 2u);
+    res = small - big;
+    REQUIRE(res == -diff_ref);
+    REQUIRE(res.get_s_size() == 2u);
+
+    // A much smaller rvalue is not used as accumulator
+    // for a large lvalue.
+    res = big + make_s(10, 0, 2);
+    REQUIRE(res == sum_ref);
+    REQUIRE(res.get_s_size() == 2u);
+    res = make_s(10, 0, 2) - big;
+    REQUIRE(res == -diff_ref);
+    REQUIRE(res.get_s_size() == 2u);
+    res = big - make_s(10, 0, 2);
+    REQUIRE(res == diff_ref);
+    REQUIRE(res.get_s_size() == 2u);
+
+    // An rvalue of comparable size is preferred over a larger
+    // lvalue, and it adopts the segmentation of the lvalue.
+    {
+        s1_t mid_sum_ref, mid_diff_ref;
+        mid_sum_ref.set_symbol_set(symbol_set{"x", "y"});
+        mid_diff_ref.set_symbol_set(symbol_set{"x", "y"});
+        for (int i = 0; i < 100; ++i) {
+            const auto f = i < 60 ? 3 : 1;
+            mid_sum_ref.add_term(pm_t{i, i % 3}, rat_t{f * (i + 1), 3});
+            mid_diff_ref.add_term(pm_t{i, i % 3}, rat_t{(i < 60 ? -1 : 1) * (i + 1), 3});
+        }
+
+        res = big + make_s(60, 0, 2);
+        REQUIRE(res == mid_sum_ref);
+        REQUIRE(res.get_s_size() == 2u);
+
+        res = make_s(60, 0, 2) - big;
+        REQUIRE(res == -mid_diff_ref);
+        REQUIRE(res.get_s_size() == 2u);
+    }
+
+    // Two rvalues: the larger is the accumulator.
+    res = make_s(10, 0, 2) + make_s(100, 2, 1);
+    REQUIRE(res == sum_ref);
+    REQUIRE(res.get_s_size() == 2u);
+    res = make_s(10, 0, 2) - make_s(100, 2, 1);
+    REQUIRE(res == -diff_ref);
+    REQUIRE(res.get_s_size() == 2u);
+
+    // Chained sums accumulate into the first temporary.
+    res = big + small + small - big + big;
+    REQUIRE(res == sum_ref + small);
+    REQUIRE(res.get_s_size() == 2u);
+}
+
 namespace ns
 {
 
@@ -6,6 +6,7 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <random>
@@ -14,8 +15,13 @@
 #include <utility>
 #include <vector>
 
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
 #include <mp++/rational.hpp>
 
+#include <obake/hash.hpp>
+#include <obake/math/negate.hpp>
+#include <obake/math/pow.hpp>
 #include <obake/polynomials/packed_monomial.hpp>
 #include <obake/polynomials/polynomial.hpp>
 #include <obake/series.hpp>
@@ -29,6 +35,8 @@ using rat_t = mppp::rational<1>;
 
 using namespace obake;
 
+using obake_test::segmented_copy;
+
 std::mt19937 rng;
 
 const auto ntrials = 200;
@@ -576,6 +584,266 @@ TEST_CASE("series_in_place_add_sub")
     }
 }
 
+// Check that all the terms of the segmented series s
+// are stored in the expected table.
+template <typename S>
+inline bool check_segments(const S &s)
+{
+    const auto &tables = s._get_s_table();
+
+    for (decltype(tables.size()) i = 0; i < tables.size(); ++i) {
+        for (const auto &t : tables[i]) {
+            if ((hash(t.first) & (tables.size() - 1u)) != i) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+TEST_CASE("series_segmented_in_place_add_sub")
+{
+    using pm_t = packed_monomial<int>;
+    using s1_t = polynomial<pm_t, rat_t>;
+
+    auto [x, y, z] = make_polynomials<s1_t>("x", "y", "z");
+
+    const auto a = obake::pow(x - 2 * y + 3 * z + 1, 8);
+    const auto b = obake::pow(x + y - z - 2, 7);
+
+    for (auto la : {0u, 1u, 3u}) {
+        for (auto lb : {0u, 1u, 2u, 3u, 5u}) {
+            const auto as = segmented_copy(a, la);
+            const auto bs = segmented_copy(b, lb);
+
+            // Addition, with const and rvalue rhs.
+            auto c = as;
+            c += bs;
+            REQUIRE(c == a + b);
+            REQUIRE(c.get_s_size() == la);
+            REQUIRE(check_segments(c));
+
+            c = as;
+            auto bs_copy(bs);
+            c += std::move(bs_copy);
+            REQUIRE(c == a + b);
+            REQUIRE(c.get_s_size() == la);
+            REQUIRE(check_segments(c));
+            REQUIRE(bs_copy.empty());
+
+            // Subtraction.
+            c = as;
+            c -= bs;
+            REQUIRE(c == a - b);
+            REQUIRE(c.get_s_size() == la);
+            REQUIRE(check_segments(c));
+
+            c = as;
+            bs_copy = bs;
+            c -= std::move(bs_copy);
+            REQUIRE(c == a - b);
+            REQUIRE(check_segments(c));
+
+            // Complete cancellation.
+            c = as;
+            c -= segmented_copy(a, lb);
+            REQUIRE(c.empty());
+            REQUIRE(c.get_s_size() == la);
+
+            // Partial cancellation.
+            c = as;
+            c += segmented_copy(b - a + x, lb);
+            REQUIRE(c == b + x);
+            REQUIRE(check_segments(c));
+
+            // Binary operators.
+            REQUIRE(as + bs == a + b);
+            REQUIRE(as - bs == a - b);
+            REQUIRE(check_segments(as + bs));
+            REQUIRE(check_segments(as - bs));
+        }
+    }
+}
+
+TEST_CASE("series_segmented_comparison_content_hash")
+{
+    using pm_t = packed_monomial<int>;
+    using s1_t = polynomial<pm_t, rat_t>;
+    using s2_t = polynomial<pm_t, mppp::integer<1>>;
+
+    auto [x, y, z] = make_polynomials<s1_t>("x", "y", "z");
+
+    const auto a = obake::pow(x - 2 * y + 3 * z + 1, 8);
+
+    // Content hash of empty series.
+    REQUIRE(s1_t{}.content_hash() == 0u);
+    REQUIRE(segmented_copy(s1_t{}, 3).content_hash() == 0u);
+
+    for (auto l0 : {0u, 1u, 4u}) {
+        const auto as = segmented_copy(a, l0);
+
+        // The content hash does not depend on the segmentation.
+        REQUIRE(as.content_hash() == a.content_hash());
+
+        for (auto l1 : {0u, 2u, 4u}) {
+            auto bs = segmented_copy(a, l1);
+
+            REQUIRE(as == bs);
+            REQUIRE(bs == as);
+
+            // Comparison with a different coefficient type.
+            REQUIRE(as == segmented_copy(s2_t(a * 5), l1) / 5);
+
+            // Change a coefficient: same content hash,
+            // but different series.
+            auto cs = bs;
+            cs.add_term(pm_t{0, 0, 0}, 1);
+            REQUIRE(cs.content_hash() == bs.content_hash());
+            REQUIRE(as != cs);
+            REQUIRE(cs != as);
+
+            // Add a term: the content hash changes.
+            cs = bs;
+            const auto old_hash = cs.content_hash();
+            cs.add_term(pm_t{10, 10, 10}, 1);
+            REQUIRE(cs.content_hash() != old_hash);
+            REQUIRE(cs.content_hash() == segmented_copy(cs, 1).content_hash());
+            REQUIRE(as != cs);
+            REQUIRE(cs != as);
+
+            // Remove a term.
+            cs = bs;
+            REQUIRE(cs.content_hash() == old_hash);
+            filter(cs, [](const auto &t) { return t.first != pm_t{1, 2, 1}; });
+            REQUIRE(cs.size() + 1u == bs.size());
+            REQUIRE(cs.content_hash() != old_hash);
+            REQUIRE(as != cs);
+
+            // Copy/move.
+            auto ds(bs);
+            REQUIRE(ds.content_hash() == old_hash);
+            auto es(std::move(ds));
+            REQUIRE(es.content_hash() == old_hash);
+            ds = std::move(es);
+            REQUIRE(ds.content_hash() == old_hash);
+            swap(ds, cs);
+            REQUIRE(cs.content_hash() == old_hash);
+            REQUIRE(ds.content_hash() != old_hash);
+
+            // Clearing.
+            cs.clear_terms();
+            REQUIRE(cs.content_hash() == 0u);
+
+            // Mutation through a reference to the internal
+            // table acquired before computing the content hash.
+            cs = bs;
+            auto &tab = cs._get_s_table();
+            REQUIRE(cs.content_hash() == old_hash);
+            REQUIRE(cs == bs);
+            const pm_t new_k{10, 10, 10};
+            auto &dest = tab[static_cast<std::size_t>(obake::hash(new_k) & (tab.size() - 1u))];
+            dest.try_emplace(new_k, 1);
+            REQUIRE(cs.content_hash() != old_hash);
+            REQUIRE(cs != bs);
+            REQUIRE(bs != cs);
+            dest.erase(new_k);
+            REQUIRE(cs.content_hash() == old_hash);
+            REQUIRE(cs == bs);
+        }
+    }
+}
+
+TEST_CASE("series_segmented_scalar_mul_div_negate")
+{
+    using pm_t = packed_monomial<int>;
+    using s1_t = polynomial<pm_t, rat_t>;
+    using s2_t = polynomial<pm_t, mppp::integer<1>>;
+
+    // The in-place operators do not go through the binary ones.
+    REQUIRE(detail::series_in_place_scalar_mul_enabled<s1_t &, int &&>());
+    REQUIRE(detail::series_in_place_scalar_mul_enabled<s1_t &&, const rat_t &>());
+    REQUIRE(!detail::series_in_place_scalar_mul_enabled<const s1_t &, int>());
+    REQUIRE(!detail::series_in_place_scalar_mul_enabled<s1_t &, s1_t>());
+    REQUIRE(!detail::series_in_place_scalar_mul_enabled<s2_t &, rat_t>());
+    REQUIRE(detail::series_in_place_scalar_div_enabled<s1_t &, int>());
+    REQUIRE(!detail::series_in_place_scalar_div_enabled<const s1_t &, int>());
+    REQUIRE(!detail::series_in_place_scalar_div_enabled<s2_t &, rat_t>());
+
+    auto [x, y, z] = make_polynomials<s1_t>("x", "y", "z");
+    auto [xi, yi] = make_polynomials<s2_t>("x", "y");
+
+    const auto a = obake::pow(x - 2 * y + 3 * z + 1, 8);
+    const auto b = obake::pow(xi + 2 * yi + 1, 6);
+
+    for (auto l : {0u, 1u, 4u}) {
+        const auto as = segmented_copy(a, l);
+        const auto bs = segmented_copy(b, l);
+
+        // Binary operators.
+        auto c = as * rat_t{3, 4};
+        REQUIRE(c == a * rat_t{3, 4});
+        REQUIRE(c.get_s_size() == l);
+        REQUIRE(check_segments(c));
+        REQUIRE(rat_t{3, 4} * as == c);
+        REQUIRE(as / 7 == a / 7);
+        REQUIRE((as * 0).empty());
+
+        // Negation.
+        c = -as;
+        REQUIRE(c == -a);
+        REQUIRE(c.get_s_size() == l);
+        REQUIRE(check_segments(c));
+        obake::negate(c);
+        REQUIRE(c == a);
+
+        // In-place operators.
+        c = as;
+        c *= rat_t{-2, 3};
+        REQUIRE(c == a * rat_t{-2, 3});
+        REQUIRE(c.get_s_size() == l);
+        REQUIRE(check_segments(c));
+        c /= rat_t{-2, 3};
+        REQUIRE(c == a);
+        REQUIRE(c.get_s_size() == l);
+        std::move(c) *= 2;
+        REQUIRE(c == 2 * a);
+        c *= 0;
+        REQUIRE(c.empty());
+
+        // Terms becoming zero are removed.
+        auto d = bs;
+        d /= 4;
+        REQUIRE(d == b / 4);
+        REQUIRE(check_segments(d));
+        for (const auto &t : d) {
+            REQUIRE(t.second != 0);
+        }
+        REQUIRE(bs / 4 == d);
+
+        // Division by zero.
+        d = bs;
+        OBAKE_REQUIRES_THROWS_CONTAINS(d /= 0, mppp::zero_division_error, "");
+
+        // The scalar is one of the coefficients of the series.
+        for (const auto &e : {s1_t(2 * x + 4 * y + 6 * z), a}) {
+            c = segmented_copy(e, l);
+            auto cf = c.cbegin()->second;
+            c /= c.cbegin()->second;
+            REQUIRE(c == e / cf);
+            REQUIRE(c.get_s_size() == l);
+            REQUIRE(check_segments(c));
+
+            c = segmented_copy(e, l);
+            cf = c.cbegin()->second;
+            c *= c.cbegin()->second;
+            REQUIRE(c == e * cf);
+            REQUIRE(c.get_s_size() == l);
+            REQUIRE(check_segments(c));
+        }
+    }
+}
+
 struct foo {
 };
 
@@ -10,11 +10,13 @@
 #include <initializer_list>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 #include <mp++/integer.hpp>
 #include <mp++/rational.hpp>
 
 #include <obake/detail/ignore.hpp>
+#include <obake/hash.hpp>
 #include <obake/math/evaluate.hpp>
 #include <obake/math/pow.hpp>
 #include <obake/math/trim.hpp>
@@ -229,3 +231,99 @@ TEST_CASE("series_trim_test")
     REQUIRE(trim(p5).get_symbol_set() != p5.get_symbol_set());
     REQUIRE(trim(p5).get_symbol_set() == symbol_set{});
 }
+
+// Check that all the terms of the segmented series s
+// are stored in the expected table.
+template <typename S>
+inline bool check_segments(const S &s)
+{
+    const auto &tables = s._get_s_table();
+
+    for (decltype(tables.size()) i = 0; i < tables.size(); ++i) {
+        for (const auto &t : tables[i]) {
+            if ((hash(t.first) & (tables.size() - 1u)) != i) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+TEST_CASE("series_segmented_trim_test")
+{
+    using pm_t = packed_monomial<int>;
+    using p1_t = polynomial<pm_t, rat_t>;
+    using p2_t = polynomial<pm_t, p1_t>;
+
+    auto [x, y, z, t] = make_polynomials<p1_t>("x", "y", "z", "t");
+
+    for (auto l : {1u, 2u, 5u}) {
+        // Nothing to trim.
+        auto p1 = obake::pow(x - 2 * y + 3 * z - t + 1, 6);
+        p1_t p1s;
+        p1s.set_symbol_set(p1.get_symbol_set());
+        p1s.set_n_segments(l);
+        for (const auto &term : p1) {
+            p1s.add_term(term.first, term.second);
+        }
+
+        auto tr = trim(p1s);
+        REQUIRE(tr == p1);
+        REQUIRE(tr.get_symbol_set() == p1.get_symbol_set());
+        REQUIRE(tr.get_s_size() == l);
+        REQUIRE(check_segments(tr));
+
+        // Move semantics.
+        auto p1s_copy(p1s);
+        tr = trim(std::move(p1s_copy));
+        REQUIRE(tr == p1);
+        REQUIRE(tr.get_s_size() == l);
+        REQUIRE(check_segments(tr));
+
+        // Trimming of z and t.
+        auto p3 = obake::pow(x - 2 * y + 1, 8) + z * t - t * z;
+        REQUIRE(p3.get_symbol_set() == symbol_set{"x", "y", "z", "t"});
+        p1_t p3s;
+        p3s.set_symbol_set(p3.get_symbol_set());
+        p3s.set_n_segments(l);
+        for (const auto &term : p3) {
+            p3s.add_term(term.first, term.second);
+        }
+
+        tr = trim(p3s);
+        REQUIRE(tr == obake::pow(x - 2 * y + 1, 8));
+        REQUIRE(tr.get_symbol_set() == symbol_set{"x", "y"});
+        REQUIRE(tr.size() == trim(p3).size());
+        REQUIRE(tr.get_s_size() == l);
+        REQUIRE(check_segments(tr));
+
+        // Empty series.
+        p1_t p5;
+        p5.set_symbol_set(symbol_set{"x", "y"});
+        p5.set_n_segments(l);
+        tr = trim(p5);
+        REQUIRE(tr.empty());
+        REQUIRE(tr.get_symbol_set() == symbol_set{});
+        REQUIRE(tr.get_s_size() == l);
+
+        // Trimming of the coefficients, with nothing
+        // to trim in the keys.
+        auto [a, b] = make_polynomials<p2_t>("a", "b");
+        auto p6 = obake::pow(a + b + p2_t{x + z - z}, 5);
+        p2_t p6s;
+        p6s.set_symbol_set(p6.get_symbol_set());
+        p6s.set_n_segments(l);
+        for (const auto &term : p6) {
+            p6s.add_term(term.first, term.second);
+        }
+
+        auto tr6 = trim(p6s);
+        REQUIRE(tr6 == p6);
+        REQUIRE(tr6.get_s_size() == l);
+        REQUIRE(check_segments(tr6));
+        for (const auto &term : tr6) {
+            REQUIRE(term.second.get_symbol_set().count("z") == 0u);
+        }
+    }
+}
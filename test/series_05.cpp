@@ -6,27 +6,40 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <ostream>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 
+#include <tbb/parallel_for.h>
+
 #include <mp++/integer.hpp>
 #include <mp++/rational.hpp>
 
+#include <obake/hash.hpp>
 #include <obake/key/key_degree.hpp>
 #include <obake/math/degree.hpp>
 #include <obake/math/pow.hpp>
 #include <obake/polynomials/packed_monomial.hpp>
 #include <obake/polynomials/polynomial.hpp>
 #include <obake/s11n.hpp>
+#include <obake/series.hpp>
 #include <obake/symbols.hpp>
 #include <obake/tex_stream_insert.hpp>
 #include <obake/type_traits.hpp>
 
 #include "catch.hpp"
+#include "test_utils.hpp"
 
 using int_t = mppp::integer<1>;
 using rat_t = mppp::rational<1>;
@@ -174,6 +187,33 @@ TEST_CASE("series_filter_test")
     REQUIRE(obake::degree(pf) == 3);
     REQUIRE(pf.get_symbol_set() == symbol_set{"x", "y", "z"});
 
+    // Segmented series.
+    for (auto l : {1u, 3u, 6u}) {
+        p1_t ps;
+        ps.set_symbol_set(p.get_symbol_set());
+        ps.set_n_segments(l);
+        for (const auto &t : p) {
+            ps.add_term(t.first, t.second);
+        }
+
+        pf = ps;
+        filter(pf, [&ss = p.get_symbol_set()](const auto &t) { return obake::key_degree(t.first, ss) <= 2; });
+        REQUIRE(obake::degree(pf) == 2);
+        REQUIRE(pf.get_s_size() == l);
+        auto cmp(p);
+        filter(cmp, [&ss = p.get_symbol_set()](const auto &t) { return obake::key_degree(t.first, ss) <= 2; });
+        REQUIRE(pf == cmp);
+
+        // The memory of the emptied tables is released.
+        pf = ps;
+        filter(pf, [](const auto &) { return false; });
+        REQUIRE(pf.empty());
+        REQUIRE(pf.get_s_size() == l);
+        for (const auto &tab : pf._get_s_table()) {
+            REQUIRE(tab.capacity() == 0u);
+        }
+    }
+
     REQUIRE(!is_detected_v<filter_t, void, void>);
     REQUIRE(!is_detected_v<filter_t, void, int>);
     REQUIRE(!is_detected_v<filter_t, int, void>);
@@ -320,3 +360,499 @@ TEST_CASE("series_table_stats_test")
 }
 
 #endif
+
+TEST_CASE("series_get_table_stats_test")
+{
+    using pm_t = packed_monomial<int>;
+    using p1_t = polynomial<pm_t, mppp::integer<1>>;
+
+    // Empty series.
+    auto st = p1_t{}.get_table_stats();
+    REQUIRE(st.n_terms == 0u);
+    REQUIRE(st.n_tables == 1u);
+    REQUIRE(st.tables.size() == 1u);
+    REQUIRE(st.load_factor == 0.);
+    REQUIRE(st.imbalance == 0.);
+    REQUIRE(st.occupancy_histogram[0] == 1u);
+    REQUIRE(!st.has_probe_lengths);
+    REQUIRE(boost::contains(st.to_json(), "\"n_terms\": 0"));
+    REQUIRE(!boost::contains(st.to_json(), "probe_length"));
+    REQUIRE(p1_t{}.get_table_stats(true).has_probe_lengths);
+
+    auto [x, y, z] = make_polynomials<p1_t>("x", "y", "z");
+
+    const auto p = obake::pow(x + y + z + 1, 10);
+
+    for (auto l : {0u, 3u}) {
+        p1_t q;
+        q.set_symbol_set(p.get_symbol_set());
+        q.set_n_segments(l);
+        for (const auto &t : p) {
+            q.add_term(t.first, t.second);
+        }
+
+        // The probe lengths are not computed by default.
+        st = q.get_table_stats();
+        REQUIRE(!st.has_probe_lengths);
+        REQUIRE(st.mean_probe_length == 0.);
+        REQUIRE(st.max_probe_length == 0u);
+        REQUIRE(!boost::contains(st.to_string(), "Mean/max probe length"));
+        REQUIRE(!boost::contains(st.to_json(), "probe_length"));
+        REQUIRE(st.to_string() == q.table_stats());
+
+        st = q.get_table_stats(true);
+        REQUIRE(st.has_probe_lengths);
+
+        REQUIRE(st.n_terms == q.size());
+        REQUIRE(st.n_tables == (1u << l));
+        REQUIRE(st.tables.size() == st.n_tables);
+        REQUIRE(st.total_bytes == byte_size(q));
+        REQUIRE(st.load_factor > 0.);
+        REQUIRE(st.load_factor <= 1.);
+        REQUIRE(st.mean_probe_length >= 0.);
+        REQUIRE(static_cast<double>(st.max_probe_length) >= st.mean_probe_length);
+        REQUIRE(st.imbalance >= 0.);
+        REQUIRE(st.min_terms <= st.max_terms);
+
+        std::size_t n = 0, cap = 0, nh = 0;
+        for (decltype(st.tables.size()) i = 0; i < st.tables.size(); ++i) {
+            const auto &ti = st.tables[i];
+            REQUIRE(ti.size == q._get_s_table()[i].size());
+            REQUIRE(ti.capacity == q._get_s_table()[i].capacity());
+            REQUIRE(ti.size >= st.min_terms);
+            REQUIRE(ti.size <= st.max_terms);
+            REQUIRE(ti.max_probe_length <= st.max_probe_length);
+            n += ti.size;
+            cap += ti.capacity;
+        }
+        for (auto h : st.occupancy_histogram) {
+            nh += h;
+        }
+        REQUIRE(n == st.n_terms);
+        REQUIRE(cap == st.total_capacity);
+        REQUIRE(nh == st.n_tables);
+        REQUIRE(st.slack_bytes == (cap - n) * sizeof(std::pair<const pm_t, mppp::integer<1>>));
+
+        if (l == 0u) {
+            REQUIRE(st.imbalance == 0.);
+        }
+
+        const auto str = st.to_string();
+        REQUIRE(boost::contains(str, "Average terms per table"));
+        REQUIRE(boost::contains(str, "Mean/max probe length"));
+        REQUIRE(boost::contains(str, "Imbalance coefficient"));
+        REQUIRE(boost::contains(str, "Load factor histogram") == (l != 0u));
+
+        const auto json = st.to_json();
+        REQUIRE(boost::starts_with(json, "{"));
+        REQUIRE(boost::ends_with(json, "]}"));
+        REQUIRE(boost::contains(json, "\"occupancy_histogram\": ["));
+        REQUIRE(boost::contains(json, "\"tables\": [{\"size\": "));
+        REQUIRE(boost::contains(json, "\"max_probe_length\": "));
+    }
+}
+
+// Check that all the terms of the segmented series s
+// are stored in the expected table.
+template <typename S>
+inline bool check_segments(const S &s)
+{
+    const auto &tables = s._get_s_table();
+
+    for (decltype(tables.size()) i = 0; i < tables.size(); ++i) {
+        for (const auto &t : tables[i]) {
+            if ((hash(t.first) & (tables.size() - 1u)) != i) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// RAII helper to restore the global
+// segmentation policy.
+struct seg_policy_restorer {
+    seg_policy_restorer() : m_orig(get_series_segmentation_policy()) {}
+    ~seg_policy_restorer()
+    {
+        set_series_segmentation_policy(m_orig);
+    }
+    series_segmentation_policy m_orig;
+};
+
+TEST_CASE("series_auto_segment_test")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<int>;
+    using poly_t = polynomial<pm_t, int_t>;
+
+    seg_policy_restorer spr;
+
+    // The default policy.
+    REQUIRE(!get_series_segmentation_policy().enabled);
+    REQUIRE(get_series_segmentation_policy().segment_bytes == series_segmentation_policy{}.segment_bytes);
+    REQUIRE(get_series_segmentation_policy().max_log2_size == series_segmentation_policy{}.max_log2_size);
+
+    OBAKE_REQUIRES_THROWS_CONTAINS(set_series_segmentation_policy(series_segmentation_policy{true, 0, 4}),
+                                   std::invalid_argument,
+                                   "The target segment size in a series segmentation policy must be nonzero");
+    REQUIRE(!get_series_segmentation_policy().enabled);
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    const auto p = obake::pow(x + y + z + t + 1, 10);
+
+    // Explicit re-segmentation.
+    auto q = p;
+    for (auto l : {1u, 3u, 6u, 4u, 0u, 2u}) {
+        q.resegment(l);
+
+        REQUIRE(q.get_s_size() == l);
+        REQUIRE(q._get_s_table().size() == 1u << l);
+        REQUIRE(q.size() == p.size());
+        REQUIRE(q == p);
+        REQUIRE(check_segments(q));
+    }
+    REQUIRE(q.content_hash() == p.content_hash());
+
+    OBAKE_REQUIRES_THROWS_CONTAINS(q.resegment(poly_t::get_max_s_size() + 1u), std::invalid_argument,
+                                   "Cannot re-segment a series into 2**");
+    REQUIRE(q == p);
+
+    poly_t e;
+    e.resegment(3);
+    REQUIRE(e.empty());
+    REQUIRE(e.get_s_size() == 3u);
+
+    // Explicit application of a policy (the enabled
+    // flag is ignored).
+    const auto n = static_cast<std::size_t>(p.size());
+    const auto tb = sizeof(poly_t::table_type::value_type) + 1u;
+
+    q = p;
+    q.auto_segment(series_segmentation_policy{false, tb * 16u, 10});
+    REQUIRE(q.get_s_size() > 0u);
+    REQUIRE((n >> q.get_s_size()) <= 8u);
+    REQUIRE(q == p);
+    REQUIRE(check_segments(q));
+
+    // The maximum number of segments is respected.
+    q.resegment(0);
+    q.auto_segment(series_segmentation_policy{false, tb, 2});
+    REQUIRE(q.get_s_size() == 2u);
+    REQUIRE(q == p);
+    REQUIRE(check_segments(q));
+
+    // Shrinking.
+    q.auto_segment(series_segmentation_policy{false, tb * n * 8u, 10});
+    REQUIRE(q.get_s_size() == 0u);
+    REQUIRE(q == p);
+
+    // With the default policy, no re-segmentation is
+    // needed for small series.
+    q.auto_segment();
+    REQUIRE(q.get_s_size() == 0u);
+
+    // Enable the automatic re-segmentation.
+    set_series_segmentation_policy(series_segmentation_policy{true, tb * 16u, 5});
+    REQUIRE(get_series_segmentation_policy().enabled);
+    REQUIRE(get_series_segmentation_policy().segment_bytes == tb * 16u);
+    REQUIRE(get_series_segmentation_policy().max_log2_size == 5u);
+
+    // Growth via add_term().
+    poly_t r;
+    r.set_symbol_set(p.get_symbol_set());
+    for (const auto &term : p) {
+        r.add_term(term.first, term.second);
+
+        REQUIRE(check_segments(r));
+    }
+    REQUIRE(r.get_s_size() == 5u);
+    REQUIRE(r == p);
+
+    // Growth via addition.
+    poly_t s{x};
+    REQUIRE(s.get_s_size() == 0u);
+    s += p;
+    REQUIRE(s.get_s_size() == 5u);
+    REQUIRE(check_segments(s));
+    REQUIRE(s == p + x);
+    REQUIRE((x + p).get_s_size() == 5u);
+
+    // Shrinking after large deletions.
+    filter(s, [&ss = p.get_symbol_set()](const auto &term) { return obake::key_degree(term.first, ss) <= 1; });
+    REQUIRE(s.size() == 5u);
+    REQUIRE(s.get_s_size() == 0u);
+    REQUIRE(s == 10 * (x + y + z + t) + 1 + x);
+
+    r -= p;
+    REQUIRE(r.empty());
+    REQUIRE(r.get_s_size() == 0u);
+
+    // Segmentations set explicitly beyond
+    // the policy maximum are not increased further.
+    auto u = p;
+    u.resegment(7);
+    u += x;
+    REQUIRE(u.get_s_size() == 7u);
+    REQUIRE(check_segments(u));
+
+    // Disable the policy.
+    set_series_segmentation_policy(series_segmentation_policy{});
+    poly_t v;
+    v.set_symbol_set(p.get_symbol_set());
+    for (const auto &term : p) {
+        v.add_term(term.first, term.second);
+    }
+    REQUIRE(v.get_s_size() == 0u);
+}
+
+// A coefficient type whose copy constructor throws on
+// demand, and whose move constructor is not noexcept
+// (so that re-segmentation copies the coefficients).
+std::atomic<int> throwing_cf_countdown(-1);
+
+struct throwing_cf {
+    throwing_cf() = default;
+    throwing_cf(int n) : value(n) {}
+    throwing_cf(const throwing_cf &other) : value(other.value)
+    {
+        if (throwing_cf_countdown.load() == 0) {
+            throw std::runtime_error("throwing_cf copy");
+        }
+        if (throwing_cf_countdown.load() > 0) {
+            --throwing_cf_countdown;
+        }
+    }
+    throwing_cf(throwing_cf &&other) noexcept(false) : value(other.value) {}
+    throwing_cf &operator=(const throwing_cf &) = default;
+    throwing_cf &operator=(throwing_cf &&) = default;
+    ~throwing_cf() = default;
+
+    throwing_cf &operator+=(const throwing_cf &other)
+    {
+        value += other.value;
+        return *this;
+    }
+    throwing_cf &operator-=(const throwing_cf &other)
+    {
+        value -= other.value;
+        return *this;
+    }
+    throwing_cf operator-() const
+    {
+        return throwing_cf{-value};
+    }
+    friend bool operator==(const throwing_cf &a, const throwing_cf &b)
+    {
+        return a.value == b.value;
+    }
+    friend bool operator!=(const throwing_cf &a, const throwing_cf &b)
+    {
+        return a.value != b.value;
+    }
+    friend std::ostream &operator<<(std::ostream &os, const throwing_cf &c)
+    {
+        return os << c.value;
+    }
+
+    int value = 0;
+};
+
+TEST_CASE("series_resegment_exception_safety")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<int>;
+    using s_t = series<pm_t, throwing_cf, void>;
+
+    REQUIRE(is_cf_v<throwing_cf>);
+    REQUIRE(!std::is_nothrow_move_constructible_v<throwing_cf>);
+
+    seg_policy_restorer spr;
+
+    s_t s;
+    s.set_symbol_set(symbol_set{"x", "y"});
+    for (int i = 0; i < 100; ++i) {
+        s.add_term(pm_t{i, 1}, throwing_cf{i + 1});
+    }
+    const auto orig = s;
+
+    // Explicit re-segmentation, upwards and downwards.
+    for (auto l : {3u, 0u}) {
+        throwing_cf_countdown.store(50);
+        OBAKE_REQUIRES_THROWS_CONTAINS(s.resegment(l), std::runtime_error, "throwing_cf copy");
+        throwing_cf_countdown.store(-1);
+        REQUIRE(s == orig);
+        REQUIRE(check_segments(s));
+
+        s.resegment(l);
+        REQUIRE(s.get_s_size() == l);
+        REQUIRE(s == orig);
+        REQUIRE(check_segments(s));
+    }
+
+    // Implicit re-segmentation triggered by the policy.
+    s.resegment(0);
+    set_series_segmentation_policy(
+        series_segmentation_policy{true, sizeof(s_t::table_type::value_type) + 1u, 5});
+    throwing_cf_countdown.store(10);
+    OBAKE_REQUIRES_THROWS_CONTAINS(s.add_term(pm_t{100, 1}, throwing_cf{101}), std::runtime_error,
+                                   "throwing_cf copy");
+    throwing_cf_countdown.store(-1);
+    REQUIRE(s.size() == orig.size() + 1u);
+    REQUIRE(s.get_s_size() == 0u);
+    REQUIRE(check_segments(s));
+    for (const auto &t : orig) {
+        REQUIRE(s.find(t.first) != s.end());
+        REQUIRE(s.find(t.first)->second == t.second);
+    }
+}
+
+TEST_CASE("series_add_terms_exception_safety")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<int>;
+    using s_t = series<pm_t, throwing_cf, void>;
+
+    s_t s;
+    s.set_symbol_set(symbol_set{"x", "y"});
+    for (int i = 0; i < 100; ++i) {
+        s.add_term(pm_t{i, 1}, throwing_cf{i + 1});
+    }
+    const auto orig = s;
+
+    // New terms, some of which overlap or cancel
+    // with the existing ones.
+    std::vector<std::pair<pm_t, throwing_cf>> v;
+    for (int i = 50; i < 150; ++i) {
+        v.emplace_back(pm_t{i, 1}, throwing_cf{i < 60 ? -(i + 1) : 1});
+    }
+
+    for (auto l : {0u, 3u}) {
+        s.resegment(l);
+
+        for (auto mode : {add_terms_mode::checked, add_terms_mode::assume_unique}) {
+            throwing_cf_countdown.store(70);
+            OBAKE_REQUIRES_THROWS_CONTAINS(s.add_terms(v, mode), std::runtime_error, "throwing_cf copy");
+            throwing_cf_countdown.store(-1);
+            REQUIRE(s == orig);
+            REQUIRE(check_segments(s));
+        }
+
+        // An empty series is left empty.
+        s_t e;
+        e.set_symbol_set(symbol_set{"x", "y"});
+        e.set_n_segments(l);
+        throwing_cf_countdown.store(70);
+        OBAKE_REQUIRES_THROWS_CONTAINS(e.add_terms(v), std::runtime_error, "throwing_cf copy");
+        throwing_cf_countdown.store(-1);
+        REQUIRE(e.empty());
+
+        auto s2 = s;
+        s2.add_terms(v);
+        REQUIRE(s2.size() == 140u);
+        REQUIRE(check_segments(s2));
+    }
+}
+
+TEST_CASE("series_parallel_term_iteration")
+{
+    using pm_t = packed_monomial<int>;
+    using poly_t = polynomial<pm_t, int_t>;
+    using dpoly_t = polynomial<pm_t, double>;
+
+    // Type checks.
+    REQUIRE(detail::is_term_transform_reducible<int_t, std::plus<>, int (*)(const series_term_t<poly_t> &),
+                                                pm_t, int_t, polynomials::tag>::value);
+    REQUIRE(!detail::is_term_transform_reducible<int_t, std::plus<>, int (*)(int), pm_t, int_t,
+                                                 polynomials::tag>::value);
+    REQUIRE(!detail::is_term_transform_reducible<int_t, int (*)(int), int (*)(const series_term_t<poly_t> &),
+                                                 pm_t, int_t, polynomials::tag>::value);
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    const auto p = obake::pow(x - 2 * y + 3 * z - t + 1, 10);
+    const auto &ss = p.get_symbol_set();
+
+    // Serial references.
+    int_t cf_sum(0);
+    int max_deg = 0;
+    for (const auto &term : p) {
+        cf_sum += term.second;
+        max_deg = std::max(max_deg, static_cast<int>(obake::key_degree(term.first, ss)));
+    }
+
+    for (auto l : {0u, 1u, 4u}) {
+        auto ps = p;
+        ps.resegment(l);
+
+        // Segment range.
+        const auto segs = ps.segments();
+        REQUIRE(segs.size() == 1u << l);
+        REQUIRE(segs.is_divisible() == (l > 0u));
+        std::size_t n = 0, idx = 0;
+        for (const auto &table : segs) {
+            n += table.size();
+            for (const auto &term : table) {
+                REQUIRE((hash(term.first) & ((1u << l) - 1u)) == idx);
+            }
+            ++idx;
+        }
+        REQUIRE(n == ps.size());
+
+        std::atomic<std::size_t> a_n(0);
+        tbb::parallel_for(ps.segments(), [&a_n](const auto &range) {
+            for (const auto &table : range) {
+                a_n += table.size();
+            }
+        });
+        REQUIRE(a_n.load() == ps.size());
+
+        // parallel_for_each_term().
+        a_n.store(0);
+        std::atomic<long long> a_sum(0);
+        parallel_for_each_term(ps, [&a_n, &a_sum](const auto &term) {
+            ++a_n;
+            a_sum += static_cast<long long>(term.second);
+        });
+        REQUIRE(a_n.load() == ps.size());
+        REQUIRE(a_sum.load() == cf_sum);
+
+        // parallel_transform_reduce().
+        REQUIRE(parallel_transform_reduce(ps, int_t(0), std::plus<>{}, [](const auto &term) { return term.second; })
+                == cf_sum);
+        REQUIRE(parallel_transform_reduce(ps, int_t(5), std::plus<>{}, [](const auto &term) { return term.second; })
+                == cf_sum + 5);
+        REQUIRE(parallel_transform_reduce(ps, std::size_t(0), std::plus<>{}, [](const auto &) { return 1; })
+                == ps.size());
+        REQUIRE(parallel_transform_reduce(
+                    ps, 0, [](int a, int b) { return std::max(a, b); },
+                    [&ss](const auto &term) { return static_cast<int>(obake::key_degree(term.first, ss)); })
+                == max_deg);
+
+        // The result of a floating-point reduction must not
+        // depend on the number of threads.
+        const auto pd = dpoly_t(ps);
+        REQUIRE(pd.get_s_size() == l);
+        const auto fp_res
+            = parallel_transform_reduce(pd, 0., std::plus<>{}, [](const auto &term) { return term.second / 3; });
+        REQUIRE(fp_res == Approx(static_cast<double>(cf_sum) / 3));
+        for (auto i = 0; i < 10; ++i) {
+            REQUIRE(parallel_transform_reduce(pd, 0., std::plus<>{}, [](const auto &term) { return term.second / 3; })
+                    == fp_res);
+        }
+
+        // Empty series.
+        poly_t e;
+        e.set_n_segments(l);
+        REQUIRE(parallel_transform_reduce(e, int_t(42), std::plus<>{}, [](const auto &term) { return term.second; })
+                == 42);
+        a_n.store(0);
+        parallel_for_each_term(e, [&a_n](const auto &) { ++a_n; });
+        REQUIRE(a_n.load() == 0u);
+    }
+}
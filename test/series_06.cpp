@@ -6,10 +6,14 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <mp++/config.hpp>
 #include <mp++/exceptions.hpp>
@@ -23,10 +27,12 @@
 #include <obake/config.hpp>
 #include <obake/key/key_degree.hpp>
 #include <obake/math/degree.hpp>
+#include <obake/math/is_zero.hpp>
 #include <obake/math/pow.hpp>
 #include <obake/polynomials/d_packed_monomial.hpp>
 #include <obake/polynomials/packed_monomial.hpp>
 #include <obake/polynomials/polynomial.hpp>
+#include <obake/ranges.hpp>
 #include <obake/series.hpp>
 #include <obake/symbols.hpp>
 #include <obake/type_traits.hpp>
@@ -39,6 +45,8 @@ using rat_t = mppp::rational<1>;
 
 using namespace obake;
 
+using obake_test::segmented_copy;
+
 struct foo {
 };
 
@@ -209,6 +217,24 @@ TEST_CASE("series_filtered_test")
     REQUIRE(obake::degree(pf) == 3);
     REQUIRE(pf.get_symbol_set() == symbol_set{"x", "y", "z"});
 
+    // Segmented series.
+    for (auto l : {1u, 3u, 6u}) {
+        p1_t ps;
+        ps.set_symbol_set(p.get_symbol_set());
+        ps.set_n_segments(l);
+        for (const auto &t : p) {
+            ps.add_term(t.first, t.second);
+        }
+
+        pf = filtered(ps, [&ss = p.get_symbol_set()](const auto &t) { return obake::key_degree(t.first, ss) <= 2; });
+        REQUIRE(obake::degree(pf) == 2);
+        REQUIRE(pf.get_s_size() == l);
+        REQUIRE(pf
+                == filtered(p, [&ss = p.get_symbol_set()](const auto &t) {
+                       return obake::key_degree(t.first, ss) <= 2;
+                   }));
+    }
+
     REQUIRE(!is_detected_v<filtered_t, void, void>);
     REQUIRE(!is_detected_v<filtered_t, void, int>);
     REQUIRE(!is_detected_v<filtered_t, int, void>);
@@ -347,3 +373,84 @@ TEST_CASE("series_generic_ctor_with_ss_bug_00")
     REQUIRE(s1_t(42, symbol_set{"x", "y", "z"}) == 42);
     REQUIRE(s1_t(42, symbol_set{"x", "y", "z"}).get_symbol_set() == symbol_set{"x", "y", "z"});
 }
+
+// A single-pass range whose iterators yield
+// references to an internal buffer.
+template <typename T>
+struct input_lc_range {
+    std::istream_iterator<T> begin() const;
+    std::istream_iterator<T> end() const;
+};
+
+TEST_CASE("series_linear_combination")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<int>;
+    using poly_t = polynomial<pm_t, int_t>;
+    using qpoly_t = polynomial<pm_t, rat_t>;
+
+    // Type checks.
+    REQUIRE(detail::linear_combination_algo<std::vector<std::pair<int_t, poly_t>> &> == 1);
+    REQUIRE(detail::linear_combination_algo<const std::vector<std::tuple<int_t, poly_t>> &> == 1);
+    REQUIRE(detail::linear_combination_algo<std::vector<std::pair<int, poly_t>> &> == 2);
+    REQUIRE(detail::linear_combination_algo<std::vector<std::pair<rat_t, qpoly_t>> &> == 2);
+    REQUIRE(detail::linear_combination_algo<std::vector<std::pair<poly_t, poly_t>> &> == 0);
+    REQUIRE(detail::linear_combination_algo<std::vector<std::pair<foo, poly_t>> &> == 0);
+    REQUIRE(detail::linear_combination_algo<std::vector<int> &> == 0);
+    REQUIRE(detail::linear_combination_algo<int> == 0);
+    // The product of the scalar by a coefficient must
+    // yield the coefficient type.
+    REQUIRE(detail::linear_combination_algo<std::vector<std::pair<rat_t, poly_t>> &> == 0);
+    REQUIRE(detail::linear_combination_algo<std::vector<std::pair<double, poly_t>> &> == 0);
+    // Single-pass ranges are not supported.
+    REQUIRE(is_input_range_v<input_lc_range<std::pair<int_t, poly_t>> &>);
+    REQUIRE(detail::linear_combination_algo<input_lc_range<std::pair<int_t, poly_t>> &> == 0);
+
+    // Empty range.
+    REQUIRE(linear_combination(std::vector<std::pair<int_t, poly_t>>{}).empty());
+
+    auto [x, y, z] = make_polynomials<qpoly_t>("x", "y", "z");
+    auto [t] = make_polynomials<qpoly_t>("t");
+
+    std::vector<std::pair<rat_t, qpoly_t>> v;
+    v.emplace_back(rat_t{1, 2}, obake::pow(x - y + 1, 6));
+    v.emplace_back(rat_t{-3}, obake::pow(x + z, 5));
+    v.emplace_back(rat_t{2, 7}, obake::pow(t - x, 4));
+    v.emplace_back(rat_t{5}, qpoly_t{});
+    v.emplace_back(rat_t{0}, obake::pow(z - 2 * y, 3));
+
+    qpoly_t cmp;
+    for (const auto &p : v) {
+        cmp += p.first * p.second;
+    }
+
+    // Different segmentations for the input series.
+    for (auto l0 : {0u, 1u, 3u}) {
+        for (auto l1 : {0u, 2u}) {
+            v[0].second = segmented_copy(v[0].second, l0);
+            v[2].second = segmented_copy(v[2].second, l1);
+
+            auto lc = linear_combination(v);
+            REQUIRE(lc == cmp);
+            REQUIRE(lc.get_symbol_set() == symbol_set{"t", "x", "y", "z"});
+            REQUIRE(lc.get_s_size() == std::max(l0, l1));
+
+            for (const auto &term : lc) {
+                REQUIRE(!obake::is_zero(term.second));
+            }
+        }
+    }
+
+    // Cancellations.
+    auto [xi, yi] = make_polynomials<poly_t>("x", "y");
+    std::vector<std::pair<int_t, poly_t>> w{{int_t{2}, obake::pow(xi + yi, 4)},
+                                             {int_t{-1}, 2 * obake::pow(xi + yi, 4)},
+                                             {int_t{3}, xi}};
+    REQUIRE(linear_combination(w) == 3 * xi);
+    REQUIRE(linear_combination(w).size() == 1u);
+
+    // Tuples with a different scalar type.
+    std::vector<std::tuple<int, poly_t>> w2{{2, xi}, {-5, yi}};
+    REQUIRE(linear_combination(w2) == 2 * xi - 5 * yi);
+}
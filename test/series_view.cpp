@@ -0,0 +1,269 @@
+// Copyright 2019-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the obake library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <obake/math/evaluate.hpp>
+#include <obake/math/pow.hpp>
+#include <obake/native_s11n.hpp>
+#include <obake/polynomials/d_packed_monomial.hpp>
+#include <obake/polynomials/packed_monomial.hpp>
+#include <obake/polynomials/polynomial.hpp>
+#include <obake/series_view.hpp>
+#include <obake/symbols.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace obake;
+
+using obake_test::segmented_copy;
+
+// Check the view v against the series s.
+template <typename V, typename S>
+inline void check_view(const V &v, const S &s)
+{
+    REQUIRE(v.size() == s.size());
+    REQUIRE(v.empty() == s.empty());
+    REQUIRE(v.get_symbol_set() == s.get_symbol_set());
+    REQUIRE(v.get_s_size() == s.get_s_size());
+
+    // Iteration and lookup.
+    typename S::size_type n = 0;
+    for (const auto &t : v) {
+        const auto it = s.find(t.first);
+        REQUIRE(it != s.end());
+        REQUIRE(it->second == t.second);
+
+        const auto c = v.find(t.first);
+        REQUIRE(c);
+        REQUIRE(*c == t.second);
+
+        ++n;
+    }
+    REQUIRE(n == s.size());
+
+    REQUIRE(v.to_series() == s);
+    REQUIRE(v.to_series().get_s_size() == s.get_s_size());
+    REQUIRE(v.to_term_vector().size() == s.size());
+}
+
+TEST_CASE("series_view_basic")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using dpm_t = d_packed_monomial<long long, 8>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<dpm_t, mppp::rational<1>>;
+    using view_t = series_view<pm_t, mppp::integer<1>, polynomials::tag>;
+    using qview_t = series_view<dpm_t, mppp::rational<1>, polynomials::tag>;
+
+    REQUIRE(is_series_view_v<view_t>);
+    REQUIRE(!is_series_view_v<poly_t>);
+    REQUIRE(is_cvr_series_view_v<const view_t &>);
+    REQUIRE(std::is_copy_constructible_v<view_t>);
+
+    const std::string filename = "series_view_test.bin";
+
+    auto [x, y, z] = make_polynomials<poly_t>("x", "y", "z");
+    auto [a, b, c] = make_polynomials<qpoly_t>("a", "b", "c");
+
+    const auto p = obake::pow(x - 2 * y + 3 * z - 1, 8) + obake::pow(x * y * z, 5) - 4 * x * z;
+    const auto q = obake::pow(a / 3 - b + 2 * c, 6) - a * b * c / 7;
+
+    for (auto mode : {native_s11n_mode::plain, native_s11n_mode::compressed, native_s11n_mode::indexed}) {
+        // Empty series.
+        native_save(filename, segmented_copy(poly_t{}, 2), mode);
+        {
+            const view_t v(filename);
+            check_view(v, segmented_copy(poly_t{}, 2));
+            REQUIRE(v.begin() == v.end());
+            REQUIRE(!v.find(pm_t{1, 2, 3}));
+            REQUIRE(obake::evaluate(v, symbol_map<double>{}) == 0.);
+        }
+
+        for (auto l : {0u, 1u, 4u}) {
+            const auto ps = segmented_copy(p, l);
+            native_save(filename, ps, mode);
+
+            const view_t v(filename);
+            REQUIRE(v.is_indexed() == (mode == native_s11n_mode::indexed));
+            check_view(v, ps);
+
+            // Keys not in the series.
+            REQUIRE(!v.find(pm_t{100, 0, 0}));
+            REQUIRE(!v.find(pm_t{0, 1, 100}));
+
+            // Copies share the mapping.
+            const auto v2(v);
+            check_view(v2, ps);
+
+            // Evaluation.
+            REQUIRE(obake::evaluate(v, symbol_map<mppp::integer<1>>{{"x", 3}, {"y", -2}, {"z", 5}})
+                    == obake::evaluate(p, symbol_map<mppp::integer<1>>{{"x", 3}, {"y", -2}, {"z", 5}}));
+
+            // The result of floating-point evaluation must not depend
+            // on the number of threads.
+            const auto fp_res = obake::evaluate(v, symbol_map<double>{{"x", 1.1}, {"y", -.3}, {"z", .7}});
+            for (auto i = 0; i < 5; ++i) {
+                REQUIRE(obake::evaluate(v, symbol_map<double>{{"x", 1.1}, {"y", -.3}, {"z", .7}}) == fp_res);
+            }
+            OBAKE_REQUIRES_THROWS_CONTAINS(obake::evaluate(v, symbol_map<double>{{"x", 1.1}, {"y", -.3}}),
+                                           std::invalid_argument,
+                                           "does not contain all the symbols in the view's symbol set");
+
+            // Dynamic packed monomials and rational coefficients.
+            const auto qs = segmented_copy(q, l);
+            native_save(filename, qs, mode);
+
+            const qview_t qv(filename);
+            check_view(qv, qs);
+            REQUIRE(!qv.find(dpm_t{1, 1, 0}));
+            REQUIRE(obake::evaluate(qv, symbol_map<mppp::rational<1>>{{"a", 1}, {"b", 2}, {"c", -3}})
+                    == obake::evaluate(q, symbol_map<mppp::rational<1>>{{"a", 1}, {"b", 2}, {"c", -3}}));
+        }
+    }
+
+    // Wrong types.
+    native_save(filename, p);
+    OBAKE_REQUIRES_THROWS_CONTAINS(qview_t{filename}, std::invalid_argument, "the key type tag in the data");
+
+    std::remove(filename.c_str());
+    OBAKE_REQUIRES_THROWS_CONTAINS(view_t{filename}, std::runtime_error,
+                                   "Cannot open the file 'series_view_test.bin' for reading");
+}
+
+TEST_CASE("series_view_mul")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<pm_t, mppp::rational<1>>;
+    using view_t = series_view<pm_t, mppp::integer<1>, polynomials::tag>;
+    using qview_t = series_view<pm_t, mppp::rational<1>, polynomials::tag>;
+
+    const std::string f1 = "series_view_mul_test1.bin", f2 = "series_view_mul_test2.bin";
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    // Small and large operands (the large ones go through
+    // the multi-threaded implementation).
+    for (auto n : {2, 10}) {
+        const auto p = obake::pow(x + y + 2 * z + t + 1, n);
+        const auto q = obake::pow(x - y - z + 3 * t - 1, n);
+        const auto cmp = p * q;
+
+        for (auto mode : {native_s11n_mode::plain, native_s11n_mode::compressed, native_s11n_mode::indexed}) {
+            for (auto l : {0u, 3u}) {
+                native_save(f1, segmented_copy(p, l), mode);
+                native_save(f2, segmented_copy(q, l), mode);
+
+                const view_t v1(f1), v2(f2);
+
+                REQUIRE(v1 * q == cmp);
+                REQUIRE(p * v2 == cmp);
+                REQUIRE(v1 * v2 == cmp);
+                REQUIRE(v2 * v1 == cmp);
+
+                // Different coefficient types.
+                REQUIRE(std::is_same_v<qpoly_t, decltype(v1 * qpoly_t{q})>);
+                REQUIRE(v1 * qpoly_t{q} == qpoly_t{cmp});
+
+                native_save(f2, qpoly_t{q} / 2, mode);
+                const qview_t qv(f2);
+                REQUIRE(v1 * qv == qpoly_t{cmp} / 2);
+            }
+        }
+    }
+
+    // Different symbol sets.
+    native_save(f1, obake::pow(x + y, 3));
+    REQUIRE(view_t(f1) * (z - t) == obake::pow(x + y, 3) * (z - t));
+
+    // Empty operands.
+    native_save(f2, poly_t{});
+    REQUIRE((view_t(f1) * view_t(f2)).empty());
+    REQUIRE((poly_t{} * view_t(f1)).empty());
+
+    std::remove(f1.c_str());
+    std::remove(f2.c_str());
+}
+
+TEST_CASE("out_of_core_mul")
+{
+    obake_test::disable_slow_stack_traces();
+
+    using pm_t = packed_monomial<long long>;
+    using poly_t = polynomial<pm_t, mppp::integer<1>>;
+    using qpoly_t = polynomial<pm_t, mppp::rational<1>>;
+    using view_t = series_view<pm_t, mppp::integer<1>, polynomials::tag>;
+
+    REQUIRE(std::is_same_v<view_t, decltype(out_of_core_mul(poly_t{}, poly_t{}, "", 1))>);
+    REQUIRE(std::is_same_v<series_view<pm_t, mppp::rational<1>, polynomials::tag>,
+                           decltype(out_of_core_mul(std::declval<const view_t &>(), qpoly_t{}, "", 1))>);
+
+    const std::string f1 = "out_of_core_mul_test1.bin", f2 = "out_of_core_mul_test2.bin";
+
+    auto [x, y, z, t] = make_polynomials<poly_t>("x", "y", "z", "t");
+
+    const auto p = obake::pow(x + y + 2 * z + t + 1, 8);
+    const auto q = obake::pow(x - y - z + 3 * t - 1, 8);
+    const auto cmp = p * q;
+
+    for (auto mode : {native_s11n_mode::plain, native_s11n_mode::compressed, native_s11n_mode::indexed}) {
+        // A tiny budget results in many small groups of segments.
+        for (auto budget : {std::size_t(1) << 10, std::size_t(1) << 16, std::size_t(1) << 30}) {
+            const auto v = out_of_core_mul(p, q, f1, budget, mode);
+            REQUIRE(v.size() == cmp.size());
+            REQUIRE(v.to_series() == cmp);
+            REQUIRE(v.is_indexed() == (mode == native_s11n_mode::indexed));
+
+            for (const auto &term : cmp) {
+                REQUIRE(v.find(term.first) == term.second);
+            }
+
+            if (budget == std::size_t(1) << 10) {
+                REQUIRE(v.get_s_size() > 0u);
+            }
+        }
+
+        // Views as operands.
+        native_save(f2, q, mode);
+        REQUIRE(out_of_core_mul(p, view_t(f2), f1, 1u << 12, mode).to_series() == cmp);
+        REQUIRE(out_of_core_mul(view_t(f2), qpoly_t{p} / 3, f1, 1u << 12, mode).to_series() == qpoly_t{cmp} / 3);
+    }
+
+    // Cancellations.
+    REQUIRE(out_of_core_mul(x - y, x + y, f1, 1).to_series() == x * x - y * y);
+
+    // Different symbol sets.
+    REQUIRE(out_of_core_mul(obake::pow(x + y, 4), obake::pow(z - t, 4), f1, 1u << 10).to_series()
+            == obake::pow(x + y, 4) * obake::pow(z - t, 4));
+    native_save(f2, obake::pow(x + y, 4));
+    REQUIRE(out_of_core_mul(view_t(f2), z - 1, f1, 1u << 10).to_series() == obake::pow(x + y, 4) * (z - 1));
+
+    // Empty operands.
+    REQUIRE(out_of_core_mul(poly_t{}, p, f1, 100).empty());
+    REQUIRE(out_of_core_mul(p, poly_t{}, f1, 100).get_symbol_set() == p.get_symbol_set());
+
+    // Error handling.
+    OBAKE_REQUIRES_THROWS_CONTAINS(out_of_core_mul(p, q, f1, 0), std::invalid_argument, "with a null memory budget");
+    OBAKE_REQUIRES_THROWS_CONTAINS(out_of_core_mul(p, q, "/nonexistent/dir/file.bin", 100), std::runtime_error,
+                                   "for writing");
+
+    std::remove(f1.c_str());
+    std::remove(f2.c_str());
+}
@@ -31,6 +31,22 @@ inline void disable_slow_stack_traces()
 #endif
 }
 
+// Helper to create a copy of the series s
+// with 2**l segments.
+template <typename S>
+inline S segmented_copy(const S &s, unsigned l)
+{
+    S retval;
+    retval.set_symbol_set(s.get_symbol_set());
+    retval.set_n_segments(l);
+
+    for (const auto &t : s) {
+        retval.add_term(t.first, t.second);
+    }
+
+    return retval;
+}
+
 } // namespace obake_test
 
 #define OBAKE_REQUIRES_THROWS_CONTAINS(expr, exc, msg)                                                                 \